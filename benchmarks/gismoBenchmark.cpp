@@ -0,0 +1,281 @@
+/** @file gismoBenchmark.cpp
+
+    @brief Performance benchmarks of assembly, basis evaluation,
+    multigrid, THB refinement, Paraview output and XML input
+
+    Sweeps over the polynomial degree, the number of uniform
+    refinements and the number of threads, and writes the timings,
+    the throughput in elements and degrees of freedom per second and
+    (optionally) hardware counters as JSON, for tracking performance
+    regressions between versions. The Paraview output is written in
+    the encodings ascii (format 0), base64 (1), appended raw (2) and
+    appended raw with zlib compression (3), with the size of the file
+    and the output rate in MB/s. The XML input is measured on a
+    generated multipatch file, plain and gzip compressed, with the
+    rate in MB/s of uncompressed XML.
+
+    Example:
+    \verbatim
+    ./bin/gismoBenchmark -d 3 -p 2 -q 4 -r 2 -R 4 --counters -o bench.json
+    \endverbatim
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <gismo.h>
+#include <gsUtils/gsBenchmark.h>
+
+using namespace gismo;
+
+// Refines the corner [0,2^-k]^d of a THB-spline basis for k = 1..levels
+template <short_t d>
+void thbRefinement(const gsBasis<> & tbasis, index_t levels, gsBenchmark & bm,
+                   index_t p, index_t r, index_t numRepeat)
+{
+    const gsTensorBSplineBasis<d> & tb = static_cast<const gsTensorBSplineBasis<d>&>(tbasis);
+    index_t numEl = 0, numDofs = 0;
+    bm.run("thbRefinement", numRepeat, [&]()
+    {
+        gsTHBSplineBasis<d> thb(tb);
+        gsMatrix<> box(d, 2);
+        for (index_t k = 1; k <= levels; ++k)
+        {
+            box.col(0).setZero();
+            box.col(1).setConstant( math::pow(0.5, (real_t)k) );
+            thb.refine(box);
+        }
+        numEl   = thb.numElements();
+        numDofs = thb.size();
+    })
+    .set("degree", p).set("refine", r).set("threads", 1)
+    .setSize(numEl, numDofs);
+}
+
+int main(int argc, char *argv[])
+{
+    index_t dim       = 2;
+    index_t minDegree = 2;
+    index_t maxDegree = 3;
+    index_t minRefine = 2;
+    index_t maxRefine = 3;
+    index_t maxThreads = omp_get_max_threads();
+    index_t numRepeat = 3;
+    index_t thbLevels = 3;
+    index_t numSamples = 1000;
+    index_t xmlPatches = 200;
+    bool counters = false;
+    std::string output;
+
+    gsCmdLine cmd("Performance benchmarks of G+Smo, written as JSON.");
+    cmd.addInt( "d", "dim", "Dimension of the domain (2 or 3)", dim );
+    cmd.addInt( "p", "minDegree", "Smallest polynomial degree", minDegree );
+    cmd.addInt( "q", "maxDegree", "Largest polynomial degree", maxDegree );
+    cmd.addInt( "r", "minRefine", "Smallest number of uniform refinements", minRefine );
+    cmd.addInt( "R", "maxRefine", "Largest number of uniform refinements", maxRefine );
+    cmd.addInt( "t", "threads", "Largest number of threads (powers of two are used)", maxThreads );
+    cmd.addInt( "n", "repeat", "Number of repetitions, the best time is reported", numRepeat );
+    cmd.addInt( "l", "thbLevels", "Number of levels of the THB refinement", thbLevels );
+    cmd.addInt( "s", "samples", "Number of sample points per patch for Paraview output", numSamples );
+    cmd.addInt( "x", "xmlPatches", "Number of patches of the generated XML file", xmlPatches );
+    cmd.addSwitch("counters", "Record hardware performance counters (Linux)", counters );
+    cmd.addString( "o", "output", "Output file (JSON), default is the standard output", output );
+    try { cmd.getValues(argc,argv); } catch (int rv) { return rv; }
+
+    GISMO_ENSURE(2==dim || 3==dim, "The dimension must be 2 or 3.");
+
+    // Open the counters before any thread is created
+    gsBenchmark bm(counters);
+    if (counters && !bm.hasCounters())
+        gsWarn << "Hardware counters are not available.\n";
+
+    gsMultiPatch<> mp;
+    if (2==dim)
+        mp.addPatch( gsNurbsCreator<>::BSplineFatQuarterAnnulus() );
+    else
+        mp.addPatch( gsNurbsCreator<>::lift3D(*gsNurbsCreator<>::BSplineFatQuarterAnnulus()) );
+    mp.computeTopology();
+
+    gsFunctionExpr<> f( 2==dim ? "sin(pi*x)*sin(pi*y)" : "sin(pi*x)*sin(pi*y)*sin(pi*z)", dim);
+    gsConstantFunction<> g(0.0, dim);
+    gsBoundaryConditions<> bc;
+    bc.setGeoMap(mp);
+    for (gsMultiPatch<>::const_biterator bit = mp.bBegin(); bit != mp.bEnd(); ++bit)
+        bc.addCondition(*bit, condition_type::dirichlet, g);
+
+    const std::string vtkFile = gsFileManager::getTempPath() + "gismoBenchmark_out";
+
+    for (index_t p = minDegree; p <= maxDegree; ++p)
+        for (index_t r = minRefine; r <= maxRefine; ++r)
+        {
+            gsMultiBasis<> coarse(mp);
+            coarse.setDegree(p);
+            gsMultiBasis<> dbasis = coarse;
+            for (index_t i = 0; i < r; ++i)
+                dbasis.uniformRefine();
+            const index_t numEl = dbasis.totalElements();
+
+            for (index_t nt = 1; nt <= maxThreads; nt *= 2)
+            {
+                omp_set_num_threads(nt);
+
+                // Expression assembler
+                gsExprAssembler<> A(1,1);
+                A.setIntegrationElements(dbasis);
+                gsExprAssembler<>::geometryMap G = A.getMap(mp);
+                gsExprAssembler<>::space u = A.getSpace(dbasis);
+                auto ff = A.getCoeff(f, G);
+                u.setup(bc, dirichlet::homogeneous, 0);
+                bm.run("exprAssembler", numRepeat, [&]()
+                {
+                    A.initSystem();
+                    A.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G), u * ff * meas(G) );
+                })
+                .set("degree", p).set("refine", r).set("threads", nt)
+                .setSize(numEl, A.numDofs());
+
+                // Visitor-based Poisson assembler
+                gsPoissonAssembler<> pa(mp, dbasis, bc, f, dirichlet::elimination, iFace::glue);
+                bm.run("poissonAssembler", numRepeat, [&]() { pa.assemble(); })
+                .set("degree", p).set("refine", r).set("threads", nt)
+                .setSize(numEl, pa.numDofs());
+
+                // Values and first derivatives on the Gauss nodes of all elements
+                const gsBasis<> & basis = dbasis.basis(0);
+                bm.run("basisEvaluation", numRepeat, [&]()
+                {
+#                   pragma omp parallel
+                    {
+                        const int tid = omp_get_thread_num();
+                        const int nth = omp_get_num_threads();
+                        gsQuadRule<> qu = gsQuadrature::get(basis, pa.options());
+                        gsMatrix<> nodes;
+                        gsVector<> weights;
+                        std::vector<gsMatrix<> > vals;
+                        gsBasis<>::domainIter domIt = basis.makeDomainIterator();
+                        for (domIt->next(tid); domIt->good(); domIt->next(nth))
+                        {
+                            qu.mapTo(domIt->lowerCorner(), domIt->upperCorner(), nodes, weights);
+                            basis.evalAllDers_into(nodes, 1, vals);
+                        }
+                    }
+                })
+                .set("degree", p).set("refine", r).set("threads", nt)
+                .setSize(numEl, basis.size());
+
+                // Conjugate gradients preconditioned by geometric multigrid
+                index_t iter = 0;
+                gsBenchmark::result & cgRes = bm.run("cgMultiGrid", numRepeat, [&]()
+                {
+                    std::vector< gsSparseMatrix<real_t,RowMajor> > transfer;
+                    gsGridHierarchy<>::buildByRefinement(coarse, bc, pa.options(), r+1)
+                        .moveTransferMatricesTo(transfer);
+                    gsMultiGridOp<>::Ptr mg = gsMultiGridOp<>::make(pa.matrix(), transfer);
+                    mg->setCoarseSolver( makeSparseCholeskySolver(mg->matrix(0)) );
+                    for (index_t i = 1; i < mg->numLevels(); ++i)
+                        mg->setSmoother(i, makeGaussSeidelOp(mg->matrix(i)));
+                    gsConjugateGradient<> cg(pa.matrix(), mg);
+                    cg.setTolerance(1e-8);
+                    gsMatrix<> x;
+                    x.setZero(pa.numDofs(), 1);
+                    cg.solve(pa.rhs(), x);
+                    iter = cg.iterations();
+                });
+                cgRes.set("degree", p).set("refine", r).set("threads", nt)
+                .set("iterations", iter).setSize(numEl, pa.numDofs());
+            }
+            omp_set_num_threads(maxThreads);
+
+            // THB refinement of the corner of the parameter domain
+            if (2==dim)
+                thbRefinement<2>(dbasis.basis(0), thbLevels, bm, p, r, numRepeat);
+            else
+                thbRefinement<3>(dbasis.basis(0), thbLevels, bm, p, r, numRepeat);
+
+            // Paraview output of a field on the patch
+            gsMatrix<> coefs;
+            coefs.setRandom(dbasis.basis(0).size(), 1);
+            gsMultiPatch<> sol;
+            sol.addPatch( dbasis.basis(0).makeGeometry(give(coefs)) );
+            gsField<> field(mp, sol);
+            gsOptionList vtkOpt = gsParaviewDataSet::defaultOptions();
+            vtkOpt.setInt("numPoints", numSamples);
+            // in all encodings; the last one is appended and compressed
+            const char * formats[] = {"ascii", "binary", "appended", "appended"};
+            for (index_t fmt = 0; fmt != 4; ++fmt)
+            {
+                vtkOpt.setString("format", formats[fmt]);
+                vtkOpt.setSwitch("compress", 3 == fmt);
+                gsBenchmark::result & res = bm.run("writeParaview", numRepeat, [&]()
+                {
+                    gsParaviewDataSet ds(vtkFile, &mp, nullptr, vtkOpt);
+                    ds.addField(field, "SolutionField");
+                    ds.save();
+                });
+                std::ifstream vts((vtkFile + "_patch0.vts").c_str(), std::ios::binary | std::ios::ate);
+                const double bytes = static_cast<double>(vts.tellg());
+                res.set("degree", p).set("refine", r).set("threads", 1)
+                .set("samples", numSamples).set("format", fmt).set("bytes", bytes)
+                .set("MB_per_s", bytes / res.time / 1e6).setSize(numEl, dbasis.basis(0).size());
+            }
+        }
+
+    // Reading of a large generated multipatch file; the patches are
+    // copies of the finest geometry with perturbed coefficients
+    {
+        gsGeometry<>::uPtr geo = mp.patch(0).clone();
+        if (maxDegree > geo->degree(0))
+            geo->degreeElevate(maxDegree - geo->degree(0));
+        for (index_t i = 0; i < maxRefine + 2; ++i)
+            geo->uniformRefine();
+        gsMultiPatch<> big;
+        for (index_t k = 0; k < xmlPatches; ++k)
+        {
+            geo->coefs() += 1e-3 * gsMatrix<>::Random(geo->coefs().rows(), geo->coefs().cols());
+            big.addPatch(*geo);
+        }
+        gsFileData<> out;
+        out << big;
+
+        const std::string xmlFile = gsFileManager::getTempPath() + "gismoBenchmark_in";
+        double xmlBytes = 0;
+        for (index_t gz = 0; gz < 2; ++gz)
+        {
+            out.save(xmlFile, 1 == gz);
+            const std::string fn = xmlFile + (gz ? ".xml.gz" : ".xml");
+            std::ifstream in(fn.c_str(), std::ios::binary | std::ios::ate);
+            const double bytes = static_cast<double>(in.tellg());
+            if (0 == gz) xmlBytes = bytes;
+
+            gsMultiPatch<> res_mp;
+            gsBenchmark::result & res = bm.run("readXml", numRepeat, [&]()
+            {
+                gsFileData<> fd(fn);
+                fd.getFirst(res_mp);
+            });
+            GISMO_ENSURE(res_mp.nPatches() == big.nPatches(), "Reading the XML file failed.");
+            res.set("patches", xmlPatches).set("compressed", gz).set("bytes", bytes)
+            .set("MB_per_s", xmlBytes / res.time / 1e6)
+            .setSize(big.nPatches() * geo->basis().numElements(), big.coefsSize());
+        }
+    }
+
+    std::vector<std::pair<std::string,std::string> > info;
+    info.push_back(std::make_pair("version", std::string(GISMO_VERSION)));
+    info.push_back(std::make_pair("real_t", util::type<real_t>::name()));
+    info.push_back(std::make_pair("max_threads", util::to_string(maxThreads)));
+
+    if (output.empty())
+        bm.toJSON(gsInfo, info);
+    else
+    {
+        std::ofstream file(output.c_str());
+        bm.toJSON(file, info);
+        gsInfo << "Wrote " << bm.results().size() << " results to " << output << "\n";
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -46,6 +46,11 @@ if  (${GISMO_BUILD_EXAMPLES})
 message ("  GISMO_BUILD_EXAMPLES    ${GISMO_BUILD_EXAMPLES}")
 endif()
 
+option(GISMO_BUILD_BENCHMARKS    "Build benchmarks"          false  )
+if  (${GISMO_BUILD_BENCHMARKS})
+message ("  GISMO_BUILD_BENCHMARKS  ${GISMO_BUILD_BENCHMARKS}")
+endif()
+
 option(GISMO_BUILD_LIB           "Build shared library"      true   )
 message ("  GISMO_BUILD_LIB         ${GISMO_BUILD_LIB}")
 
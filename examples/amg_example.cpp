@@ -0,0 +1,109 @@
+/** @file amg_example.cpp
+
+    @brief Algebraic multigrid by smoothed aggregation for a multipatch Poisson problem
+
+    Assembles a Poisson problem with homogeneous Dirichlet conditions on
+    a multipatch domain and solves it by the conjugate gradient method,
+    preconditioned by algebraic multigrid (gsSmoothedAggregation). The
+    hierarchy is built from the stiffness matrix alone, no geometric
+    information is needed. For comparison, the symmetric Gauss-Seidel
+    preconditioner is used.
+
+    Example:
+    \verbatim
+    ./bin/amg_example -r 5 -p 3 --AMG.Smoother sgs
+    \endverbatim
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <gismo.h>
+
+using namespace gismo;
+
+int main(int argc, char *argv[])
+{
+    std::string geometry("domain2d/yeti_mp2.xml");
+    index_t degree      = 2;
+    index_t refinements = 3;
+    index_t maxIter     = 1000;
+    real_t  tol         = 1e-8;
+    index_t maxLevels   = 10;
+    index_t coarseSize  = 500;
+    real_t  threshold   = 0.08;
+    std::string smoother("cheb");
+
+    gsCmdLine cmd("Algebraic multigrid by smoothed aggregation for a multipatch Poisson problem.");
+    cmd.addString( "g", "geometry", "File containing the multipatch geometry", geometry );
+    cmd.addInt   ( "p", "degree", "Polynomial degree of the discretization", degree );
+    cmd.addInt   ( "r", "refinements", "Number of uniform refinements", refinements );
+    cmd.addInt   ( "i", "iterations", "Maximum number of iterations", maxIter );
+    cmd.addReal  ( "t", "tolerance", "Tolerance for the relative residual", tol );
+    cmd.addInt   ( "",  "AMG.MaxLevels", "Maximum number of levels in the hierarchy", maxLevels );
+    cmd.addInt   ( "",  "AMG.CoarseSize", "Maximum number of unknowns on the coarsest level", coarseSize );
+    cmd.addReal  ( "",  "AMG.StrengthThreshold", "Threshold for strong connections", threshold );
+    cmd.addString( "",  "AMG.Smoother", "Smoother: cheb, sgs, csgs or j", smoother );
+    try { cmd.getValues(argc,argv); } catch (int rv) { return rv; }
+
+    gsMultiPatch<> mp;
+    gsReadFile<>(geometry, mp);
+    if (mp.nPatches() == 0)
+    {
+        gsInfo << "No geometry found in " << geometry << ".\n";
+        return EXIT_FAILURE;
+    }
+
+    gsMultiBasis<> mb(mp);
+    for (size_t i = 0; i < mb.nBases(); ++i)
+        mb[i].setDegreePreservingMultiplicity(degree);
+    for (index_t i = 0; i < refinements; ++i)
+        mb.uniformRefine();
+
+    gsConstantFunction<> zero(0.0, mp.geoDim()), one(1.0, mp.geoDim());
+    gsBoundaryConditions<> bc;
+    for (gsMultiPatch<>::const_biterator it = mp.bBegin(); it < mp.bEnd(); ++it)
+        bc.addCondition(*it, condition_type::dirichlet, &zero);
+
+    gsPoissonAssembler<> assembler(mp, mb, bc, one);
+    assembler.assemble();
+    const gsSparseMatrix<> & A = assembler.matrix();
+    const gsMatrix<> & f = assembler.rhs();
+    gsInfo << "Patches: " << mp.nPatches() << ", DoFs: " << A.rows() << "\n";
+
+    gsStopwatch timer;
+    gsSmoothedAggregation<> amg(A, cmd.getGroup("AMG"));
+    gsMultiGridOp<>::Ptr mg = amg.makeMultiGridOp();
+    const real_t tSetup = timer.stop();
+    gsInfo << "Setup of the hierarchy took " << tSetup << " s, levels (coarsest first):";
+    for (index_t i = 0; i < amg.numLevels(); ++i)
+        gsInfo << " " << amg.matrix(i).rows();
+    gsInfo << "\n";
+
+    gsMatrix<> x;
+    bool ok = true;
+
+    gsConjugateGradient<> cgAmg(A, mg);
+    cgAmg.setMaxIterations(maxIter);
+    cgAmg.setTolerance(tol);
+    x.setZero(A.rows(), 1);
+    timer.restart();
+    cgAmg.solve(f, x);
+    gsInfo << "CG with AMG:                 " << cgAmg.iterations() << " iterations, "
+           << timer.stop() << " s, error " << cgAmg.error() << "\n";
+    ok = ok && cgAmg.error() < tol;
+
+    gsConjugateGradient<> cgSgs(A, makeSymmetricGaussSeidelOp(A));
+    cgSgs.setMaxIterations(maxIter);
+    cgSgs.setTolerance(tol);
+    x.setZero(A.rows(), 1);
+    timer.restart();
+    cgSgs.solve(f, x);
+    gsInfo << "CG with symm. Gauss-Seidel:  " << cgSgs.iterations() << " iterations, "
+           << timer.stop() << " s, error " << cgSgs.error() << "\n";
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
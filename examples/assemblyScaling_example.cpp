@@ -0,0 +1,133 @@
+/** @file assemblyScaling_example.cpp
+
+    @brief Thread-scaling of the expression assembler
+
+    Compares the assembly of a Poisson system using the default
+    (critical section) accumulation with the lock-free accumulation
+    into a precomputed sparsity pattern. Further columns time the
+    assembly of a right-hand side given by a string expression, a
+    re-assembly into a frozen pattern, as done in nonlinear loops, and
+    a re-assembly using the element cache of basis and geometry
+    evaluations.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <gismo.h>
+
+using namespace gismo;
+
+int main(int argc, char *argv[])
+{
+    index_t numRefine = 2;
+    index_t degree    = 2;
+    index_t dim       = 3;
+    index_t maxThreads = omp_get_max_threads();
+
+    gsCmdLine cmd("Thread-scaling of the expression assembler.");
+    cmd.addInt( "r", "uniformRefine", "Number of uniform h-refinement steps", numRefine );
+    cmd.addInt( "p", "degree", "Polynomial degree of the discretization", degree );
+    cmd.addInt( "d", "dim", "Spatial dimension (2 or 3)", dim );
+    cmd.addInt( "t", "threads", "Maximum number of threads", maxThreads );
+    try { cmd.getValues(argc,argv); } catch (int rv) { return rv; }
+
+    GISMO_ENSURE(2==dim || 3==dim, "Dimension must be 2 or 3.");
+    gsMultiPatch<> mp;
+    if (2==dim)
+        mp.addPatch( gsNurbsCreator<>::BSplineSquare() );
+    else
+        mp.addPatch( gsNurbsCreator<>::BSplineCube() );
+
+    gsMultiBasis<> dbasis(mp);
+    dbasis.setDegree(degree);
+    for (index_t r = 0; r < numRefine; ++r)
+        dbasis.uniformRefine();
+
+    gsFunctionExpr<> f( 2==dim ? "sin(pi*x)*sin(pi*y)*exp(x*y)"
+                        : "sin(pi*x)*sin(pi*y)*sin(pi*z)*exp(x*y*z)", dim);
+    gsConstantFunction<> g(0.0, dim);
+
+    gsBoundaryConditions<> bc;
+    bc.setGeoMap(mp);
+    for (gsMultiPatch<>::const_biterator bit = mp.bBegin(); bit != mp.bEnd(); ++bit)
+        bc.addCondition(*bit, condition_type::dirichlet, g);
+
+    gsExprAssembler<> A(1,1);
+    A.setIntegrationElements(dbasis);
+    gsExprAssembler<>::geometryMap G = A.getMap(mp);
+    gsExprAssembler<>::space u = A.getSpace(dbasis);
+    auto ff = A.getCoeff(f, G);
+    u.setup(bc, dirichlet::homogeneous, 0);
+
+    gsInfo << "Degree: "<< degree <<", elements: "<< dbasis.totalElements()
+           <<", DoFs: "<< dbasis.totalSize() <<"\n";
+    gsInfo << "threads   critical[s]  fixedPattern[s]  (pattern setup[s])  rhs[s]  frozen[s]  cached[s]\n";
+
+    gsStopwatch timer;
+    gsSparseMatrix<> Aref;
+    for (index_t nt = 1; nt <= maxThreads; nt *= 2)
+    {
+        omp_set_num_threads(nt);
+
+        A.options().setSwitch("fixedPattern", false);
+        A.initSystem();
+        timer.restart();
+        A.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G), u * ff * meas(G) );
+        const real_t tCrit = timer.stop();
+        Aref = A.matrix();
+
+        A.options().setSwitch("fixedPattern", true);
+        timer.restart();
+        A.initSystem();
+        const real_t tPattern = timer.stop();
+        timer.restart();
+        A.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G), u * ff * meas(G) );
+        const real_t tAtomic = timer.stop();
+
+        // Evaluation of the source function dominates this assembly
+        A.initVector();
+        timer.restart();
+        A.assemble( u * ff * meas(G) );
+        const real_t tRhs = timer.stop();
+
+        GISMO_ENSURE( (Aref - A.matrix()).norm() <= 1e-10 * Aref.norm(),
+                      "The assembled matrices do not agree.");
+
+        // The first assembly computes the pattern and the element
+        // maps, the second one only fills in the values
+        A.options().setSwitch("fixedPattern", false);
+        A.options().setSwitch("freezePattern", true);
+        A.initSystem();
+        A.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G), u * ff * meas(G) );
+        A.initSystem();
+        timer.restart();
+        A.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G), u * ff * meas(G) );
+        const real_t tFrozen = timer.stop();
+
+        // Same, with the basis evaluations kept in the
+        // element cache by the previous assembly
+        A.options().setInt("cacheBudget", 1024);
+        A.initSystem();
+        A.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G), u * ff * meas(G) );
+        A.initSystem();
+        timer.restart();
+        A.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G), u * ff * meas(G) );
+        const real_t tCached = timer.stop();
+        A.options().setInt("cacheBudget", 0);
+        A.options().setSwitch("freezePattern", false);
+
+        gsInfo << std::setw(7) << nt << std::setw(13) << tCrit
+               << std::setw(17) << tAtomic << std::setw(15) << tPattern
+               << std::setw(13) << tRhs << std::setw(10) << tFrozen
+               << std::setw(10) << tCached << "\n";
+
+        GISMO_ENSURE( (Aref - A.matrix()).norm() <= 1e-10 * Aref.norm(),
+                      "The assembled matrices do not agree.");
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+/** @file basisEvaluation_example.cpp
+
+    @brief Throughput of batched B-spline basis evaluation
+
+    Compares the point-wise evaluation of B-spline bases with the
+    batched evaluation, which treats the points of one knot span
+    together, and with the grid evaluation of tensor-product bases,
+    which builds the values from the univariate factors. The
+    throughput is reported in points per second.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <gismo.h>
+
+using namespace gismo;
+
+int main(int argc, char *argv[])
+{
+    index_t minDegree   = 2;
+    index_t maxDegree   = 6;
+    index_t numElements = 8;
+    index_t numRepeat   = 10;
+
+    gsCmdLine cmd("Throughput of batched B-spline basis evaluation.");
+    cmd.addInt( "p", "minDegree", "Smallest polynomial degree", minDegree );
+    cmd.addInt( "q", "maxDegree", "Largest polynomial degree", maxDegree );
+    cmd.addInt( "e", "elements", "Number of elements per direction", numElements );
+    cmd.addInt( "n", "repeat", "Number of repetitions", numRepeat );
+    try { cmd.getValues(argc,argv); } catch (int rv) { return rv; }
+
+    gsStopwatch timer;
+    std::vector<gsMatrix<> > ev0, ev1;
+
+    gsInfo << "Univariate, Gauss nodes of all elements [points/s]\n"
+           << "degree    points   pointwise     batched\n";
+    for (index_t p = minDegree; p <= maxDegree; ++p)
+    {
+        gsKnotVector<> kv(0, 1, numElements-1, p+1);
+        gsBSplineBasis<> basis(kv);
+
+        gsMatrix<> u;
+        gsVector<> w;
+        gsQuadrature::getUnivariate<real_t>(gsQuadrature::GaussLegendre, p+1)
+            .mapToAll(kv.breaks(), u, w);
+
+        timer.restart();
+        for (index_t i = 0; i < numRepeat; ++i)
+            basis.evalAllDers_into(u, 1, ev0);
+        const real_t t0 = timer.stop();
+        timer.restart();
+        for (index_t i = 0; i < numRepeat; ++i)
+            basis.evalAllDersBatch_into(u, 1, ev1);
+        const real_t t1 = timer.stop();
+
+        GISMO_ENSURE( (ev0[0]-ev1[0]).norm() + (ev0[1]-ev1[1]).norm() <= 1e-12 * ev0[1].norm(),
+                      "The batched evaluation does not agree.");
+
+        const real_t np = numRepeat * u.cols();
+        gsInfo << std::setw(6) << p << std::setw(10) << u.cols()
+               << std::setw(12) << np/t0 << std::setw(12) << np/t1 << "\n";
+    }
+
+    gsInfo << "\nTrivariate, Gauss grids element by element [points/s]\n"
+           << "degree    points   pointwise        grid\n";
+    for (index_t p = minDegree; p <= maxDegree; ++p)
+    {
+        gsKnotVector<> kv(0, 1, numElements-1, p+1);
+        gsTensorBSplineBasis<3> basis(kv, kv, kv);
+
+        gsQuadRule<> rule = gsQuadrature::getUnivariate<real_t>(gsQuadrature::GaussLegendre, p+1);
+        const std::vector<real_t> br = kv.breaks();
+
+        std::vector<gsMatrix<> > grid(3);
+        gsMatrix<> pts;
+        gsVector<> w;
+        real_t t0 = 0, t1 = 0, np = 0;
+        for (size_t e = 0; e + 1 < br.size(); ++e) // diagonal elements
+        {
+            for (short_t k = 0; k != 3; ++k)
+                rule.mapTo(br[e], br[e+1], grid[k], w);
+            gsPointGrid(grid, pts);
+
+            timer.restart();
+            for (index_t i = 0; i < numRepeat; ++i)
+                basis.evalAllDers_into(pts, 1, ev0);
+            t0 += timer.stop();
+            timer.restart();
+            for (index_t i = 0; i < numRepeat; ++i)
+                basis.evalAllDersGrid_into(grid, 1, ev1);
+            t1 += timer.stop();
+            np += numRepeat * pts.cols();
+
+            GISMO_ENSURE( (ev0[0]-ev1[0]).norm() + (ev0[1]-ev1[1]).norm() <= 1e-12 * ev0[1].norm(),
+                          "The grid evaluation does not agree.");
+        }
+
+        gsInfo << std::setw(6) << p << std::setw(10) << np/numRepeat
+               << std::setw(12) << np/t0 << std::setw(12) << np/t1 << "\n";
+    }
+
+    return EXIT_SUCCESS;
+}
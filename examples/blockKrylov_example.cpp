@@ -0,0 +1,162 @@
+/** @file blockKrylov_example.cpp
+
+    @brief Block Krylov solvers for several right-hand sides
+
+    Solves a Poisson problem on the unit square for several right-hand
+    sides (load cases) at once. The conjugate gradient method and GMRES
+    are applied to the columns one after the other, and compared with
+    the block conjugate gradient method and block GMRES, where the
+    columns share a Krylov space and the operator and the preconditioner
+    are applied to all columns at once (sparse matrix times dense block).
+
+    The preconditioner is either the Jacobi method, the fast
+    diagonalization method (a gsKroneckerOp of the univariate
+    eigenvectors) or one V-cycle of geometric multigrid with the
+    symmetric Gauss-Seidel smoother (a gsMultiGridOp); all of them
+    handle several columns at once.
+
+    Example:
+    \verbatim
+    ./bin/blockKrylov_example -r 6 -m 32 --precond mg
+    \endverbatim
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <gismo.h>
+
+using namespace gismo;
+
+// Solves for the columns of f one after the other
+void solveColumnwise(gsIterativeSolver<> & solver, const gsMatrix<> & f, gsMatrix<> & x, index_t & iter)
+{
+    x.setZero(f.rows(), f.cols());
+    iter = 0;
+    gsMatrix<> fj, xj;
+    for (index_t j = 0; j < f.cols(); ++j)
+    {
+        fj = f.col(j);
+        xj.setZero(f.rows(), 1);
+        solver.solve(fj, xj);
+        x.col(j) = xj;
+        iter += solver.iterations();
+    }
+}
+
+// Prints the maximum of the relative residuals of the columns and checks it
+bool report(const char * name, const gsSparseMatrix<> & A, const gsMatrix<> & f, const gsMatrix<> & x,
+            index_t iter, real_t time, real_t tol)
+{
+    const real_t err = ( (f - A * x).colwise().norm().array() / f.colwise().norm().array() ).maxCoeff();
+    gsInfo << std::setw(12) << std::left << name << std::setw(12) << iter
+           << std::setw(12) << time << err << "\n";
+    return err < 10 * tol;
+}
+
+int main(int argc, char *argv[])
+{
+    index_t degree      = 2;
+    index_t refinements = 5;
+    index_t numRhs      = 16;
+    index_t maxIter     = 1000;
+    real_t  tol         = 1e-8;
+    std::string precond("jacobi");
+
+    gsCmdLine cmd("Block Krylov solvers for several right-hand sides.");
+    cmd.addInt   ( "p", "degree", "Polynomial degree of the discretization", degree );
+    cmd.addInt   ( "r", "refinements", "Number of uniform refinements", refinements );
+    cmd.addInt   ( "m", "rhs", "Number of right-hand sides", numRhs );
+    cmd.addInt   ( "i", "iterations", "Maximum number of iterations", maxIter );
+    cmd.addReal  ( "t", "tolerance", "Tolerance for the relative residuals", tol );
+    cmd.addString( "",  "precond", "Preconditioner: jacobi, fd (fast diagonalization) or mg (multigrid)", precond );
+    try { cmd.getValues(argc,argv); } catch (int rv) { return rv; }
+
+    gsMultiPatch<> mp( *gsNurbsCreator<>::BSplineSquare() );
+    gsMultiBasis<> mb(mp);
+    mb[0].setDegreePreservingMultiplicity(degree);
+    for (index_t i = 0; i < refinements; ++i)
+        mb.uniformRefine();
+
+    gsConstantFunction<> zero(0.0, 2);
+    gsBoundaryConditions<> bc;
+    for (boxSide s = boxSide::getFirst(2); s < boxSide::getEnd(2); ++s)
+        bc.addCondition(0, s, condition_type::dirichlet, &zero);
+
+    gsPoissonAssembler<> assembler(mp, mb, bc, zero);
+    assembler.assemble();
+    const gsSparseMatrix<> & A = assembler.matrix();
+    gsInfo << "DoFs: " << A.rows() << ", right-hand sides: " << numRhs << "\n";
+
+    gsLinearOperator<>::Ptr prec;
+    if (precond == "jacobi")
+        prec = makeJacobiOp(A);
+    else if (precond == "fd")
+        prec = gsPatchPreconditionersCreator<>::fastDiagonalizationOp(mb[0], bc);
+    else if (precond == "mg")
+    {
+        std::vector< gsSparseMatrix<real_t,RowMajor> > transferMatrices;
+        gsGridHierarchy<>::buildByCoarsening(mb, bc, assembler.options(), 10, 10)
+            .moveTransferMatricesTo(transferMatrices);
+        gsMultiGridOp<>::Ptr mg = gsMultiGridOp<>::make(A, transferMatrices);
+        mg->setCoarseSolver( makeSparseCholeskySolver( mg->matrix(0) ) );
+        for (index_t i = 1; i < mg->numLevels(); ++i)
+            mg->setSmoother(i, makeSymmetricGaussSeidelOp(mg->matrix(i)));
+        prec = mg;
+    }
+    else
+    {
+        gsInfo << "Unknown preconditioner: " << precond << "\n";
+        return EXIT_FAILURE;
+    }
+
+    const gsMatrix<> f = gsMatrix<>::Random(A.rows(), numRhs);
+    gsMatrix<> x;
+    index_t iter;
+    bool ok = true;
+    gsStopwatch timer;
+
+    gsInfo << "solver      iterations  time[s]     max. rel. residual\n";
+
+    gsConjugateGradient<> cg(A, prec);
+    cg.setMaxIterations(maxIter);
+    cg.setTolerance(tol);
+    timer.restart();
+    solveColumnwise(cg, f, x, iter);
+    real_t time = timer.stop();
+    ok = report("CG", A, f, x, iter, time, tol) && ok;
+
+    gsBlockCG<> bcg(A, prec);
+    bcg.setMaxIterations(maxIter);
+    bcg.setTolerance(tol);
+    x.setZero(A.rows(), numRhs);
+    timer.restart();
+    bcg.solve(f, x);
+    time = timer.stop();
+    iter = bcg.iterations();
+    ok = report("block CG", A, f, x, iter, time, tol) && ok;
+
+    gsGMRes<> gmres(A, prec);
+    gmres.setMaxIterations(maxIter);
+    gmres.setTolerance(tol);
+    timer.restart();
+    solveColumnwise(gmres, f, x, iter);
+    time = timer.stop();
+    ok = report("GMRes", A, f, x, iter, time, tol) && ok;
+
+    gsBlockGMRes<> bgmres(A, prec);
+    bgmres.setMaxIterations(maxIter);
+    bgmres.setTolerance(tol);
+    x.setZero(A.rows(), numRhs);
+    timer.restart();
+    bgmres.solve(f, x);
+    time = timer.stop();
+    iter = bgmres.iterations();
+    ok = report("block GMRes", A, f, x, iter, time, tol) && ok;
+
+    gsInfo << "The iterations of the block solvers are block iterations.\n";
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
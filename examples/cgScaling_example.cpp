@@ -0,0 +1,105 @@
+/** @file cgScaling_example.cpp
+
+    @brief Thread-scaling of the conjugate gradient method
+
+    Runs a fixed number of steps of the (unpreconditioned) conjugate
+    gradient method for a Poisson problem on the unit square or cube
+    with an increasing number of threads. The stiffness matrix is obtained
+    by tensor products of the univariate mass and stiffness matrices,
+    so very large systems can be set up quickly. For comparison, the
+    time per iteration of the sequential sparse matrix-vector product
+    of Eigen and of the multithreaded gsParallelMatrixOp, which is
+    supplied to the conjugate gradient method, are given.
+
+    A system with ten million unknowns is obtained, e.g., by
+    \verbatim
+    ./bin/cgScaling_example -d 2 -p 1 -e 3163
+    ./bin/cgScaling_example -d 3 -p 2 -e 213
+    \endverbatim
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <gismo.h>
+
+using namespace gismo;
+
+int main(int argc, char *argv[])
+{
+    index_t dim         = 3;
+    index_t degree      = 2;
+    index_t numElements = 64;
+    index_t maxIter     = 100;
+    index_t maxThreads  = omp_get_max_threads();
+
+    gsCmdLine cmd("Thread-scaling of the conjugate gradient method.");
+    cmd.addInt( "d", "dim", "Spatial dimension (2 or 3)", dim );
+    cmd.addInt( "p", "degree", "Polynomial degree of the discretization", degree );
+    cmd.addInt( "e", "elements", "Number of elements per direction", numElements );
+    cmd.addInt( "i", "iterations", "Number of iterations", maxIter );
+    cmd.addInt( "t", "threads", "Maximum number of threads", maxThreads );
+    try { cmd.getValues(argc,argv); } catch (int rv) { return rv; }
+
+    GISMO_ENSURE(2==dim || 3==dim, "Dimension must be 2 or 3.");
+    gsKnotVector<> kv(0, 1, numElements-1, degree+1);
+    gsBasis<>::uPtr basis;
+    if (2==dim)
+        basis = memory::make_unique(new gsTensorBSplineBasis<2>(kv, kv));
+    else
+        basis = memory::make_unique(new gsTensorBSplineBasis<3>(kv, kv, kv));
+
+    gsConstantFunction<> g(0.0, dim);
+    gsBoundaryConditions<> bc;
+    for (boxSide s = boxSide::getFirst(dim); s < boxSide::getEnd(dim); ++s)
+        bc.addCondition(0, s, condition_type::dirichlet, &g);
+
+    gsStopwatch timer;
+    const gsSparseMatrix<> A = gsPatchPreconditionersCreator<>::stiffnessMatrix(*basis, bc);
+    gsInfo << "DoFs: " << A.rows() << ", non-zeros: " << A.nonZeros()
+           << ", setup took " << timer.stop() << " s.\n";
+
+    gsMatrix<> f, x, y0, y1;
+    f.setOnes(A.rows(), 1);
+
+    gsInfo << "threads  SpMV Eigen[s]  SpMV parallel[s]  CG[s/it]  iterations  speedup\n";
+    real_t tCg1 = 0;
+    for (index_t nt = 1; nt <= maxThreads; nt *= 2)
+    {
+        omp_set_num_threads(nt);
+
+        timer.restart();
+        for (index_t i = 0; i < maxIter; ++i)
+            y0.noalias() = A * f;
+        const real_t tEigen = timer.stop() / maxIter;
+
+        gsParallelMatrixOp<real_t> op(A);
+        timer.restart();
+        for (index_t i = 0; i < maxIter; ++i)
+            op.apply(f, y1);
+        const real_t tPar = timer.stop() / maxIter;
+        GISMO_ENSURE( (y0 - y1).norm() <= 1e-10 * y0.norm(),
+                      "The matrix-vector products do not agree.");
+
+        gsLinearOperator<>::Ptr opPtr = makeParallelMatrixOp(A);
+        gsConjugateGradient<> cg(opPtr);
+        cg.setMaxIterations(maxIter);
+        cg.setTolerance(1e-12);
+        x.setZero(A.rows(), 1);
+        timer.restart();
+        cg.solve(f, x);
+        const real_t tCg = timer.stop() / cg.iterations();
+        if (1 == nt)
+            tCg1 = tCg;
+
+        gsInfo << std::setw(7) << nt << " " << std::setw(14) << tEigen
+               << std::setw(18) << tPar << std::setw(11) << tCg
+               << std::setw(11) << cg.iterations()
+               << std::setw(9) << tCg1 / tCg << "\n";
+    }
+
+    return EXIT_SUCCESS;
+}
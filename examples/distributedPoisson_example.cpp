@@ -0,0 +1,139 @@
+/** @file distributedPoisson_example.cpp
+
+    @brief Distributed assembly and solution of a multipatch Poisson problem
+
+    Every process assembles the integrals on a consecutive range of the
+    elements of the multipatch domain (gsExprAssembler::setElementRange),
+    the contributions are summed up in a row-distributed matrix
+    (gsDistributedMatrixOp) and the system is solved by the conjugate
+    gradient method, whose inner products are summed up over the
+    processes. The preconditioner is block Jacobi, with the rows owned by
+    every process as blocks.
+
+    Example:
+    \verbatim
+    mpirun -np 4 ./bin/distributedPoisson_example -r 5
+    \endverbatim
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <gismo.h>
+
+using namespace gismo;
+
+int main(int argc, char *argv[])
+{
+    std::string geometry("domain2d/yeti_mp2.xml");
+    index_t degree      = 2;
+    index_t refinements = 3;
+    index_t maxIter     = 1000;
+    real_t  tol         = 1e-8;
+
+    gsCmdLine cmd("Distributed assembly and solution of a multipatch Poisson problem.");
+    cmd.addString( "g", "geometry", "File containing the multipatch geometry", geometry );
+    cmd.addInt   ( "p", "degree", "Polynomial degree of the discretization", degree );
+    cmd.addInt   ( "r", "refinements", "Number of uniform refinements", refinements );
+    cmd.addInt   ( "i", "iterations", "Maximum number of iterations", maxIter );
+    cmd.addReal  ( "t", "tolerance", "Tolerance for the relative residual", tol );
+    try { cmd.getValues(argc,argv); } catch (int rv) { return rv; }
+
+    const gsMpi & mpi = gsMpi::init(argc, argv);
+    gsMpiComm comm = mpi.worldComm();
+    const int rank   = comm.rank();
+    const int nProcs = comm.size();
+
+    gsMultiPatch<> mp;
+    gsReadFile<>(geometry, mp);
+    if (mp.nPatches() == 0)
+    {
+        gsInfo << "No geometry found in " << geometry << ".\n";
+        return EXIT_FAILURE;
+    }
+
+    gsMultiBasis<> mb(mp);
+    for (size_t i = 0; i < mb.nBases(); ++i)
+        mb[i].setDegreePreservingMultiplicity(degree);
+    for (index_t i = 0; i < refinements; ++i)
+        mb.uniformRefine();
+
+    // Problem with the exact solution sin(pi x) sin(pi y)
+    gsFunctionExpr<> f("2*pi^2*sin(pi*x)*sin(pi*y)", 2);
+    gsFunctionExpr<> uExact("sin(pi*x)*sin(pi*y)", 2);
+    gsBoundaryConditions<> bc;
+    for (gsMultiPatch<>::const_biterator it = mp.bBegin(); it < mp.bEnd(); ++it)
+        bc.addCondition(*it, condition_type::dirichlet, &uExact);
+    bc.setGeoMap(mp);
+
+    // Every process takes a consecutive range of the elements
+    index_t numElements = 0;
+    for (size_t i = 0; i < mb.nBases(); ++i)
+        numElements += mb.basis(i).numElements();
+    const index_t firstEl = numElements * rank / nProcs;
+    const index_t lastEl  = numElements * (rank+1) / nProcs;
+
+    gsExprAssembler<> assembler(1,1);
+    assembler.setIntegrationElements(mb);
+    assembler.setElementRange(firstEl, lastEl);
+    gsExprAssembler<>::geometryMap G = assembler.getMap(mp);
+    gsExprAssembler<>::space u = assembler.getSpace(mb);
+    auto ff = assembler.getCoeff(f, G);
+    u.setup(bc, dirichlet::interpolation, 0);
+
+    gsStopwatch timer;
+    assembler.initSystem();
+    assembler.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G), u * ff * meas(G) );
+    const double tAssemble = timer.stop();
+
+    timer.restart();
+    gsDistributedMatrixOp<>::Ptr A = gsDistributedMatrixOp<>::make(assembler.matrix(), comm);
+    gsMatrix<> rhs;
+    A->accumulate(assembler.rhs(), rhs);
+    const gsSparseMatrix<> localMatrix = A->localMatrix();
+    gsLinearOperator<>::Ptr prec = makeSparseCholeskySolver(localMatrix);
+    const double tSetup = timer.stop();
+
+    if (0 == rank)
+        gsInfo << "Processes: " << nProcs << ", patches: " << mp.nPatches()
+               << ", elements: " << numElements << ", DoFs: " << A->globalSize() << "\n";
+    for (int p = 0; p < nProcs; ++p)
+    {
+        if (p == rank)
+            gsInfo << "Process " << rank << ": elements " << firstEl << " to " << lastEl-1
+                   << ", owned DoFs: " << A->rows() << ", ghosts: " << A->numGhosts() << "\n";
+        comm.barrier();
+    }
+
+    gsConjugateGradient<> cg(A, prec);
+    cg.setComm(comm);
+    cg.setMaxIterations(maxIter);
+    cg.setTolerance(tol);
+    gsMatrix<> x;
+    x.setZero(A->rows(), 1);
+    timer.restart();
+    cg.solve(rhs, x);
+    const double tSolve = timer.stop();
+
+    // Collect the solution and compute the error
+    gsMatrix<> solVector;
+    A->gather(x, solVector);
+    gsExprEvaluator<> ev(assembler);
+    gsExprAssembler<>::solution uSol = assembler.getSolution(u, solVector);
+    auto uEx = ev.getVariable(uExact, G);
+    const real_t l2err = math::sqrt( ev.integral( (uEx - uSol).sqNorm() * meas(G) ) );
+
+    if (0 == rank)
+    {
+        gsInfo << "CG with block Jacobi: " << cg.iterations() << " iterations, error "
+               << cg.error() << "\n";
+        gsInfo << "L2 error: " << l2err << "\n";
+        gsInfo << "Assembly: " << tAssemble << " s, setup: " << tSetup
+               << " s, solving: " << tSolve << " s (process 0)\n";
+    }
+
+    return cg.error() < tol ? EXIT_SUCCESS : EXIT_FAILURE;
+}
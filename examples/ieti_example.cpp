@@ -8,6 +8,21 @@
     This class uses the expression assembler, for a use of the
     gsPoisson Assembler, see ieti2_example.cpp.
 
+    The local factorizations and solves are done in parallel; the
+    timings of the individual phases are printed at the end, so the
+    strong scaling can be checked by varying OMP_NUM_THREADS, e.g.,
+    \verbatim
+    OMP_NUM_THREADS=8 ./bin/ieti_example --SplitPatches 2 -r 4
+    \endverbatim
+
+    If G+Smo is compiled with MPI, the patches are distributed over
+    the processes, e.g.,
+    \verbatim
+    mpirun -np 16 ./bin/ieti_example --SplitPatches 2 -r 4
+    \endverbatim
+    Every process assembles and factorizes the local problems for its
+    patches; the printed timings are the maxima over the processes.
+
     This file is part of the G+Smo library.
 
     This Source Code Form is subject to the terms of the Mozilla Public
@@ -57,6 +72,12 @@ int main(int argc, char *argv[])
 
     try { cmd.getValues(argc,argv); } catch (int rv) { return rv; }
 
+    const gsMpi & mpi = gsMpi::init(argc, argv);
+    gsMpiComm comm = mpi.worldComm();
+
+    // Only the first process writes to the console
+    if (comm.rank() != 0)
+        gsInfo.setstate(std::ios_base::badbit);
 
     if ( ! gsFileManager::fileExists(geometry) )
     {
@@ -66,6 +87,7 @@ int main(int argc, char *argv[])
     }
 
     gsInfo << "Run ieti_example with options:\n" << cmd << std::endl;
+    gsInfo << "Processes: " << comm.size() << ", available threads: " << omp_get_max_threads() << "\n";
 
     /******************* Define geometry ********************/
 
@@ -172,8 +194,16 @@ int main(int argc, char *argv[])
 
     gsInfo << "Setup assembler and assemble matrix... " << std::flush;
 
+    gsStopwatch timer;
+
     const index_t nPatches = mp.nPatches();
 
+    // Every process takes a consecutive range of the patches
+    std::vector<index_t> myPatches;
+    for (index_t k=nPatches*comm.rank()/comm.size(); k<nPatches*(comm.rank()+1)/comm.size(); ++k)
+        myPatches.push_back(k);
+    const index_t nMyPatches = myPatches.size();
+
     //! [Define Ieti Mapper]
     gsIetiMapper<> ietiMapper;
     //! [Define Ieti Mapper]
@@ -228,12 +258,12 @@ int main(int argc, char *argv[])
     // The ieti system does not have a special treatment for the
     // primal dofs. They are just one more subdomain
     gsIetiSystem<> ieti;
-    ieti.reserve(nPatches+1);
+    ieti.reserve(nMyPatches+1);
 
     // The scaled Dirichlet preconditioner is independent of the
     // primal dofs.
     gsScaledDirichletPrec<> prec;
-    prec.reserve(nPatches);
+    prec.reserve(nMyPatches);
 
     // Setup the primal system, which needs to know the number of primal dofs.
     gsPrimalSystem<> primal(ietiMapper.nPrimalDofs());
@@ -242,8 +272,10 @@ int main(int argc, char *argv[])
     //! [Setup]
 
     //! [Assemble]
-    for (index_t k=0; k<nPatches; ++k)
+    for (index_t j=0; j<nMyPatches; ++j)
     {
+        const index_t k = myPatches[j];
+
         // We use the local variants of everything
         gsBoundaryConditions<> bc_local;
         bc.getConditionsForPatch(k,bc_local);
@@ -338,6 +370,10 @@ int main(int argc, char *argv[])
     //! [Primal to system]
     if (ietiMapper.nPrimalDofs()>0)
     {
+        // The contributions of all processes to the primal problem are
+        // summed up; the primal problem is shared by all processes
+        primal.accumulate(comm);
+
         // It is not required to provide a local solver to .addSubdomain,
         // since a sparse LU solver would be set up on the fly if required.
         // Here, we make use of the fact that we can use a Cholesky solver
@@ -345,7 +381,7 @@ int main(int argc, char *argv[])
         gsLinearOperator<>::Ptr localSolver
             = makeSparseCholeskySolver(primal.localMatrix());
 
-        ieti.addSubdomain(
+        ieti.addSharedSubdomain(
             primal.jumpMatrix().moveToPtr(),
             makeMatrixOp(primal.localMatrix().moveToPtr()),
             give(primal.localRhs()),
@@ -354,7 +390,15 @@ int main(int argc, char *argv[])
     }
     //! [Primal to system]
 
+    // Distribute the Lagrange multipliers over the processes; each process
+    // only exchanges data with the processes that hold neighboring patches
+    //! [Distribute]
+    ieti.distribute(comm);
+    prec.setDistribution(ieti.distribution());
+    //! [Distribute]
+
     gsInfo << "done. " << ietiMapper.nPrimalDofs() << " primal dofs.\n";
+    real_t tAssemble = timer.stop();
 
     /**************** Setup solver and solve ****************/
 
@@ -367,35 +411,51 @@ int main(int argc, char *argv[])
     //! [Setup scaling]
 
     gsInfo << "done.\n    Setup rhs... " << std::flush;
-    // Compute the Schur-complement contribution for the right-hand-side
+    // Compute the Schur-complement contribution for the right-hand-side;
+    // this also sets up the local solvers
+    timer.restart();
     //! [Setup rhs]
     gsMatrix<> rhsForSchur = ieti.rhsForSchurComplement();
     //! [Setup rhs]
+    real_t tSetup = timer.stop();
 
     gsInfo << "done.\n    Setup cg solver for Lagrange multipliers and solve... " << std::flush;
     // Initial guess
     //! [Define initial guess]
     gsMatrix<> lambda;
-    lambda.setRandom( ieti.nLagrangeMultipliers(), 1 );
+    lambda.setRandom( ieti.distribution()->numOwned(), 1 );
     //! [Define initial guess]
 
     gsMatrix<> errorHistory;
 
     // This is the main cg iteration
     //! [Solve]
+    timer.restart();
     gsConjugateGradient<> PCG( ieti.schurComplement(), prec.preconditioner() );
+    PCG.setComm(comm);
     PCG.setOptions( cmd.getGroup("Solver") ).solveDetailed( rhsForSchur, lambda, errorHistory );
     //! [Solve]
+    real_t tSolve = timer.stop();
 
     gsInfo << "done.\n    Reconstruct solution from Lagrange multipliers... " << std::flush;
     // Now, we want to have the global solution for u
+    timer.restart();
     //! [Recover]
     gsMatrix<> uVec = ietiMapper.constructGlobalSolutionFromLocalSolutions(
         primal.distributePrimalSolution(
             ieti.constructSolutionFromLagrangeMultipliers(lambda)
-        )
+        ),
+        myPatches
     );
+    comm.sum(uVec.data(), uVec.size());
     //! [Recover]
+    real_t tRecover = timer.stop();
+
+    // The slowest process determines the timings
+    tAssemble = comm.max(tAssemble);
+    tSetup    = comm.max(tSetup);
+    tSolve    = comm.max(tSolve);
+    tRecover  = comm.max(tRecover);
     gsInfo << "done.\n\n";
 
     /******************** Print end Exit ********************/
@@ -415,7 +475,12 @@ int main(int argc, char *argv[])
     if (calcEigenvalues)
         gsInfo << "Estimated condition number: " << PCG.getConditionNumber() << "\n";
 
-    if (!out.empty())
+    gsInfo << "Timings: assembling " << tAssemble << " s, setup of local solvers "
+           << tSetup << " s, solving " << tSolve << " s ("
+           << (iter > 0 ? tSolve / iter : tSolve) << " s per iteration), recovering "
+           << tRecover << " s.\n";
+
+    if (!out.empty() && comm.rank() == 0)
     {
         gsFileData<> fd;
         std::time_t time = std::time(NULL);
@@ -426,7 +491,7 @@ int main(int argc, char *argv[])
         gsInfo << "Write solution to file " << out << "\n";
     }
 
-    if (plot)
+    if (plot && comm.rank() == 0)
     {
         gsInfo << "Write Paraview data to file ieti_result.pvd\n";
         // Construct the solution as a scalar field
@@ -178,6 +178,42 @@ int main(int argc, char *argv[])
     gsInfo << "done.\n";
     gsIterativeSolverInfo(CGSolver, (mat*x0-rhs).norm()/rhs.norm(), clock.stop(), succeeded);
 
+    //Initialize the pipelined CG solver
+    gsPipelinedCG<> PCGSolver(mat,preConMat);
+    PCGSolver.setOptions(opt);
+
+    //Set the initial guess to zero
+    x0.setZero(N,1);
+
+    //Solve system with given preconditioner (solution is stored in x0)
+    gsInfo << "\nPipelined CG: Started solving... ";
+    clock.restart();
+    PCGSolver.solve(rhs,x0);
+    gsInfo << "done.\n";
+    gsIterativeSolverInfo(PCGSolver, (mat*x0-rhs).norm()/rhs.norm(), clock.stop(), succeeded);
+
+    //Initialize the s-step GMRes solver (without restarts)
+    gsOptionList optSStep = gsSStepGMRes<>::defaultOptions();
+    optSStep.update(opt, gsOptionList::ignoreIfUnknown);
+    optSStep.setInt("Restart", N);
+    gsSStepGMRes<> SStepGMResSolver(mat,preConMat);
+    SStepGMResSolver.setOptions(optSStep);
+
+    //Set the initial guess to zero
+    x0.setZero(N,1);
+
+    if (N < 200)
+    {
+        //Solve system with given preconditioner (solution is stored in x0)
+        gsInfo << "\ns-step GMRes: Started solving... ";
+        clock.restart();
+        SStepGMResSolver.solve(rhs,x0);
+        gsInfo << "done.\n";
+        gsIterativeSolverInfo(SStepGMResSolver, (mat*x0-rhs).norm()/rhs.norm(), clock.stop(), succeeded);
+    }
+    else
+        gsInfo << "\nSkipping s-step GMRes due to high number of iterations...\n";
+
     //Initialize the MINRES-QLP solver
     gsMinResQLP<> MRQLPSolver(mat,preConMat);
     MRQLPSolver.setOptions(opt);
@@ -0,0 +1,113 @@
+/** @file matrixFree_example.cpp
+
+    @brief Matrix-free application of an expression assembler operator
+
+    Solves a Poisson problem with the conjugate gradient method, once
+    with the assembled sparse matrix and once with the matrix-free
+    operator of gsExprAssembler, and compares memory use and the time
+    per operator application.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <gismo.h>
+
+using namespace gismo;
+
+int main(int argc, char *argv[])
+{
+    index_t numRefine = 2;
+    index_t degree    = 2;
+    index_t numApply  = 10;
+
+    gsCmdLine cmd("Matrix-free application of an expression assembler operator.");
+    cmd.addInt( "r", "uniformRefine", "Number of uniform h-refinement steps", numRefine );
+    cmd.addInt( "p", "degree", "Polynomial degree of the discretization", degree );
+    cmd.addInt( "n", "numApply", "Number of operator applications to time", numApply );
+    try { cmd.getValues(argc,argv); } catch (int rv) { return rv; }
+
+    gsMultiPatch<> mp;
+    mp.addPatch( gsNurbsCreator<>::lift3D(*gsNurbsCreator<>::BSplineFatQuarterAnnulus()) );
+    mp.computeTopology();
+
+    gsMultiBasis<> dbasis(mp);
+    dbasis.setDegree(degree);
+    for (index_t r = 0; r < numRefine; ++r)
+        dbasis.uniformRefine();
+
+    gsFunctionExpr<> f("sin(pi*x)*sin(pi*y)*sin(pi*z)", 3);
+    gsConstantFunction<> g(0.0, 3);
+
+    gsBoundaryConditions<> bc;
+    bc.setGeoMap(mp);
+    for (gsMultiPatch<>::const_biterator bit = mp.bBegin(); bit != mp.bEnd(); ++bit)
+        bc.addCondition(*bit, condition_type::dirichlet, g);
+
+    gsExprAssembler<> A(1,1);
+    A.setIntegrationElements(dbasis);
+    gsExprAssembler<>::geometryMap G = A.getMap(mp);
+    gsExprAssembler<>::space u = A.getSpace(dbasis);
+    auto ff = A.getCoeff(f, G);
+    u.setup(bc, dirichlet::homogeneous, 0);
+    A.initSystem();
+
+    auto bf = igrad(u, G) * igrad(u, G).tr() * meas(G);
+    gsStopwatch timer;
+    A.assemble( bf, u * ff * meas(G) );
+    const real_t tAssemble = timer.stop();
+    const gsSparseMatrix<> & K = A.matrix();
+
+    gsInfo << "Degree: "<< degree <<", elements: "<< dbasis.totalElements()
+           <<", DoFs: "<< A.numDofs() <<"\n";
+
+    // Memory held by the operator
+    const real_t nnzBytes = K.nonZeros() * (sizeof(real_t) + sizeof(index_t))
+        + (K.outerSize()+1) * sizeof(index_t);
+    gsInfo << "Sparse matrix: "<< K.nonZeros() <<" nonzeros, "
+           << nnzBytes / (1<<20) <<" MB, assembled in "<< tAssemble <<"s\n";
+    gsInfo << "Matrix-free  : no stored matrix\n";
+
+    gsLinearOperator<>::Ptr Kop   = makeMatrixOp(K);
+    gsLinearOperator<>::Ptr Kfree = A.matrixFreeOp(bf);
+
+    // Operator application
+    gsMatrix<> x, y0, y1;
+    x.setRandom(A.numDofs(), 1);
+    timer.restart();
+    for (index_t i = 0; i < numApply; ++i)
+        Kop->apply(x, y0);
+    const real_t tSpMV = timer.stop() / numApply;
+    timer.restart();
+    for (index_t i = 0; i < numApply; ++i)
+        Kfree->apply(x, y1);
+    const real_t tFree = timer.stop() / numApply;
+    GISMO_ENSURE( (y0 - y1).norm() <= 1e-10 * y0.norm(),
+                  "The matrix-free product does not agree with the matrix.");
+
+    gsInfo << "Time per application: sparse "<< tSpMV <<"s ("
+           << nnzBytes / tSpMV / 1e9 <<" GB/s), matrix-free "<< tFree <<"s\n";
+
+    // Solve with both operators
+    gsMatrix<> sol0, sol1;
+    gsConjugateGradient<> cg0(Kop), cg1(Kfree);
+    cg0.setTolerance(1e-8);
+    cg1.setTolerance(1e-8);
+    sol0.setZero(A.numDofs(), 1);
+    sol1.setZero(A.numDofs(), 1);
+    timer.restart();
+    cg0.solve(A.rhs(), sol0);
+    const real_t tCg0 = timer.stop();
+    timer.restart();
+    cg1.solve(A.rhs(), sol1);
+    const real_t tCg1 = timer.stop();
+
+    gsInfo << "CG sparse     : "<< cg0.iterations() <<" iterations, "<< tCg0 <<"s\n";
+    gsInfo << "CG matrix-free: "<< cg1.iterations() <<" iterations, "<< tCg1 <<"s\n";
+    gsInfo << "Difference of the solutions: "<< (sol0 - sol1).norm() <<"\n";
+
+    return EXIT_SUCCESS;
+}
@@ -41,6 +41,7 @@ int main(int argc, char *argv[])
     std::string smoother("GaussSeidel");
     real_t damping = -1;
     real_t scaling = 0.12;
+    index_t chebDegree = 2;
     std::string iterativeSolver("cg");
     real_t tolerance = 1.e-8;
     index_t maxIterations = 100;
@@ -66,6 +67,7 @@ int main(int argc, char *argv[])
     cmd.addString("s", "MG.Smoother",           "Smoothing method", smoother);
     cmd.addReal  ("",  "MG.Damping",            "Damping factor for the smoother", damping);
     cmd.addReal  ("",  "MG.Scaling",            "Scaling factor for the subspace corrected mass smoother", scaling);
+    cmd.addInt   ("",  "MG.PolynomialDegree",   "Degree of the Chebyshev smoother", chebDegree);
     cmd.addString("i", "IterativeSolver",       "Iterative solver: apply multigrid directly (d) or as a preconditioner for "
                                                 "conjugate gradient (cg)", iterativeSolver);
     cmd.addReal  ("t", "Solver.Tolerance",      "Stopping criterion for linear solver", tolerance);
@@ -298,6 +300,14 @@ int main(int argc, char *argv[])
             smootherOp = makeJacobiOp(mg->matrix(i));
         else if ( smoother == "GaussSeidel" || smoother == "gs" )
             smootherOp = makeGaussSeidelOp(mg->matrix(i));
+        else if ( smoother == "SymmetricGaussSeidel" || smoother == "sgs" )
+            smootherOp = makeSymmetricGaussSeidelOp(mg->matrix(i));
+        else if ( smoother == "ColoredGaussSeidel" || smoother == "cgs" )
+            smootherOp = makeColoredGaussSeidelOp(mg->matrix(i));
+        else if ( smoother == "ColoredSymmetricGaussSeidel" || smoother == "csgs" )
+            smootherOp = makeColoredSymmetricGaussSeidelOp(mg->matrix(i));
+        else if ( smoother == "Chebyshev" || smoother == "cheb" )
+            smootherOp = makeChebyshevOp(mg->matrix(i));
         else if ( smoother == "IncompleteLU" || smoother == "ilu" )
             smootherOp = makeIncompleteLUOp(mg->matrix(i));
         else if ( smoother == "SubspaceCorrectedMassSmoother" || smoother == "scms" )
@@ -313,6 +323,7 @@ int main(int argc, char *argv[])
         else
         {
             gsInfo << "\n\nThe chosen smoother is unknown.\n\nKnown are:\n  Richardson (r)\n  Jacobi (j)\n  GaussSeidel (gs)"
+                      "\n  SymmetricGaussSeidel (sgs)\n  ColoredGaussSeidel (cgs)\n  ColoredSymmetricGaussSeidel (csgs)\n  Chebyshev (cheb)"
                       "\n  IncompleteLU (ilu)\n  SubspaceCorrectedMassSmoother (scms)\n  Hybrid (hyb)\n\n";
             return EXIT_FAILURE;
         }
@@ -340,6 +351,7 @@ int main(int argc, char *argv[])
     x.setRandom( assembler.matrix().rows(), 1 );
     //! [Initial guess]
 
+    gsStopwatch timer;
     //! [Solve]
     if (iterativeSolver=="cg")
         gsConjugateGradient<>( assembler.matrix(), mg )
@@ -356,6 +368,7 @@ int main(int argc, char *argv[])
         return EXIT_FAILURE;
     }
 
+    const real_t solveTime = timer.stop();
     gsInfo << "done.\n\n";
 
     /******************** Print end Exit ********************/
@@ -372,6 +385,8 @@ int main(int argc, char *argv[])
     else
         gsInfo << errorHistory.topRows(5).transpose() << " ... " << errorHistory.bottomRows(5).transpose()  << "\n\n";
 
+    gsInfo << "Solving took " << solveTime << " s, i.e., " << solveTime/iter << " s per iteration.\n\n";
+
     if (!out.empty())
     {
         gsFileData<> fd;
@@ -0,0 +1,78 @@
+/** @file pointEvaluation_example.cpp
+
+    @brief Parallel evaluation of a geometry on many points
+
+    Evaluates a geometry and its derivatives on a large set of random
+    parameter points, once with eval_into() and once with
+    evalParallel_into(), which orders the points by element and
+    distributes chunks of them among the threads. The throughput is
+    reported in points per second.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <gismo.h>
+
+using namespace gismo;
+
+int main(int argc, char *argv[])
+{
+    index_t numPoints = 100000;
+    index_t numRefine = 3;
+    index_t degree    = 3;
+
+    gsCmdLine cmd("Parallel evaluation of a geometry on many points.");
+    cmd.addInt( "n", "points", "Number of evaluation points", numPoints );
+    cmd.addInt( "r", "uniformRefine", "Number of uniform h-refinement steps", numRefine );
+    cmd.addInt( "p", "degree", "Polynomial degree of the geometry", degree );
+    try { cmd.getValues(argc,argv); } catch (int rv) { return rv; }
+
+    gsGeometry<>::uPtr geo = gsNurbsCreator<>::lift3D(*gsNurbsCreator<>::BSplineFatQuarterAnnulus());
+    geo->degreeElevate(degree - geo->degree(0));
+    for (index_t r = 0; r < numRefine; ++r)
+        geo->uniformRefine();
+
+    gsMatrix<> u = gsMatrix<>::Random(3, numPoints);
+    u.array() = (u.array() + 1) / 2;
+
+    gsInfo << "Degree: "<< degree <<", elements: "<< geo->basis().numElements()
+           <<", points: "<< numPoints <<"\n"
+           << "threads  values[points/s] derivs[points/s]\n";
+
+    gsStopwatch timer;
+    gsMatrix<> v0, d0, v1, d1;
+    timer.restart();
+    geo->eval_into(u, v0);
+    const real_t tv = timer.stop();
+    timer.restart();
+    geo->deriv_into(u, d0);
+    const real_t td = timer.stop();
+    gsInfo << std::setw(7) << "serial" << std::setw(17) << numPoints/tv
+           << std::setw(17) << numPoints/td << "\n";
+
+    const index_t maxThreads = omp_get_max_threads();
+    for (index_t nt = 1; nt <= maxThreads; nt *= 2)
+    {
+        omp_set_num_threads(nt);
+        timer.restart();
+        geo->evalParallel_into(u, v1);
+        const real_t tv1 = timer.stop();
+        timer.restart();
+        geo->evalParallel_into(u, d1, 1);
+        const real_t td1 = timer.stop();
+
+        GISMO_ENSURE( (v0-v1).norm() <= 1e-12 * v0.norm() &&
+                      (d0-d1).norm() <= 1e-12 * d0.norm(),
+                      "The parallel evaluation does not agree.");
+
+        gsInfo << std::setw(7) << nt << std::setw(17) << numPoints/tv1
+               << std::setw(17) << numPoints/td1 << "\n";
+    }
+    omp_set_num_threads(maxThreads);
+
+    return EXIT_SUCCESS;
+}
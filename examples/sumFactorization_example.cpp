@@ -0,0 +1,81 @@
+/** @file sumFactorization_example.cpp
+
+    @brief Speedup of sum-factorized mass and stiffness assembly
+
+    Assembles the mass and the stiffness matrix of a tensor-product
+    B-spline basis on a curved 3D patch for increasing degree, once
+    with point-wise quadrature and once with sum factorization, and
+    prints the timings. The defaults are small, since the example
+    also runs as a test; use e.g. -q 8 -r 2 for a meaningful comparison.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <gismo.h>
+
+using namespace gismo;
+
+int main(int argc, char *argv[])
+{
+    index_t minDegree = 2;
+    index_t maxDegree = 3;
+    index_t numRefine = 1;
+
+    gsCmdLine cmd("Speedup of sum-factorized mass and stiffness assembly.");
+    cmd.addInt( "p", "minDegree", "Smallest polynomial degree", minDegree );
+    cmd.addInt( "q", "maxDegree", "Largest polynomial degree", maxDegree );
+    cmd.addInt( "r", "uniformRefine", "Number of uniform h-refinement steps", numRefine );
+    try { cmd.getValues(argc,argv); } catch (int rv) { return rv; }
+
+    // A curved 3D patch: a quarter annulus lifted to a volume
+    gsMultiPatch<> mp;
+    mp.addPatch( gsNurbsCreator<>::lift3D(*gsNurbsCreator<>::BSplineFatQuarterAnnulus()) );
+
+    gsInfo << "degree  elements      DoFs  mass[s]  mass-SF[s]  speedup  stiff[s]  stiff-SF[s]  speedup\n";
+
+    gsStopwatch timer;
+    for (index_t p = minDegree; p <= maxDegree; ++p)
+    {
+        gsMultiBasis<> dbasis(mp);
+        dbasis.setDegree(p);
+        for (index_t r = 0; r < numRefine; ++r)
+            dbasis.uniformRefine();
+
+        gsOptionList opt = gsGenericAssembler<>::defaultOptions();
+        gsGenericAssembler<> A(mp, dbasis, opt);
+
+        A.options().setSwitch("SumFactorization", false);
+        timer.restart();
+        gsSparseMatrix<> M = A.assembleMass();
+        const real_t tMass = timer.stop();
+        timer.restart();
+        gsSparseMatrix<> K = A.assembleStiffness();
+        const real_t tStiff = timer.stop();
+
+        A.options().setSwitch("SumFactorization", true);
+        timer.restart();
+        const gsSparseMatrix<> & Msf = A.assembleMass();
+        const real_t tMassSF = timer.stop();
+        GISMO_ENSURE( (M - Msf).norm() <= 1e-10 * M.norm(),
+                      "The mass matrices do not agree.");
+        timer.restart();
+        const gsSparseMatrix<> & Ksf = A.assembleStiffness();
+        const real_t tStiffSF = timer.stop();
+        GISMO_ENSURE( (K - Ksf).norm() <= 1e-10 * K.norm(),
+                      "The stiffness matrices do not agree.");
+
+        gsInfo << std::setprecision(3)
+               << std::setw(6) << p << std::setw(10) << dbasis.totalElements()
+               << std::setw(10) << dbasis.totalSize()
+               << std::setw(9) << tMass << std::setw(12) << tMassSF
+               << std::setw(9) << tMass/tMassSF
+               << std::setw(10) << tStiff << std::setw(13) << tStiffSF
+               << std::setw(9) << tStiff/tStiffSF << "\n";
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/** @file thbEvaluation_example.cpp
+
+    @brief Throughput of THB-spline basis evaluation on adaptive meshes
+
+    Compares the evaluation of the active THB-spline functions one by
+    one (evalSingle_into() and derivSingle_into() for each active
+    function) with gsTHBSplineBasis::evalAllDers_into(), which
+    evaluates the tensor basis of each level once per point set and
+    applies the truncation coefficients as a sparse product. The
+    meshes are refined towards a corner of the parameter domain, and
+    the Gauss nodes are evaluated element by element. The throughput
+    is reported in points per second.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <gismo.h>
+
+using namespace gismo;
+
+// Values and gradients of the active functions, evaluated one by one
+template <short_t d>
+void evalPerFunction(const gsTHBSplineBasis<d> & thb, const gsMatrix<> & u,
+                     std::vector<gsMatrix<> > & result)
+{
+    gsMatrix<index_t> act;
+    gsMatrix<> val, der;
+    thb.active_into(u, act);
+    result.resize(2);
+    result[0].setZero(act.rows(), u.cols());
+    result[1].setZero(d * act.rows(), u.cols());
+    for (index_t i = 0; i < act.cols(); ++i)
+        for (index_t j = 0; j < act.rows(); ++j)
+        {
+            const index_t index = act(j, i);
+            if (j != 0 && index == 0)
+                break;
+            thb.evalSingle_into(index, u.col(i), val);
+            result[0](j, i) = val.value();
+            thb.derivSingle_into(index, u.col(i), der);
+            result[1].block(j * d, i, d, 1) = der;
+        }
+}
+
+template <short_t d>
+void compare(index_t p, index_t numElements, index_t minLevels, index_t maxLevels,
+             index_t numRepeat)
+{
+    gsInfo << "\n" << d << "D, degree " << p << ", Gauss nodes element by element [points/s]\n"
+           << "levels  elements      points  per function   level-wise\n";
+
+    gsKnotVector<> kv(0, 1, numElements-1, p+1);
+    std::vector<gsKnotVector<> > kvs(d, kv);
+    gsTensorBSplineBasis<d> tbasis(kvs);
+
+    gsStopwatch timer;
+    std::vector<gsMatrix<> > ev0, ev1;
+    gsMatrix<> box(d, 2), nodes;
+    gsVector<> weights;
+    gsOptionList opt = gsAssembler<>::defaultOptions();
+
+    for (index_t levels = minLevels; levels <= maxLevels; ++levels)
+    {
+        // Refine the corner [0,2^-k]^d for k = 1..levels-1
+        gsTHBSplineBasis<d> thb(tbasis);
+        for (index_t k = 1; k < levels; ++k)
+        {
+            box.col(0).setZero();
+            box.col(1).setConstant( math::pow(0.5, (real_t)k) );
+            thb.refine(box);
+        }
+
+        gsQuadRule<> qu = gsQuadrature::get(thb, opt);
+        typename gsBasis<>::domainIter domIt = thb.makeDomainIterator();
+        real_t t0 = 0, t1 = 0, np = 0;
+        for (; domIt->good(); domIt->next())
+        {
+            qu.mapTo(domIt->lowerCorner(), domIt->upperCorner(), nodes, weights);
+
+            timer.restart();
+            for (index_t i = 0; i < numRepeat; ++i)
+                evalPerFunction(thb, nodes, ev0);
+            t0 += timer.stop();
+            timer.restart();
+            for (index_t i = 0; i < numRepeat; ++i)
+                thb.evalAllDers_into(nodes, 1, ev1);
+            t1 += timer.stop();
+            np += numRepeat * nodes.cols();
+
+            GISMO_ENSURE( (ev0[0]-ev1[0]).norm() + (ev0[1]-ev1[1]).norm() <= 1e-10 * ev0[1].norm(),
+                          "The level-wise evaluation does not agree.");
+        }
+
+        gsInfo << std::setw(6) << thb.maxLevel()+1 << std::setw(10) << thb.numElements()
+               << std::setw(12) << np/numRepeat
+               << std::setw(14) << np/t0 << std::setw(13) << np/t1 << "\n";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    index_t degree      = 2;
+    index_t numElements = 4;
+    index_t minLevels   = 4;
+    index_t maxLevels   = 8;
+    index_t numRepeat   = 3;
+    bool only2d = false;
+
+    gsCmdLine cmd("Throughput of THB-spline basis evaluation on adaptive meshes.");
+    cmd.addInt( "p", "degree", "Polynomial degree", degree );
+    cmd.addInt( "e", "elements", "Number of coarse elements per direction", numElements );
+    cmd.addInt( "l", "minLevels", "Smallest number of levels", minLevels );
+    cmd.addInt( "L", "maxLevels", "Largest number of levels", maxLevels );
+    cmd.addInt( "n", "repeat", "Number of repetitions", numRepeat );
+    cmd.addSwitch("only2d", "Skip the trivariate meshes", only2d );
+    try { cmd.getValues(argc,argv); } catch (int rv) { return rv; }
+
+    compare<2>(degree, numElements, minLevels, maxLevels, numRepeat);
+    if (!only2d)
+        compare<3>(degree, numElements, minLevels, maxLevels, numRepeat);
+
+    return EXIT_SUCCESS;
+}
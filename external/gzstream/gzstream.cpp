@@ -100,6 +100,30 @@ int gzstreambuf::underflow() { // used for input buffer only
     return * reinterpret_cast<unsigned char *>( gptr());
 }
 
+// G+Smo: large reads go directly to gzread, not through the buffer
+std::streamsize gzstreambuf::xsgetn( char* s, std::streamsize n) {
+    if ( ! (mode & std::ios::in) || ! opened)
+        return 0;
+    // first the characters that are left in the buffer
+    std::streamsize done = egptr() - gptr();
+    if ( done > n)
+        done = n;
+    memcpy( s, gptr(), done);
+    gbump( (int) done);
+    while ( done < n) {
+        const std::streamsize chunk = n - done < (1<<30) ? n - done : (1<<30);
+        int num = gzread( file, s + done, (unsigned) chunk);
+        if (num <= 0) // ERROR or EOF
+            break;
+        done += num;
+        // keep the putback area of underflow() consistent
+        int n_putback = done < 4 ? (int) done : 4;
+        memcpy( buffer + (4 - n_putback), s + done - n_putback, n_putback);
+        setg( buffer + (4 - n_putback), buffer + 4, buffer + 4);
+    }
+    return done;
+}
+
 int gzstreambuf::flush_buffer() {
     // Separate the writing of the buffer from overflow() and
     // sync() operation.
@@ -68,6 +68,7 @@ public:
 
     virtual int     overflow( int c = EOF);
     virtual int     underflow();
+    virtual std::streamsize xsgetn( char* s, std::streamsize n); // G+Smo
     virtual int     sync();
 };
 
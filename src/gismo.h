@@ -150,6 +150,7 @@ namespace internal
 /* ----------- MultiGrid ----------- */
 #include <gsMultiGrid/gsMultiGrid.h>
 #include <gsMultiGrid/gsGridHierarchy.h>
+#include <gsMultiGrid/gsSmoothedAggregation.h>
 
 /* ----------- Quadrature ----------- */
 #include <gsAssembler/gsQuadRule.h>
@@ -176,6 +177,10 @@ namespace internal
 #include <gsSolver/gsGMRes.h>
 #include <gsSolver/gsGradientMethod.h>
 #include <gsSolver/gsConjugateGradient.h>
+#include <gsSolver/gsPipelinedCG.h>
+#include <gsSolver/gsSStepGMRes.h>
+#include <gsSolver/gsBlockCG.h>
+#include <gsSolver/gsBlockGMRes.h>
 #include <gsSolver/gsBiCgStab.h>
 #include <gsSolver/gsPreconditioner.h>
 #include <gsSolver/gsAdditiveOp.h>
@@ -183,8 +188,12 @@ namespace internal
 #include <gsSolver/gsCompositePrecOp.h>
 #include <gsSolver/gsProductOp.h>
 #include <gsSolver/gsSimplePreconditioners.h>
+#include <gsSolver/gsChebyshevOp.h>
 #include <gsSolver/gsSumOp.h>
 #include <gsSolver/gsKroneckerOp.h>
+#include <gsSolver/gsDistributedMatrixOp.h>
+#include <gsSolver/gsDistributedIndexSet.h>
+#include <gsSolver/gsDistributedAdditiveOp.h>
 #include <gsSolver/gsPatchPreconditionersCreator.h>
 #include <gsSolver/gsLanczosMatrix.h>
 #include <gsSolver/gsMinResQLP.h>
@@ -203,6 +212,7 @@ namespace internal
 #include <gsIO/gsWriteParaview.h>
 #include <gsIO/gsParaviewCollection.h>
 #include <gsIO/gsParaviewDataSet.h>
+#include <gsIO/gsVtkDataArrays.h>
 #include <gsIO/gsReadFile.h>
 #include <gsUtils/gsPointGrid.h>
 #include <gsIO/gsXmlUtils.h>
@@ -18,6 +18,7 @@
 #include <gsAssembler/gsExprHelper.h>
 
 #include <gsAssembler/gsCPPInterface.h>
+#include <gsSolver/gsLinearOperator.h>
 
 namespace gismo
 {
@@ -42,6 +43,19 @@ private:
     std::vector<gsFeSpaceData<T>*> m_vrow;
     std::vector<gsFeSpaceData<T>*> m_vcol;
 
+    // True if the structure of m_matrix holds all element couplings
+    bool m_fixedPattern;
+
+    // Positions of the local matrix entries in the value array of
+    // m_matrix, per pair of (row,column) spaces and per element
+    std::vector<std::vector<std::vector<index_t> > > m_slots;
+    index_t m_slotsNnz; // number of nonzeros the positions refer to
+    size_t m_slotsSize, m_slotsMax; // number of stored positions, and its bound
+
+    // Range [m_elFirst,m_elLast) of the (global) element numbers to be
+    // assembled, see setElementRange()
+    index_t m_elFirst, m_elLast;
+
     typedef typename gsExprHelper<T>::nullExpr    nullExpr;
 
 public:
@@ -67,12 +81,18 @@ public:
         m_exprdata->cleanUp();
     }
 
+    /// @brief Drops the cached basis evaluations (see option
+    /// "cacheBudget"). Call this after modifying the discretization
+    /// bases in place.
+    void clearCache() { m_exprdata->clearCache(); }
+
     /// Constructor
     /// \param _rBlocks Number of spaces for test functions
     /// \param _cBlocks Number of spaces for solution variables
     gsExprAssembler(index_t _rBlocks = 1, index_t _cBlocks = 1)
     : m_exprdata(gsExprHelper<T>::make()), m_gmap(nullptr), m_options(defaultOptions()),
-      m_vrow(_rBlocks,nullptr), m_vcol(_cBlocks,nullptr)
+      m_vrow(_rBlocks,nullptr), m_vcol(_cBlocks,nullptr), m_fixedPattern(false),
+      m_slotsNnz(0), m_slotsSize(0), m_slotsMax(0), m_elFirst(0), m_elLast(std::numeric_limits<index_t>::max())
     { }
 
     // The copy constructor replicates the same environent but does
@@ -308,10 +328,16 @@ public:
      *
      * @param save_sparsety_pattern only modify values but keep sparsety
      * information by multiplying matrix by zero in-place
+     *
+     * \note If the option "freezePattern" is set, a pattern computed
+     * by computePattern() is kept, as long as the dimensions of the
+     * system do not change.
      */
     void clearMatrix(const bool& save_sparsety_pattern = true)
     {
-        if (m_matrix.nonZeros() && save_sparsety_pattern)
+        const bool frozen = m_fixedPattern && m_options.askSwitch("freezePattern", false)
+            && m_matrix.rows()==numTestDofs() && m_matrix.cols()==numDofs();
+        if (m_matrix.nonZeros() && (save_sparsety_pattern || frozen) )
         {
             std::fill(m_matrix.valuePtr(),
                       m_matrix.valuePtr() + m_matrix.nonZeros(), 0.);
@@ -319,9 +345,13 @@ public:
         else
         {
             m_matrix = gsSparseMatrix<T>(numTestDofs(), numDofs());
+            m_fixedPattern = false;
+            m_slots.clear();
 
             if (0 == m_matrix.rows() || 0 == m_matrix.cols())
                 gsWarn << " No internal DOFs, zero sized system.\n";
+            else if (m_options.askSwitch("fixedPattern", false))
+                computePattern();
             else {
                 // Pick up values from options
                 const T bdA = m_options.getReal("bdA");
@@ -340,6 +370,59 @@ public:
         }
     }
 
+    /**
+     * @brief Computes the sparsity pattern of the system matrix
+     *
+     * The couplings of all active test and trial functions on every
+     * integration element, and across the conforming interfaces of
+     * the integration elements, are inserted as explicit zeros, so
+     * that subsequent calls of assemble() and assembleIfc() only
+     * update values. In this case the OpenMP threads scatter into the
+     * matrix using atomic updates instead of a critical section.
+     *
+     * Entries already present in the matrix are kept.
+     *
+     * \note Called by initMatrix() if the option "fixedPattern" is
+     * set, and by the first assembly if the option "freezePattern" is
+     * set.
+     */
+    void computePattern();
+
+    /// Returns true if the matrix structure has been precomputed by
+    /// computePattern()
+    bool hasFixedPattern() const { return m_fixedPattern; }
+
+    /**
+     * @brief Restricts the assembly to the elements with numbers in
+     * [\a first, \a last)
+     *
+     * The elements are numbered patch by patch, i.e., the elements of
+     * patch \a p have the numbers from the sum of the numbers of
+     * elements of the patches before up to this sum plus the number of
+     * elements of patch \a p. Only these elements are visited by
+     * assemble(), apply(), assembleJacobian() and computePattern().
+     * The integrals on the sides of a patch (on the interfaces, with
+     * respect to their first patch) are assembled only if the first
+     * element of the patch is in the range; computePattern() then
+     * also includes the couplings on the sides of that patch.
+     *
+     * So, if the elements are split into consecutive ranges, every
+     * integral is assembled for exactly one range. This is used for
+     * the distributed assembly, see gsDistributedMatrixOp.
+     */
+    void setElementRange(const index_t first, const index_t last)
+    {
+        GISMO_ASSERT(0<=first && first<=last, "Invalid element range");
+        m_elFirst = first;
+        m_elLast  = last;
+        m_fixedPattern = false;
+        m_slots.clear();
+    }
+
+    /// Assemble on all elements again, see setElementRange()
+    void resetElementRange()
+    { setElementRange(0, std::numeric_limits<index_t>::max()); }
+
     /// \brief Initializes the right-hand side vector only
     void initVector(const index_t numRhs = 1)
     {
@@ -401,6 +484,20 @@ public:
     template<class expr> void assembleJacobianIfc(const ifContainer & iFaces,
                                                   const expr residual, solution  u);
 
+    /// \brief Computes \a y = K \a x element by element, where K is
+    /// the matrix of the bilinear form \a bf, without assembling K.
+    /// The columns of \a x are coefficient vectors of the free DoFs
+    /// of the trial space. Eliminated (Dirichlet) DoFs are ignored,
+    /// as in the assembled matrix.
+    template<class expr> void apply(const expr & bf, const gsMatrix<T> & x,
+                                    gsMatrix<T> & y);
+
+    /// \brief Returns a matrix-free linear operator applying the
+    /// bilinear form \a bf, see apply(). The operator refers to this
+    /// assembler, which must outlive it.
+    template<class expr> typename gsLinearOperator<T>::uPtr
+    matrixFreeOp(const expr & bf);
+
 private:
 
     void _blockDims(gsVector<index_t> & rowSizes,
@@ -430,6 +527,69 @@ private:
     /// Called internally by the init* functions
     void resetDimensions();
 
+    // A range of consecutive elements of a task (patch, boundary
+    // side or interface), the unit of work handed out to the threads
+    struct workItem
+    {
+        index_t task, first, size;
+    };
+
+    // Splits the elements of all tasks into ranges. \a numElements
+    // holds the number of elements of every task
+    void workList(const std::vector<index_t> & numElements,
+                  std::vector<workItem> & items) const
+    { workList(std::vector<index_t>(numElements.size(), 0), numElements, items); }
+
+    // Splits the elements [first[t],last[t]) of all tasks into ranges
+    void workList(const std::vector<index_t> & first,
+                  const std::vector<index_t> & last,
+                  std::vector<workItem> & items) const;
+
+    // Intersects the element range with the patches, \a elOffset holds
+    // the number of the first element of every patch (and the total)
+    void localElements(const std::vector<index_t> & elOffset,
+                       std::vector<index_t> & first,
+                       std::vector<index_t> & last) const
+    {
+        const size_t np = elOffset.size()-1;
+        first.resize(np);
+        last .resize(np);
+        for (size_t p = 0; p!=np; ++p)
+        {
+            const index_t n = elOffset[p+1]-elOffset[p];
+            first[p] = math::min(n, math::max(m_elFirst-elOffset[p], (index_t)0));
+            last [p] = math::max(first[p], math::min(n, m_elLast-elOffset[p]));
+        }
+    }
+
+    // True if the first element of patch \a p is in the element range,
+    // i.e. if the integrals on its sides are to be assembled
+    bool assemblesSidesOf(const index_t p) const
+    {
+        if (0==m_elFirst && std::numeric_limits<index_t>::max()==m_elLast)
+            return true;
+        const gsMultiBasis<T> & mb = m_exprdata->multiBasis();
+        index_t offset = 0;
+        for (index_t q = 0; q!=p; ++q)
+            offset += mb.basis(q).numElements();
+        return m_elFirst<=offset && offset<m_elLast;
+    }
+
+    // Moves the iterator \a domIt, which points to element number \a
+    // pos, forward to element number \a first
+    static void seekElement(gsDomainIterator<T> & domIt, index_t & pos,
+                            const index_t first)
+    {
+        GISMO_ASSERT(pos<=first, "Cannot move the iterator backwards");
+        if (first!=pos)
+            domIt.next(first-pos);
+        pos = first;
+    }
+
+    // Computes the pattern on the first assembly if the option
+    // "freezePattern" is set, and sizes the per-element slot maps
+    void prepareSlots(const size_t numElements);
+
     // Prints the expression to a text stream
     struct __printExpr
     {
@@ -461,6 +621,10 @@ private:
         gsMatrix<T>       & m_rhs;
         const gsVector<T> & m_quWeights;
         bool m_elim;
+        bool m_atomic;
+        std::vector<std::vector<std::vector<index_t> > > * m_slots;
+        size_t * m_slotsSize, m_slotsMax;
+        index_t m_ncol, m_elem;
         gsMatrix<T>         localMat;
         gsMatrix<T>         aux;
 
@@ -468,11 +632,42 @@ private:
               gsMatrix<T>       & _rhs,
               const gsVector<>  & _quWeights)
         : m_matrix(_matrix), m_rhs(_rhs),
-          m_quWeights(_quWeights), m_elim(true)
+          m_quWeights(_quWeights), m_elim(true), m_atomic(false),
+          m_slots(nullptr), m_slotsSize(nullptr), m_slotsMax(0), m_ncol(0), m_elem(-1)
         { }
 
+        /// Use (and fill) the cached positions \a slots of the local
+        /// entries in the matrix values, \a ncol is the number of
+        /// column spaces. At most \a max positions are stored, \a
+        /// size counts them.
+        void setSlots(std::vector<std::vector<std::vector<index_t> > > * slots,
+                      index_t ncol, size_t * size, size_t max)
+        {
+            m_slots = slots->empty() ? nullptr : slots; m_ncol = ncol;
+            m_slotsSize = size; m_slotsMax = max;
+        }
+
+        /// Sets the global number of the current element
+        void setElement(index_t elem) {m_elem = elem;}
+
         void setElim(bool elim) {m_elim = elim;}
 
+        /// Use atomic updates on the (precomputed) matrix structure
+        void setAtomic(bool atomic) {m_atomic = atomic;}
+
+        // Returns the value slot of the existing entry (ii,jj)
+        T & slot(const index_t ii, const index_t jj)
+        {
+            typedef gsSparseMatrix<T> SpMat;
+            const index_t o = SpMat::IsRowMajor ? ii : jj;
+            const index_t in = SpMat::IsRowMajor ? jj : ii;
+            const index_t * beg = m_matrix.innerIndexPtr() + m_matrix.outerIndexPtr()[o];
+            const index_t * end = m_matrix.innerIndexPtr() + m_matrix.outerIndexPtr()[o+1];
+            const index_t * pos = std::lower_bound(beg, end, in);
+            GISMO_ENSURE(pos!=end && *pos==in, "Entry ("<<ii<<","<<jj<<") is not in the sparsity pattern");
+            return m_matrix.valuePtr()[pos - m_matrix.innerIndexPtr()];
+        }
+
         template <typename E> void operator() (const gismo::expr::_expr<E> & ee)
         {
             // ------- Compute  -------
@@ -522,8 +717,6 @@ private:
                                                         u.space().data().patchId, c);
                     if (u.mapper().is_free_index(jj) )
                     {
-                        //todo: take local copy of local solution u
-
                         //Perturb \a u
                         u.perturbLocal( delta  , jj, u.space().data().patchId);
                         quadrature(ee, aux);
@@ -580,6 +773,31 @@ private:
                 //              "Invalid values for fixed part");
             }
 
+            // Cached value positions of the local entries (-1: unknown)
+            index_t * sl = nullptr;
+            if (isMatrix && m_atomic && nullptr!=m_slots && m_elem>=0)
+            {
+                std::vector<index_t> & es = (*m_slots)[v.id()*m_ncol+u.id()][m_elem];
+                const size_t ls = localMat.size();
+                if (es.size()!=ls)
+                {
+                    // Keep the maps within the budget, the remaining
+                    // elements search their positions
+                    size_t used;
+#                   pragma omp atomic capture
+                    used = *m_slotsSize += ls;
+                    if (used<=m_slotsMax)
+                        es.assign(ls, -1);
+                    else
+                    {
+#                       pragma omp atomic
+                        *m_slotsSize -= ls;
+                    }
+                }
+                if (es.size()==ls)
+                    sl = es.data();
+            }
+
             for (index_t r = 0; r != rd; ++r)
             {
                 const index_t rls = r * rowInd0.rows();     //local stride
@@ -598,22 +816,51 @@ private:
                                 {
                                     if ( 0 == localMat(rls+i,cls+j) ) continue;
 
+                                    index_t * sp = sl ? sl + (rls+i)*localMat.cols()+cls+j : nullptr;
+                                    if (sp && *sp>=0)
+                                    {
+                                        T & a = m_matrix.valuePtr()[*sp];
+#                                       pragma omp atomic
+                                        a += localMat(rls+i,cls+j);
+                                        continue;
+                                    }
+
                                     const index_t jj = colMap.index(colInd0.at(j),u.data().patchId,c); // N_j
                                     if ( colMap.is_free_index(jj) )
                                     {
                                         // If matrix is symmetric, we could
                                         // store only lower triangular part
                                         //if ( (!symm) || jj <= ii )
-#                                       pragma omp critical (acc_m_matrix)
-                                        m_matrix.coeffRef(ii, jj) += localMat(rls+i,cls+j);
+                                        if (m_atomic)
+                                        {
+                                            T & a = slot(ii, jj);
+                                            if (sp) *sp = &a - m_matrix.valuePtr();
+#                                           pragma omp atomic
+                                            a += localMat(rls+i,cls+j);
+                                        }
+                                        else
+                                        {
+#                                           pragma omp critical (acc_m_matrix)
+                                            m_matrix.coeffRef(ii, jj) += localMat(rls+i,cls+j);
+                                        }
                                     }
                                     else if (elim) // colMap.is_boundary_index(jj) )
                                     {
                                         // Symmetric treatment of eliminated BCs
                                         // GISMO_ASSERT(1==m_rhs.cols(), "-");
-#                                       pragma omp critical (acc_m_rhs)
-                                        m_rhs.at(ii) -= localMat(rls+i,cls+j) *
+                                        const T val = localMat(rls+i,cls+j) *
                                             fixedDofs.at(colMap.global_to_bindex(jj));
+                                        T & b = m_rhs.at(ii);
+                                        if (m_atomic)
+                                        {
+#                                           pragma omp atomic
+                                            b -= val;
+                                        }
+                                        else
+                                        {
+#                                           pragma omp critical (acc_m_rhs)
+                                            b -= val;
+                                        }
                                     }
                                 }
                             }
@@ -621,8 +868,20 @@ private:
                         else
                         {
                             //The right-hand side can have more than one columns
-#                           pragma omp critical (acc_m_rhs)
-                            m_rhs.row(ii) += localMat.row(rls+i);
+                            if (m_atomic)
+                            {
+                                for (index_t c = 0; c != m_rhs.cols(); ++c)
+                                {
+                                    T & b = m_rhs(ii,c);
+#                                   pragma omp atomic
+                                    b += localMat(rls+i,c);
+                                }
+                            }
+                            else
+                            {
+#                               pragma omp critical (acc_m_rhs)
+                                m_rhs.row(ii) += localMat.row(rls+i);
+                            }
                         }
                     }
                 }
@@ -631,8 +890,118 @@ private:
 
     };
 
+    // Evaluates a bilinear form on the element and adds its product
+    // with the free coefficients in m_x to m_y
+    struct _matVec
+    {
+        const gsMatrix<T> & m_x;
+        gsMatrix<T>       & m_y;
+        const gsVector<T> & m_quWeights;
+        gsMatrix<T>         localMat, localX, localY;
+
+        _matVec(const gsMatrix<T> & _x, gsMatrix<T> & _y,
+                const gsVector<T> & _quWeights)
+        : m_x(_x), m_y(_y), m_quWeights(_quWeights)
+        { }
+
+        template <typename E> void operator() (const gismo::expr::_expr<E> & ee)
+        {
+            GISMO_ASSERT(E::isMatrix(), "Expecting a bilinear form.");
+            const expr::gsFeSpace<T> & v = ee.rowVar();
+            const expr::gsFeSpace<T> & u = ee.colVar();
+
+            const T * w = m_quWeights.data();
+            localMat.noalias() = (*w) * ee.eval(0);
+            for (index_t k = 1; k != m_quWeights.rows(); ++k)
+                localMat.noalias() += (*(++w)) * ee.eval(k);
+
+            // Gather the local coefficients
+            const gsDofMapper & colMap = u.mapper();
+            const gsMatrix<index_t> & colInd = u.data().actives;
+            localX.resize(localMat.cols(), m_x.cols());
+            for (index_t c = 0; c != u.dim(); ++c)
+            {
+                const index_t cls = c * colInd.rows();     //local stride
+                for (index_t j = 0; j != colInd.rows(); ++j)
+                {
+                    const index_t jj = colMap.index(colInd.at(j),u.data().patchId,c);
+                    if ( colMap.is_free_index(jj) )
+                        localX.row(cls+j) = m_x.row(jj);
+                    else
+                        localX.row(cls+j).setZero();
+                }
+            }
+
+            localY.noalias() = localMat * localX;
+
+            // Scatter the local product
+            const gsDofMapper & rowMap = v.mapper();
+            const gsMatrix<index_t> & rowInd = v.data().actives;
+            for (index_t r = 0; r != v.dim(); ++r)
+            {
+                const index_t rls = r * rowInd.rows();     //local stride
+                for (index_t i = 0; i != rowInd.rows(); ++i)
+                {
+                    const index_t ii = rowMap.index(rowInd.at(i),v.data().patchId,r);
+                    if ( rowMap.is_free_index(ii) )
+                        for (index_t c = 0; c != m_y.cols(); ++c)
+                        {
+                            T & b = m_y(ii,c);
+#                           pragma omp atomic
+                            b += localY(rls+i,c);
+                        }
+                }
+            }
+        }
+
+        void operator() (const expr::_expr<expr::gsNullExpr<T> > &) {}
+    };
+
 }; // gsExprAssembler
 
+/**
+   @brief Linear operator applying a bilinear form of a
+   gsExprAssembler element by element, without storing its matrix
+
+   Created by gsExprAssembler::matrixFreeOp(). The operator can be
+   used wherever a gsLinearOperator is expected, e.g. in
+   gsConjugateGradient, gsGMRes or as a level operator of the
+   matrix-free gsMultiGridOp.
+
+   \ingroup Assembler
+*/
+template<class T, class E>
+class gsExprMatrixFreeOp GISMO_FINAL : public gsLinearOperator<T>
+{
+public:
+
+    /// Shared pointer for gsExprMatrixFreeOp
+    typedef memory::shared_ptr<gsExprMatrixFreeOp> Ptr;
+
+    /// Unique pointer for gsExprMatrixFreeOp
+    typedef memory::unique_ptr<gsExprMatrixFreeOp> uPtr;
+
+    /// Constructor taking the assembler and the bilinear form \a bf
+    gsExprMatrixFreeOp(gsExprAssembler<T> & assembler, const E & bf)
+    : m_assembler(&assembler), m_bf(bf)
+    { }
+
+    /// Make function returning a smart pointer
+    static uPtr make(gsExprAssembler<T> & assembler, const E & bf)
+    { return uPtr( new gsExprMatrixFreeOp(assembler, bf) ); }
+
+    void apply(const gsMatrix<T> & input, gsMatrix<T> & x) const
+    { m_assembler->apply(m_bf, input, x); }
+
+    index_t rows() const {return m_assembler->numTestDofs();}
+
+    index_t cols() const {return m_assembler->numDofs();}
+
+private:
+    gsExprAssembler<T> * m_assembler;
+    E m_bf;
+};
+
 template<class T>
 gsOptionList gsExprAssembler<T>::defaultOptions()
 {
@@ -648,6 +1017,11 @@ gsOptionList gsExprAssembler<T>::defaultOptions()
     opt.addSwitch("overInt", "Apply over-integration on boundary elements or not?", false);
     opt.addSwitch("flipSide", "Flip side of interface where integration is performed.", false);
     opt.addSwitch("movingInterface", "Used in interface assembly when interface is not stationary.", false);
+    opt.addSwitch("fixedPattern", "Precompute the sparsity pattern in initMatrix() and assemble lock-free into it", false);
+    opt.addSwitch("freezePattern", "Compute the sparsity pattern at the first assembly, keep it and reuse per-element maps to its values in later assemblies", false);
+    opt.addInt ("chunkSize", "Number of elements per work item of the parallel scheduler (0: automatic)", 0);
+    opt.addInt ("slotsBudget", "Memory budget in MB for the per-element maps to the values of a frozen pattern (see freezePattern)", 256);
+    opt.addInt ("cacheBudget", "Memory budget in MB for keeping basis evaluations of the elements across assemblies (0: no cache)", 0);
     return opt;
 
     /// dirichlet treatment? elimination ????
@@ -739,6 +1113,231 @@ template<class T> void gsExprAssembler<T>::resetDimensions()
     }
 }
 
+template<class T> void gsExprAssembler<T>::computePattern()
+{
+    GISMO_ASSERT( m_vcol.back()->mapper.isFinalized(),
+                  "initSystem() has not been called.");
+    const gsMultiBasis<T> & mb = m_exprdata->multiBasis();
+    const bool rowMajor = gsSparseMatrix<T>::IsRowMajor;
+    const index_t nOuter = rowMajor ? numTestDofs() : numDofs();
+
+    // For every outer index, the sorted list of coupled inner indices
+    std::vector<std::vector<index_t> > pattern(nOuter);
+
+    typename gsQuadRule<T>::uPtr QuRule;
+    gsMatrix<T> points;
+    gsVector<T> quWeights;
+    gsMatrix<index_t> act;
+    std::vector<index_t> rows, cols;
+
+    // Appends the free global indices of all functions of the
+    // spaces  vs that are active on the points  pts  of patch  patchInd
+    const auto globalActives = [&](const std::vector<gsFeSpaceData<T>*> & vs,
+                                   const index_t patchInd, const gsMatrix<T> & pts,
+                                   std::vector<index_t> & glob)
+    {
+        for (size_t s = 0; s!=vs.size(); ++s)
+        {
+            vs[s]->fs->piece(patchInd).active_into(pts, act);
+            std::sort(act.data(), act.data()+act.size());
+            const index_t na = std::unique(act.data(), act.data()+act.size())-act.data();
+            for (index_t c = 0; c != vs[s]->dim; ++c)
+                for (index_t i = 0; i != na; ++i)
+                {
+                    const index_t ii = vs[s]->mapper.index(act.at(i),patchInd,c);
+                    if ( vs[s]->mapper.is_free_index(ii) )
+                        glob.push_back(ii);
+                }
+        }
+    };
+
+    std::vector<index_t> elOffset(mb.nBases()+1, 0), firstEl, lastEl;
+    for (size_t p = 0; p!=mb.nBases(); ++p)
+        elOffset[p+1] = elOffset[p] + mb.basis(p).numElements();
+    localElements(elOffset, firstEl, lastEl);
+
+    // Merges the couplings of the functions active on the points
+    // pts1 of patch1 and, if patch2 is not negative, on the points
+    // pts2 of patch2
+    const auto addCouplings = [&](const index_t patch1, const gsMatrix<T> & pts1,
+                                  const index_t patch2, const gsMatrix<T> & pts2)
+    {
+        rows.clear();
+        cols.clear();
+        globalActives(m_vrow, patch1, pts1, rows);
+        globalActives(m_vcol, patch1, pts1, cols);
+        if (patch2 >= 0)
+        {
+            globalActives(m_vrow, patch2, pts2, rows);
+            globalActives(m_vcol, patch2, pts2, cols);
+        }
+        std::sort(rows.begin(), rows.end());
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+        std::sort(cols.begin(), cols.end());
+        cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+
+        const std::vector<index_t> & outer = rowMajor ? rows : cols;
+        const std::vector<index_t> & inner = rowMajor ? cols : rows;
+        for (typename std::vector<index_t>::const_iterator
+                 it = outer.begin(); it!=outer.end(); ++it)
+        {
+            std::vector<index_t> & pt = pattern[*it];
+            const size_t sz = pt.size();
+            pt.insert(pt.end(), inner.begin(), inner.end());
+            std::inplace_merge(pt.begin(), pt.begin()+sz, pt.end());
+            pt.erase(std::unique(pt.begin(), pt.end()), pt.end());
+        }
+    };
+
+    for (size_t patchInd = 0; patchInd < mb.nBases(); ++patchInd)
+    {
+        if (firstEl[patchInd]==lastEl[patchInd]) continue;
+        QuRule = gsQuadrature::getPtr(mb.basis(patchInd), m_options);
+        typename gsBasis<T>::domainIter domIt = mb.basis(patchInd).makeDomainIterator();
+        if (0!=firstEl[patchInd])
+            domIt->next(firstEl[patchInd]);
+        for (index_t e = firstEl[patchInd]; e!=lastEl[patchInd] && domIt->good(); ++e, domIt->next() )
+        {
+            QuRule->mapTo( domIt->lowerCorner(), domIt->upperCorner(),
+                           points, quWeights);
+            if (0==points.cols()) continue;
+            addCouplings(patchInd, points, -1, points);
+        }
+    }
+
+    // The integrals on the sides of a patch are assembled by the
+    // range holding its first element (see assemblesSidesOf), which
+    // need not contain the volume elements adjacent to these sides
+    const bool partial = 0!=m_elFirst || std::numeric_limits<index_t>::max()!=m_elLast;
+    for (size_t patchInd = 0; partial && patchInd < mb.nBases(); ++patchInd)
+    {
+        if (!assemblesSidesOf(patchInd)) continue;
+        const short_t d = mb.basis(patchInd).domainDim();
+        for (boxSide s = boxSide::getFirst(d); s<boxSide::getEnd(d); ++s)
+        {
+            QuRule = gsQuadrature::getPtr(mb.basis(patchInd), m_options, s.direction());
+            typename gsBasis<T>::domainIter domIt = mb.basis(patchInd).makeDomainIterator(s);
+            for (; domIt->good(); domIt->next() )
+            {
+                QuRule->mapTo( domIt->lowerCorner(), domIt->upperCorner(),
+                               points, quWeights);
+                if (0==points.cols()) continue;
+                addCouplings(patchInd, points, -1, points);
+            }
+        }
+    }
+
+    // The couplings across the conforming interfaces of the domain,
+    // as assembled by assembleIfc(), with either side first
+    gsMatrix<T> pointsIfc;
+    const ifContainer & iFaces = mb.topology().interfaces();
+    for (size_t f = 0; f!=iFaces.size(); ++f)
+    {
+        const boundaryInterface & iFace = iFaces[f];
+        const index_t patch1 = iFace.first() .patch;
+        const index_t patch2 = iFace.second().patch;
+        if (iFace.type() != interaction::conforming ||
+            (!assemblesSidesOf(patch1) && !assemblesSidesOf(patch2)) )
+            continue;
+        typename gsFunction<T>::uPtr interfaceMap =
+            gsAffineFunction<T>::make( iFace.dirMap(), iFace.dirOrientation(),
+                                       mb.basis(patch1).support(),
+                                       mb.basis(patch2).support() );
+        QuRule = gsQuadrature::getPtr(mb.basis(patch1), m_options,
+                                      iFace.first().side().direction());
+        typename gsBasis<T>::domainIter domIt =
+            mb.basis(patch1).makeDomainIterator(iFace.first().side());
+        for (; domIt->good(); domIt->next() )
+        {
+            QuRule->mapTo( domIt->lowerCorner(), domIt->upperCorner(),
+                           points, quWeights);
+            if (0==points.cols()) continue;
+            interfaceMap->eval_into(points, pointsIfc);
+            addCouplings(patch1, points, patch2, pointsIfc);
+        }
+    }
+
+    gsVector<index_t> nnz(nOuter);
+    for (index_t o = 0; o != nOuter; ++o)
+        nnz[o] = pattern[o].size();
+
+    gsSparseMatrix<T> pat(numTestDofs(), numDofs());
+    pat.reserve(nnz);
+    for (index_t o = 0; o != nOuter; ++o)
+    {
+        for (typename std::vector<index_t>::const_iterator
+                 it = pattern[o].begin(); it!=pattern[o].end(); ++it)
+            pat.insert(rowMajor ? o : *it, rowMajor ? *it : o) = 0;
+        std::vector<index_t>().swap(pattern[o]);
+    }
+
+    // Keep the entries assembled so far
+    if (0!=m_matrix.nonZeros() && m_matrix.rows()==pat.rows() && m_matrix.cols()==pat.cols())
+        pat += m_matrix;
+    m_matrix.swap(pat);
+    m_matrix.makeCompressed();
+    m_fixedPattern = true;
+    m_slots.clear();
+}
+
+template<class T> void gsExprAssembler<T>::prepareSlots(const size_t numElements)
+{
+    if (!m_options.askSwitch("freezePattern", false))
+    {
+        m_slots.clear();
+        return;
+    }
+
+    if (!m_fixedPattern && 0!=m_matrix.rows() && 0!=m_matrix.cols())
+        computePattern();
+
+    // The positions are invalid once entries have been inserted
+    const size_t np = m_vrow.size() * m_vcol.size();
+    if (m_slotsNnz!=m_matrix.nonZeros() || m_slots.size()!=np)
+    {
+        m_slots.clear();
+        m_slots.resize(np);
+        m_slotsNnz = m_matrix.nonZeros();
+    }
+    m_slotsSize = 0;
+    for (size_t i = 0; i!=np; ++i)
+    {
+        if (m_slots[i].size()!=numElements)
+        {
+            m_slots[i].clear();
+            m_slots[i].resize(numElements);
+        }
+        for (size_t e = 0; e!=numElements; ++e)
+            m_slotsSize += m_slots[i][e].size();
+    }
+    m_slotsMax = m_options.askInt("slotsBudget", 256) * (size_t)(1<<20) / sizeof(index_t);
+}
+
+template<class T>
+void gsExprAssembler<T>::workList(const std::vector<index_t> & first,
+                                  const std::vector<index_t> & last,
+                                  std::vector<workItem> & items) const
+{
+    items.clear();
+    index_t chunk = m_options.askInt("chunkSize", 0);
+    if (chunk<=0)
+    {
+        // Aim at several work items per thread, to balance the
+        // load among patches of different size
+        const index_t total =
+            std::accumulate(last.begin(), last.end(), (index_t)0) -
+            std::accumulate(first.begin(), first.end(), (index_t)0);
+        chunk = std::max((index_t)1, total / (8*omp_get_max_threads()) );
+    }
+
+    for (size_t t = 0; t!=last.size(); ++t)
+        for (index_t f = first[t]; f < last[t]; f += chunk)
+        {
+            const workItem wi = {(index_t)t, f, std::min(chunk, last[t]-f)};
+            items.push_back(wi);
+        }
+}
+
 template<size_t I, class op, typename... Ts>
 void op_tuple_impl (op & _op, const std::tuple<Ts...> &tuple)
 {
@@ -757,43 +1356,65 @@ void gsExprAssembler<T>::assemble(const expr &... args)
 {
     GISMO_ASSERT(matrix().cols()==numDofs(), "System not initialized, matrix().cols() = "<<matrix().cols()<<"!="<<numDofs()<<" = numDofs()");
 
+    const gsMultiBasis<T> & mb = m_exprdata->multiBasis();
+
+    // Global list of element ranges, handed out dynamically
+    std::vector<index_t> numElements(mb.nBases()), elOffset(mb.nBases()+1, 0);
+    for (size_t p = 0; p!=mb.nBases(); ++p)
+    {
+        numElements[p] = mb.basis(p).numElements();
+        elOffset[p+1] = elOffset[p] + numElements[p];
+    }
+    std::vector<index_t> firstEl, lastEl;
+    localElements(elOffset, firstEl, lastEl);
+    std::vector<workItem> work;
+    workList(firstEl, lastEl, work);
+    prepareSlots(elOffset.back());
+    const size_t cacheBudget = m_options.askInt("cacheBudget", 0) * (size_t)(1<<20);
+
     bool failed = false;
 #pragma omp parallel shared(failed)
 {
-#   ifdef _OPENMP
-    const int tid = omp_get_thread_num();
-    const int nt  = omp_get_num_threads();
-#   endif
     auto arg_tpl = std::make_tuple(args...);
 
     m_exprdata->parse(arg_tpl);
     m_exprdata->activateFlags(SAME_ELEMENT);
+    m_exprdata->initCache(elOffset.back(), cacheBudget);
     //op_tuple(__printExpr(), arg_tpl);
 
     typename gsQuadRule<T>::uPtr QuRule; // Quadrature rule
+    typename gsBasis<T>::domainIter domIt;
+    index_t patchInd = -1, pos = 0;
 
     gsVector<T> quWeights; // quadrature weights
     _eval ee(m_matrix, m_rhs, quWeights);
     const index_t elim = m_options.getInt("DirichletStrategy");
     ee.setElim(dirichlet::elimination==elim);
+    ee.setAtomic(m_fixedPattern && m_matrix.isCompressed());
+    ee.setSlots(&m_slots, m_vcol.size(), &m_slotsSize, m_slotsMax);
 
-    // Note: omp thread will loop over all patches and will work on Ep/nt
-    // elements, where Ep is the elements on the patch.
-    for (unsigned patchInd = 0; patchInd < m_exprdata->multiBasis().nBases() && (!failed); ++patchInd) //todo: distribute in parallel somehow?
+    // Note: the threads take element ranges of any patch from the
+    // work list, the iterator is kept as long as the patch is the same
+#   pragma omp for schedule(dynamic,1)
+    for (size_t w = 0; w < work.size(); ++w)
     {
-        QuRule = gsQuadrature::getPtr(m_exprdata->multiBasis().basis(patchInd), m_options);
+        if (failed) continue;
+        const workItem & wi = work[w];
 
-        // Initialize domain element iterator for current patch
-        typename gsBasis<T>::domainIter domIt =  // add patchInd to domainiter ?
-            m_exprdata->multiBasis().basis(patchInd).makeDomainIterator();
-        m_exprdata->getElement().set(*domIt,quWeights);
+        if (wi.task!=patchInd || wi.first<pos)
+        {
+            if (wi.task!=patchInd)
+                QuRule = gsQuadrature::getPtr(mb.basis(wi.task), m_options);
+            patchInd = wi.task;
+            // Initialize domain element iterator for current patch
+            domIt = mb.basis(patchInd).makeDomainIterator();
+            m_exprdata->getElement().set(*domIt,quWeights);
+            pos = 0;
+        }
+        seekElement(*domIt, pos, wi.first);
 
-        // Start iteration over elements of patchInd
-#       ifdef _OPENMP
-        for ( domIt->next(tid); domIt->good() && (!failed); domIt->next(nt) )
-#       else
-        for (; domIt->good(); domIt->next() )
-#       endif
+        // Start iteration over the elements of the range
+        for (index_t e = 0; e!=wi.size && domIt->good(); ++e, ++pos, domIt->next() )
         {
             // Map the Quadrature rule to the element
             QuRule->mapTo( domIt->lowerCorner(), domIt->upperCorner(),
@@ -807,8 +1428,7 @@ void gsExprAssembler<T>::assemble(const expr &... args)
             // Perform required pre-computations on the quadrature nodes
             try
             {
-            m_exprdata->precompute(patchInd);
-            //m_exprdata->precompute(patchInd, QuRule, *domIt); // todo
+            m_exprdata->precomputeElement(patchInd, elOffset[patchInd] + pos);
             }
             catch (...)
             {
@@ -818,11 +1438,11 @@ void gsExprAssembler<T>::assemble(const expr &... args)
                 break;
             }
 #else
-            m_exprdata->precompute(patchInd);
+            m_exprdata->precomputeElement(patchInd, elOffset[patchInd] + pos);
 #endif
 
-
             // Assemble contributions of the element
+            ee.setElement(elOffset[patchInd] + pos);
             op_tuple(ee, arg_tpl);
         }
     }
@@ -832,6 +1452,100 @@ void gsExprAssembler<T>::assemble(const expr &... args)
     m_matrix.makeCompressed();
 }
 
+template<class T>
+template<class expr>
+void gsExprAssembler<T>::apply(const expr & bf, const gsMatrix<T> & x,
+                               gsMatrix<T> & y)
+{
+    GISMO_ASSERT(x.rows()==numDofs(), "Invalid size of the coefficients: "
+                 << x.rows() <<"!="<< numDofs() );
+    y.setZero(numTestDofs(), x.cols());
+
+    const gsMultiBasis<T> & mb = m_exprdata->multiBasis();
+
+    std::vector<index_t> numElements(mb.nBases()), elOffset(mb.nBases()+1, 0);
+    for (size_t p = 0; p!=mb.nBases(); ++p)
+    {
+        numElements[p] = mb.basis(p).numElements();
+        elOffset[p+1] = elOffset[p] + numElements[p];
+    }
+    std::vector<index_t> firstEl, lastEl;
+    localElements(elOffset, firstEl, lastEl);
+    std::vector<workItem> work;
+    workList(firstEl, lastEl, work);
+    const size_t cacheBudget = m_options.askInt("cacheBudget", 0) * (size_t)(1<<20);
+
+    bool failed = false;
+#pragma omp parallel shared(failed)
+{
+    auto arg_tpl = std::make_tuple(bf);
+
+    m_exprdata->parse(arg_tpl);
+    m_exprdata->activateFlags(SAME_ELEMENT);
+    m_exprdata->initCache(elOffset.back(), cacheBudget);
+
+    typename gsQuadRule<T>::uPtr QuRule; // Quadrature rule
+    typename gsBasis<T>::domainIter domIt;
+    index_t patchInd = -1, pos = 0;
+
+    gsVector<T> quWeights; // quadrature weights
+    _matVec mv(x, y, quWeights);
+
+#   pragma omp for schedule(dynamic,1)
+    for (size_t w = 0; w < work.size(); ++w)
+    {
+        if (failed) continue;
+        const workItem & wi = work[w];
+
+        if (wi.task!=patchInd || wi.first<pos)
+        {
+            if (wi.task!=patchInd)
+                QuRule = gsQuadrature::getPtr(mb.basis(wi.task), m_options);
+            patchInd = wi.task;
+            domIt = mb.basis(patchInd).makeDomainIterator();
+            m_exprdata->getElement().set(*domIt,quWeights);
+            pos = 0;
+        }
+        seekElement(*domIt, pos, wi.first);
+
+        for (index_t e = 0; e!=wi.size && domIt->good(); ++e, ++pos, domIt->next() )
+        {
+            QuRule->mapTo( domIt->lowerCorner(), domIt->upperCorner(),
+                           m_exprdata->points(), quWeights);
+
+            if (m_exprdata->points().cols()==0)
+                continue;
+
+#ifdef NDEBUG
+            try
+            {
+            m_exprdata->precomputeElement(patchInd, elOffset[patchInd] + pos);
+            }
+            catch (...)
+            {
+                #pragma omp atomic write
+                failed = true;
+                break;
+            }
+#else
+            m_exprdata->precomputeElement(patchInd, elOffset[patchInd] + pos);
+#endif
+
+            op_tuple(mv, arg_tpl);
+        }
+    }
+}//omp parallel
+    GISMO_ENSURE(!failed,"Operator application failed due to an error");
+}
+
+template<class T>
+template<class expr>
+typename gsLinearOperator<T>::uPtr
+gsExprAssembler<T>::matrixFreeOp(const expr & bf)
+{
+    return gsExprMatrixFreeOp<T,expr>::make(*this, bf);
+}
+
 template<class T>
 template<class... expr>
 void gsExprAssembler<T>::assembleBdr(const bcRefList & BCs, expr&... args)
@@ -839,40 +1553,58 @@ void gsExprAssembler<T>::assembleBdr(const bcRefList & BCs, expr&... args)
     GISMO_ASSERT(matrix().cols()==numDofs(), "System not initialized");
 
     if ( BCs.empty() || 0==numDofs() ) return;
-    m_exprdata->setMutSource(*BCs.front().get().function()); //initialize once
-
-// #pragma omp parallel
-// {
-// #   ifdef _OPENMP
-//     const int tid = omp_get_thread_num();
-//     const int nt  = omp_get_num_threads();
-// #   endif
+
+    const gsMultiBasis<T> & mb = m_exprdata->multiBasis();
+
+    std::vector<const boundary_condition<T>*> bcs;
+    std::vector<index_t> numElements;
+    for (typename bcRefList::const_iterator iit = BCs.begin(); iit!= BCs.end(); ++iit)
+    {
+        bcs.push_back(&iit->get());
+        numElements.push_back(assemblesSidesOf(bcs.back()->patch()) ?
+                              mb.basis(bcs.back()->patch()).numElements(bcs.back()->side()) : 0);
+    }
+    std::vector<workItem> work;
+    workList(numElements, work);
+
+#pragma omp parallel
+{
+    m_exprdata->setMutSource(*bcs.front()->function()); //initialize once
     auto arg_tpl = std::make_tuple(args...);
     m_exprdata->parse(arg_tpl);
     m_exprdata->activateFlags(SAME_ELEMENT);
 
     typename gsQuadRule<T>::uPtr QuRule; // Quadrature rule
+    typename gsBasis<T>::domainIter domIt;
+    index_t task = -1, pos = 0;
     gsVector<T> quWeights;               // quadrature weights
 
     _eval ee(m_matrix, m_rhs, quWeights);
+    ee.setAtomic(m_fixedPattern && m_matrix.isCompressed());
 
-//#   pragma omp parallel for
-    for (typename bcRefList::const_iterator iit = BCs.begin(); iit!= BCs.end(); ++iit)
+#   pragma omp for schedule(dynamic,1)
+    for (size_t w = 0; w < work.size(); ++w)
     {
-        const boundary_condition<T> * it = &iit->get();
-
-        QuRule = gsQuadrature::getPtr(m_exprdata->multiBasis().basis(it->patch()), m_options, it->side().direction());
+        const workItem & wi = work[w];
+        const boundary_condition<T> * it = bcs[wi.task];
 
-        // Update boundary function source
-        m_exprdata->setMutSource(*it->function());
-
-        typename gsBasis<T>::domainIter domIt =
-            m_exprdata->multiBasis().basis(it->patch()).
-            makeDomainIterator(it->side());
-        m_exprdata->getElement().set(*domIt,quWeights);
+        if (wi.task!=task || wi.first<pos)
+        {
+            if (wi.task!=task)
+            {
+                QuRule = gsQuadrature::getPtr(mb.basis(it->patch()), m_options, it->side().direction());
+                // Update boundary function source
+                m_exprdata->setMutSource(*it->function());
+            }
+            task = wi.task;
+            domIt = mb.basis(it->patch()).makeDomainIterator(it->side());
+            m_exprdata->getElement().set(*domIt,quWeights);
+            pos = 0;
+        }
+        seekElement(*domIt, pos, wi.first);
 
-        // Start iteration over elements
-        for (; domIt->good(); domIt->next() )
+        // Start iteration over the elements of the range
+        for (index_t e = 0; e!=wi.size && domIt->good(); ++e, ++pos, domIt->next() )
         {
             // Map the Quadrature rule to the element
             QuRule->mapTo( domIt->lowerCorner(), domIt->upperCorner(),
@@ -889,7 +1621,7 @@ void gsExprAssembler<T>::assembleBdr(const bcRefList & BCs, expr&... args)
         }
     }
 
-//}//omp parallel
+}//omp parallel
 
     m_matrix.makeCompressed();
 }
@@ -903,29 +1635,48 @@ void gsExprAssembler<T>::assembleBdr(const bContainer & bnd, expr&... args)
 
     if ( bnd.size()==0 || 0==numDofs() ) return;
 
+    const gsMultiBasis<T> & mb = m_exprdata->multiBasis();
+
+    std::vector<index_t> numElements(bnd.size());
+    for (size_t b = 0; b!=bnd.size(); ++b)
+        numElements[b] = assemblesSidesOf(bnd[b].patch) ?
+            mb.basis(bnd[b].patch).numElements(bnd[b].side()) : 0;
+    std::vector<workItem> work;
+    workList(numElements, work);
+
+#pragma omp parallel
+{
     auto arg_tpl = std::make_tuple(args...);
     m_exprdata->parse(arg_tpl);
 
-    typename gsQuadRule<T>::uPtr QuRule; // Quadrature rule  ---->OUT
+    typename gsQuadRule<T>::uPtr QuRule; // Quadrature rule
+    typename gsBasis<T>::domainIter domIt;
+    index_t task = -1, pos = 0;
     gsVector<T> quWeights;               // quadrature weights
 
     _eval ee(m_matrix, m_rhs, quWeights);
+    ee.setAtomic(m_fixedPattern && m_matrix.isCompressed());
 
-//#   pragma omp parallel for
-
-    for (gsBoxTopology::const_biterator it = bnd.begin();
-         it != bnd.end(); ++it )
+#   pragma omp for schedule(dynamic,1)
+    for (size_t w = 0; w < work.size(); ++w)
     {
-        QuRule = gsQuadrature::getPtr(m_exprdata->multiBasis().basis(it->patch),
-                                    m_options, it->side().direction());
+        const workItem & wi = work[w];
+        const patchSide & it = bnd[wi.task];
 
-        typename gsBasis<T>::domainIter domIt =
-            m_exprdata->multiBasis().basis(it->patch).
-            makeDomainIterator(it->side());
-        m_exprdata->getElement().set(*domIt,quWeights);
+        if (wi.task!=task || wi.first<pos)
+        {
+            if (wi.task!=task)
+                QuRule = gsQuadrature::getPtr(mb.basis(it.patch),
+                                              m_options, it.side().direction());
+            task = wi.task;
+            domIt = mb.basis(it.patch).makeDomainIterator(it.side());
+            m_exprdata->getElement().set(*domIt,quWeights);
+            pos = 0;
+        }
+        seekElement(*domIt, pos, wi.first);
 
-        // Start iteration over elements
-        for (; domIt->good(); domIt->next() )
+        // Start iteration over the elements of the range
+        for (index_t e = 0; e!=wi.size && domIt->good(); ++e, ++pos, domIt->next() )
         {
             // Map the Quadrature rule to the element
             QuRule->mapTo( domIt->lowerCorner(), domIt->upperCorner(),
@@ -935,14 +1686,14 @@ void gsExprAssembler<T>::assembleBdr(const bContainer & bnd, expr&... args)
                 continue;
 
             // Perform required pre-computations on the quadrature nodes
-            m_exprdata->precompute(it->patch, it->side());
+            m_exprdata->precompute(it.patch, it.side());
 
             // Assemble contributions of the element
             op_tuple(ee, arg_tpl);
         }
     }
 
-//}//omp parallel
+}//omp parallel
 
     m_matrix.makeCompressed();
 }
@@ -952,49 +1703,83 @@ void gsExprAssembler<T>::assembleIfc(const ifContainer & iFaces, expr... args)
 {
     GISMO_ASSERT(matrix().cols()==numDofs(), "System not initialized");
 
-// #pragma omp parallel
-// {
     typedef typename gsFunction<T>::uPtr ifacemap;
 
+    const gsMultiBasis<T> & mb = m_exprdata->multiBasis();
+    const bool flipSide = m_options.askSwitch("flipSide", false);
+
+    std::vector<index_t> numElements(iFaces.size());
+    for (size_t f = 0; f!=iFaces.size(); ++f)
+    {
+        const boundaryInterface & iFace = flipSide ? iFaces[f].getInverse() : iFaces[f];
+        numElements[f] = assemblesSidesOf(iFace.first().patch) ?
+            mb.basis(iFace.first().patch).numElements(iFace.first().side()) : 0;
+    }
+    std::vector<workItem> work;
+    workList(numElements, work);
+
+    // Create the helper of the opposite side before the threads
+    // parse the expressions
+    m_exprdata->pointsIfc();
+
+    // The precomputed pattern holds the couplings across the
+    // conforming interfaces of the integration elements only
+    bool atomic = m_fixedPattern && m_matrix.isCompressed();
+    boundaryInterface known;
+    for (size_t f = 0; atomic && f!=iFaces.size(); ++f)
+        atomic = iFaces[f].type() == interaction::conforming &&
+            mb.topology().getInterface(iFaces[f].first(), known) &&
+            (known.first() == iFaces[f].second() || known.second() == iFaces[f].second());
+
+#pragma omp parallel
+{
     auto arg_tpl = std::make_tuple(args...);
 
     m_exprdata->parse(arg_tpl);
     m_exprdata->activateFlags(SAME_ELEMENT); //note: SAME_ELEMENT is 0 at the opposite/mirrored patch
 
     typename gsQuadRule<T>::uPtr QuRule;
+    typename gsBasis<T>::domainIter domIt;
+    index_t task = -1, pos = 0;
     gsVector<T> quWeights;// quadrature weights
     _eval ee(m_matrix, m_rhs, quWeights);
-
-    const bool flipSide = m_options.askSwitch("flipSide", false);
+    ee.setAtomic(atomic);
 
     ifacemap interfaceMap;
-// #   pragma omp for
-    for (gsBoxTopology::const_iiterator it = iFaces.begin();
-         it != iFaces.end(); ++it )
+#   pragma omp for schedule(dynamic,1)
+    for (size_t w = 0; w < work.size(); ++w)
     {
+        const workItem & wi = work[w];
+
         // If flipSide switch is enabled, then the integration will be
         // performed on the opposite side of the interface
-        const boundaryInterface & iFace =  flipSide ? it->getInverse() : *it;
+        const boundaryInterface & iFace =  flipSide ? iFaces[wi.task].getInverse() : iFaces[wi.task];
         const index_t patch1 = iFace.first() .patch;
         const index_t patch2 = iFace.second().patch;
 
-        if (iFace.type() == interaction::conforming)
-            interfaceMap = gsAffineFunction<T>::make( iFace.dirMap(), iFace.dirOrientation(),
-                                                      m_exprdata->multiBasis().basis(patch1).support(),
-                                                      m_exprdata->multiBasis().basis(patch2).support() );
-        else
-            interfaceMap = gsCPPInterface<T>::make(getGeometryMap(), m_exprdata->multiBasis(), iFace);
-
-        QuRule = gsQuadrature::getPtr(m_exprdata->multiBasis().basis(patch1),
-                                   m_options, iFace.first().side().direction());
-
-        typename gsBasis<T>::domainIter domIt =
-            m_exprdata->multiBasis().basis(patch1)
-            .makeDomainIterator(iFace.first().side());
-        m_exprdata->getElement().set(*domIt, quWeights);
+        if (wi.task!=task || wi.first<pos)
+        {
+            if (wi.task!=task)
+            {
+                if (iFace.type() == interaction::conforming)
+                    interfaceMap = gsAffineFunction<T>::make( iFace.dirMap(), iFace.dirOrientation(),
+                                                              mb.basis(patch1).support(),
+                                                              mb.basis(patch2).support() );
+                else
+                    interfaceMap = gsCPPInterface<T>::make(getGeometryMap(), mb, iFace);
+
+                QuRule = gsQuadrature::getPtr(mb.basis(patch1),
+                                              m_options, iFace.first().side().direction());
+            }
+            task = wi.task;
+            domIt = mb.basis(patch1).makeDomainIterator(iFace.first().side());
+            m_exprdata->getElement().set(*domIt, quWeights);
+            pos = 0;
+        }
+        seekElement(*domIt, pos, wi.first);
 
-        // Start iteration over elements
-        for (; domIt->good(); domIt->next() )
+        // Start iteration over the elements of the range
+        for (index_t e = 0; e!=wi.size && domIt->good(); ++e, ++pos, domIt->next() )
         {
             // Map the Quadrature rule to the element
             QuRule->mapTo( domIt->lowerCorner(), domIt->upperCorner(),
@@ -1016,7 +1801,7 @@ void gsExprAssembler<T>::assembleIfc(const ifContainer & iFaces, expr... args)
         }
     }
 
-// }//omp parallel
+}//omp parallel
     m_matrix.makeCompressed();
 }
 
@@ -1029,40 +1814,62 @@ void gsExprAssembler<T>::assembleJacobian(const expr residual, solution & u)
     clearMatrix();
     clearRhs();
 
+    const gsMultiBasis<T> & mb = m_exprdata->multiBasis();
+
+    std::vector<index_t> numElements(mb.nBases()), elOffset(mb.nBases()+1, 0);
+    for (size_t p = 0; p!=mb.nBases(); ++p)
+    {
+        numElements[p] = mb.basis(p).numElements();
+        elOffset[p+1] = elOffset[p] + numElements[p];
+    }
+    std::vector<index_t> firstEl, lastEl;
+    localElements(elOffset, firstEl, lastEl);
+    std::vector<workItem> work;
+    workList(firstEl, lastEl, work);
+    prepareSlots(elOffset.back());
+    const size_t cacheBudget = m_options.askInt("cacheBudget", 0) * (size_t)(1<<20);
+
 #pragma omp parallel
 {
-#   ifdef _OPENMP
-    const int tid = omp_get_thread_num();
-    const int nt  = omp_get_num_threads();
-#   endif
-
-    m_exprdata->parse(residual, u);
+    // Copies of the expressions, which refer to the data of the thread
+    expr res = residual;
+    solution sol = u;
+    m_exprdata->parse(res, sol);
     m_exprdata->activateFlags(SAME_ELEMENT);
+    m_exprdata->initCache(elOffset.back(), cacheBudget);
+    // The finite differences perturb a private copy of the solution
+    sol.beginPerturbation();
     //op_tuple(__printExpr(), arg_tpl);
 
     typename gsQuadRule<T>::uPtr QuRule; // Quadrature rule  ---->OUT
+    typename gsBasis<T>::domainIter domIt;
+    index_t patchInd = -1, pos = 0;
 
     gsVector<T> quWeights; // quadrature weights
 
     _eval ee(m_matrix, m_rhs, quWeights);
+    ee.setAtomic(m_fixedPattern && m_matrix.isCompressed());
+    ee.setSlots(&m_slots, m_vcol.size(), &m_slotsSize, m_slotsMax);
 
-    // Note: omp thread will loop over all patches and will work on Ep/nt
-    // elements, where Ep is the elements on the patch.
-    for (unsigned patchInd = 0; patchInd < m_exprdata->multiBasis().nBases(); ++patchInd)
+#   pragma omp for schedule(dynamic,1)
+    for (size_t w = 0; w < work.size(); ++w)
     {
-        QuRule = gsQuadrature::getPtr(m_exprdata->multiBasis().basis(patchInd), m_options);
+        const workItem & wi = work[w];
 
-        // Initialize domain element iterator for current patch
-        typename gsBasis<T>::domainIter domIt =  // add patchInd to domainiter ?
-            m_exprdata->multiBasis().basis(patchInd).makeDomainIterator();
-        m_exprdata->getElement().set(*domIt,quWeights);
+        if (wi.task!=patchInd || wi.first<pos)
+        {
+            if (wi.task!=patchInd)
+                QuRule = gsQuadrature::getPtr(mb.basis(wi.task), m_options);
+            patchInd = wi.task;
+            // Initialize domain element iterator for current patch
+            domIt = mb.basis(patchInd).makeDomainIterator();
+            m_exprdata->getElement().set(*domIt,quWeights);
+            pos = 0;
+        }
+        seekElement(*domIt, pos, wi.first);
 
-        // Start iteration over elements of patchInd
-#       ifdef _OPENMP
-        for ( domIt->next(tid); domIt->good(); domIt->next(nt) )
-#       else
-        for (; domIt->good(); domIt->next() )
-#       endif
+        // Start iteration over the elements of the range
+        for (index_t e = 0; e!=wi.size && domIt->good(); ++e, ++pos, domIt->next() )
         {
             // Map the Quadrature rule to the element
             QuRule->mapTo( domIt->lowerCorner(), domIt->upperCorner(),
@@ -1072,17 +1879,16 @@ void gsExprAssembler<T>::assembleJacobian(const expr residual, solution & u)
                 continue;
 
             // Evaluate at quadrature points
-            m_exprdata->precompute(patchInd);
+            m_exprdata->precomputeElement(patchInd, elOffset[patchInd] + pos);
 
-#           pragma omp critical (assemble_fdiffs)
-            {
-                // ee(residual); //Computes residual to m_rhs
-                ee.diff(residual, u); //Computes Jacobian
-            }
+            ee.setElement(elOffset[patchInd] + pos);
+            // ee(res); //Computes residual to m_rhs
+            ee.diff(res, sol); //Computes Jacobian
         }
     }
 
 }//omp parallel
+    u.endPerturbation();
     m_matrix.makeCompressed();
 }
 
@@ -29,13 +29,13 @@ private:
     gsExprHelper(const gsExprHelper &);
 
     gsExprHelper() : m_mirror(nullptr), mesh_ptr(nullptr),
-                     mutSrc(nullptr), mutMap(nullptr)
-    { }
+                     mutMap(nullptr), m_cacheBudget(0), m_cacheBytes(0)
+    { mutSrc = nullptr; }
 
     explicit gsExprHelper(gsExprHelper * m)
     : m_mirror(memory::make_shared_not_owned(m)),
-      mesh_ptr(m->mesh_ptr), mutSrc(nullptr), mutMap(nullptr)
-    { }
+      mesh_ptr(m->mesh_ptr), mutMap(nullptr), m_cacheBudget(0), m_cacheBytes(0)
+    { mutSrc = nullptr; }
 
 private:
     typedef util::gsThreaded<gsFuncData<T> > thFuncData;
@@ -60,13 +60,26 @@ private:
 
     // mutable pair of variable and data,
     // ie. not uniquely assigned to a gsFunctionSet
-    const gsFunctionSet<T> * mutSrc;
+    // (thread-local, since threads may work on different boundaries)
+    util::gsThreaded<const gsFunctionSet<T> *> mutSrc;
     const gsFunctionSet<T> * mutMap;
     thFuncData               mutData;
 
     // Represents the current element
     expr::gsFeElement<T> m_element;
 
+    // Evaluations of the bases on one element, kept across calls of
+    // precomputeElement()
+    struct cachedElement
+    {
+        gsMatrix<T> points;
+        std::map<const gsFunctionSet<T>*,gsFuncData<T> > fdata;
+        size_t bytes;
+        cachedElement() : bytes(0) { }
+    };
+    std::vector<cachedElement> m_cache;
+    size_t m_cacheBudget, m_cacheBytes;
+
 public:
     typedef memory::unique_ptr<gsExprHelper> uPtr;
     typedef memory::shared_ptr<gsExprHelper>  Ptr;
@@ -197,7 +210,7 @@ public:
 
     void setMutSource(const gsFunctionSet<T> & func)
     {
-        mutSrc = &func;
+        mutSrc.mine() = &func;
     }
 
     //void clearMutSource() ?
@@ -218,6 +231,31 @@ public:
 
 private:
 
+    // Only the evaluations of discretization bases are cached, the
+    // geometry maps and other functions (eg. coefficients) may change
+    // between calls
+    static bool isBasis(const gsFunctionSet<T> * fs)
+    {
+        return nullptr!=dynamic_cast<const gsMultiBasis<T>*>(fs) ||
+               nullptr!=dynamic_cast<const gsBasis<T>*>(fs);
+    }
+
+    // Approximate memory held by the evaluations in \a fd
+    static size_t numBytes(const gsFuncData<T> & fd)
+    {
+        size_t n = fd.actives.size() * sizeof(index_t);
+        for (size_t i = 0; i != fd.values.size(); ++i)
+            n += fd.values[i].size() * sizeof(T);
+        return n + (fd.curls.size() + fd.divs.size() + fd.laplacians.size()) * sizeof(T);
+    }
+
+    static size_t numBytes(const gsMapData<T> & md)
+    {
+        return numBytes(static_cast<const gsFuncData<T>&>(md)) + sizeof(T) *
+            ( md.points.size() + md.measures.size() + md.fundForms.size() +
+              md.jacInvTr.size() + md.normals.size() + md.outNormals.size() );
+    }
+
     inline gsExprHelper & iface()
     {
         if (nullptr==m_mirror )
@@ -313,14 +351,14 @@ public:
         {
             //gsInfo<<"\nGot BC composition\n";
             mutMap = &sym.inner().source();
-            if (nullptr!=mutSrc)
+            if (nullptr!=mutSrc.mine())
             {
 #               pragma omp critical (m_fdata_first_touch)
                 const_cast<expr::gsComposition<T>&>(sym)
                     .setData( mutData );
 
                 const_cast<expr::gsComposition<T>&>(sym)
-                    .setSource(*mutSrc);
+                    .setSource(*mutSrc.mine());
             }
             else
                 gsWarn<<"\nSomething went terribly wrong here (add gsComposition).\n";
@@ -373,14 +411,14 @@ public:
         else
         {
             //gsDebug<<"\nGot a mutable variable.\n";
-            if (nullptr!=mutSrc)
+            if (nullptr!=mutSrc.mine())
             {
 #               pragma omp critical (m_fdata_first_touch)
                 const_cast<expr::symbol_expr<E>&>(sym)
                     .setData( mutData );
 
                 const_cast<expr::symbol_expr<E>&>(sym)
-                    .setSource(*mutSrc);
+                    .setSource(*mutSrc.mine());
             }
             else
                 gsWarn<<"\nSomething went wrong here (add symbol_expr).\n";
@@ -415,9 +453,127 @@ public:
         }
 
         // Mutable variable to treat BCs
-        if (nullptr!=mutSrc && 0!=mutData.mine().flags)
+        if (nullptr!=mutSrc.mine() && 0!=mutData.mine().flags)
+        {
+            mutSrc.mine()->piece(patchIndex)
+                .compute( mutMap ? m_mdata[mutMap].mine().values[0]
+                          : m_points, mutData );
+        }
+    }
+
+    /// @brief Prepares the element cache used by
+    /// precomputeElement() for \a numElements elements, keeping at
+    /// most \a budget bytes of evaluations. A zero budget frees the
+    /// cache. To be called by all threads after parse().
+    void initCache(const size_t numElements, const size_t budget)
+    {
+        #pragma omp single
+        {
+            m_cacheBudget = budget;
+            if (0==budget || m_cache.size()!=numElements)
+                clearCache();
+            if (0!=budget)
+                m_cache.resize(numElements);
+        }//implicit barrier
+    }
+
+    /// @brief Drops all cached element evaluations. Needed after the
+    /// discretization bases have been modified.
+    void clearCache()
+    {
+        m_cache.clear();
+        m_cacheBytes = 0;
+    }
+
+    /// Returns the memory used by the element cache in bytes
+    size_t cacheBytes() const { return m_cacheBytes; }
+
+    /// @brief Same as precompute(patchIndex), but takes the
+    /// evaluations of the bases on element number \a elem from the
+    /// cache, if they were stored by an earlier call with the same
+    /// points and at least the same flags. The geometry maps and
+    /// other functions are always evaluated, since they may have
+    /// changed in the meantime (eg. a deformed configuration).
+    void precomputeElement(const index_t patchIndex, const size_t elem)
+    {
+        if (elem>=m_cache.size())
+        {
+            precompute(patchIndex);
+            return;
+        }
+
+        cachedElement & ce = m_cache[elem];
+        if (ce.points.cols()!=m_points.mine().cols() || ce.points!=m_points.mine())
+        {
+            // Different element or quadrature, drop the entry
+            #pragma omp atomic
+            m_cacheBytes -= ce.bytes;
+            ce.fdata.clear();
+            ce.bytes = 0;
+            ce.points = m_points.mine();
+        }
+        size_t used;
+        #pragma omp atomic read
+        used = m_cacheBytes;
+        const bool store = used < m_cacheBudget;
+        size_t added = 0;
+
+        for (MapDataIt it = m_mdata.begin(); it != m_mdata.end(); ++it)
+        {
+            it->second.mine().points.swap(m_points.mine());//swap
+            it->second.mine().side    = boundary::none;
+            it->second.mine().patchId = patchIndex;
+            it->first->function(patchIndex).computeMap(it->second.mine());
+            it->second.mine().points.swap(m_points.mine());
+        }
+
+        for (FuncDataIt it = m_fdata.begin(); it != m_fdata.end(); ++it)
+        {
+            gsFuncData<T> & fd = it->second.mine();
+            if (!isBasis(it->first))
+            {
+                fd.patchId = patchIndex;
+                it->first->piece(patchIndex).compute(m_points, fd);
+                continue;
+            }
+            typename std::map<const gsFunctionSet<T>*,gsFuncData<T> >::iterator
+                c = ce.fdata.find(it->first);
+            if (c!=ce.fdata.end() && 0==(fd.flags & ~c->second.flags))
+            {
+                fd = c->second;
+                continue;
+            }
+            const unsigned fl = fd.flags;
+            if (c!=ce.fdata.end())
+                fd.flags |= c->second.flags;
+            fd.patchId = patchIndex;
+            it->first->piece(patchIndex).compute(m_points, fd);
+            if (store)
+            {
+                if (c!=ce.fdata.end()) added -= numBytes(c->second);
+                ce.fdata[it->first] = fd;
+                added += numBytes(fd);
+            }
+            fd.flags = fl;
+        }
+
+        if (0!=added)
+        {
+            ce.bytes += added;
+            #pragma omp atomic
+            m_cacheBytes += added;
+        }
+
+        for (CFuncDataIt it = m_cdata.begin(); it != m_cdata.end(); ++it)
+        {
+            it->first.first->piece(patchIndex)
+                .compute(it->first.second->mine().values[0], it->second.mine());
+            it->second.mine().patchId = patchIndex;
+        }
+
+        if (nullptr!=mutSrc.mine() && 0!=mutData.mine().flags)
         {
-            mutSrc->piece(patchIndex)
+            mutSrc.mine()->piece(patchIndex)
                 .compute( mutMap ? m_mdata[mutMap].mine().values[0]
                           : m_points, mutData );
         }
@@ -1377,6 +1377,11 @@ protected:
     gsMatrix<T> * _Sv; ///< Pointer to a coefficient vector
     bool m_isAcross; ///< true when this expression is evaluated across an interface
 
+    typedef std::vector<std::pair<index_t,T> > perturbations;
+    /// Perturbed coefficient and perturbation of every thread,
+    /// shared by all copies, see beginPerturbation()
+    memory::shared_ptr<perturbations> m_pert;
+
 public:
     typedef T Scalar;
     enum {Space = 0, ScalarValued= 0, ColBlocks= 0};
@@ -1392,9 +1397,11 @@ public:
 
     gsFeSolution left() const { return gsFeSolution(*this); }
 
-    explicit gsFeSolution(const gsFeSpace<T> & u) : _u(u), _Sv(NULL) { }
+    explicit gsFeSolution(const gsFeSpace<T> & u)
+    : _u(u), _Sv(NULL), m_pert(new perturbations) { }
 
-    gsFeSolution(const gsFeSpace<T> & u, gsMatrix<T> & Sv) : _u(u), _Sv(&Sv) { }
+    gsFeSolution(const gsFeSpace<T> & u, gsMatrix<T> & Sv)
+    : _u(u), _Sv(&Sv), m_pert(new perturbations) { }
 
     const gsFeSpace<T> & space() const {return _u;};
 
@@ -1413,7 +1420,7 @@ public:
             {
                 const index_t ii = map.index(_u.data().actives(i, singleActives ? 0 : k), _u.data().patchId, c);
                 if ( map.is_free_index(ii) ) // DoF value is in the solVector
-                    res.at(c) += _Sv->at(ii) * _u.data().values[0](i,k);
+                    res.at(c) += coef(ii) * _u.data().values[0](i,k);
                 else
                     res.at(c) += _u.data().values[0](i,k) *
                         _u.fixedPart().at( map.global_to_bindex(ii) );
@@ -1494,19 +1501,59 @@ public:
     
     //const gsMatrix<T> & coefs(component, patch) const { return *_Sv; }
 
+    /// Returns the coefficient with global index \a j, including the
+    /// perturbation of the calling thread (see beginPerturbation())
+    T coef(index_t j) const
+    {
+        if (m_pert->empty())
+            return _Sv->at(j);
+        GISMO_ASSERT(static_cast<size_t>(omp_get_thread_num())<m_pert->size(), "Not in the team of beginPerturbation()");
+        const std::pair<index_t,T> & pt = (*m_pert)[omp_get_thread_num()];
+        return pt.first==j ? _Sv->at(j) + pt.second : _Sv->at(j);
+    }
+
     /// val: perturbation value, j: global index, p: patch
     void perturbLocal(T val, index_t j, index_t p = 0)
     {
+        GISMO_UNUSED(p);
         // GISMO_ASSERT(1==_u.data().actives.cols(), "Single actives expected");
         //if (_u.mapper().is_free_index(j) )
         //{
             GISMO_ASSERT(j<_Sv->size(), "Solution vector is not initialized/allocated, sz="<<_Sv->size() );
+            if (!m_pert->empty())
+            {
+                // Perturb the private copy of the thread, where only
+                // one coefficient is perturbed at a time
+                std::pair<index_t,T> & pt = (*m_pert)[omp_get_thread_num()];
+                if (pt.first!=j)
+                    pt = std::make_pair(j, (T)(0));
+                pt.second += val;
+                return;
+            }
             _Sv->at(j) += val;
             //}
         //else
         //    _u.fixedPart().at( _u.mapper().global_to_bindex(j) ) += val;
     }
 
+    /// @brief Lets perturbLocal() act on a private copy of the
+    /// coefficients for every thread of the current team
+    ///
+    /// Has to be called by all threads of the team. The copy differs
+    /// from the coefficient vector in at most one coefficient, which
+    /// is seen by the evaluations of (all copies of) this solution in
+    /// the same thread. This is used for computing the Jacobian by
+    /// finite differences in parallel.
+    void beginPerturbation()
+    {
+#       pragma omp single
+        m_pert->assign(omp_get_num_threads(), std::make_pair((index_t)(-1), (T)(0)));
+    }
+
+    /// Discards the perturbations, perturbLocal() modifies the
+    /// coefficient vector again (call outside the parallel region)
+    void endPerturbation() { m_pert->clear(); }
+
     /// Extract the coefficients of piece \a p
     void extract(gsMatrix<T> & result, const index_t p = 0) const
     { _u.getCoeffs(*_Sv, result, p); }
@@ -2818,7 +2865,7 @@ public:
                 const index_t ii = map.index(_u.data().actives.at(i), _u.data().patchId,c);
                 if ( map.is_free_index(ii) ) // DoF value is in the solVector
                 {
-                    res.row(c) += _u.coefs().at(ii) *
+                    res.row(c) += _u.coef(ii) *
                         _u.data().values[1].col(k).segment(i*_u.parDim(), _u.parDim()).transpose();
                 }
                 else
@@ -3200,7 +3247,7 @@ public:
                 const index_t ii = map.index(_u.data().actives.at(i), _u.data().patchId,c);
                 deriv2 = _u.data().values[2].block(i*numDers,k,_u.parDim(),1); // this only takes d11, d22, d33 part. For all the derivatives [d11, d22, d33, d12, d13, d23]: col.block(i*numDers,k,numDers,1)
                 if ( map.is_free_index(ii) ) // DoF value is in the solVector
-                    res.at(c) += _u.coefs().at(ii) * deriv2.sum();
+                    res.at(c) += _u.coef(ii) * deriv2.sum();
                 else
                     res.at(c) +=_u.fixedPart().at( map.global_to_bindex(ii) ) * deriv2.sum();
             }
@@ -3546,7 +3593,7 @@ public:
                 const index_t ii = map.index(_u.data().actives.at(i), _u.data().patchId,0);
                 deriv2 = _u.data().values[2].block(i*numDers,k,numDers,1);
                 if ( map.is_free_index(ii) ) // DoF value is in the solVector
-                    res += _u.coefs().at(ii) * deriv2;
+                    res += _u.coef(ii) * deriv2;
                 else
                     res +=_u.fixedPart().at( map.global_to_bindex(ii) ) * deriv2;
             }
@@ -3564,7 +3611,7 @@ public:
                     deriv2 = _u.space().data().values[2].block(i * numDers, k, numDers,
                                                                1).transpose(); // start row, start col, rows, cols
                     if (map.is_free_index(ii)) // DoF value is in the solVector
-                        res.row(c) += _u.coefs().at(ii) * deriv2;
+                        res.row(c) += _u.coef(ii) * deriv2;
                     else
                         res.row(c) += _u.fixedPart().at(map.global_to_bindex(ii)) * deriv2;
                 }
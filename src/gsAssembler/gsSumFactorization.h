@@ -0,0 +1,272 @@
+/** @file gsSumFactorization.h
+
+    @brief Sum-factorized element integrals for tensor-product bases
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gsAssembler/gsQuadrature.h>
+#include <gsTensor/gsTensorBasis.h>
+
+namespace gismo
+{
+
+/** @brief Computes element mass and stiffness integrals of a
+    tensor-product basis by sum factorization.
+
+    On a tensor-product element with a tensor-product quadrature
+    rule, the basis functions are products of univariate functions
+    which are evaluated only on the univariate quadrature nodes. An
+    element integral
+    \f[ \sum_q c(q)\, B_i(q)\, B_j(q) \f]
+    is then computed by contracting one parametric direction at a
+    time. For \f$n=p+1\f$ active functions and \f$n\f$ nodes per
+    direction the cost is \f$O(n^{2d+1})\f$ instead of the
+    \f$O(n^{3d})\f$ of the point-wise accumulation.
+
+    The quadrature nodes passed to evaluate() must be the tensor
+    product of univariate nodes in lexicographic order, as
+    produced by gsGaussRule and gsLobattoRule.
+
+    The mass and Poisson visitors of gsAssembler use it if the
+    option "SumFactorization" is set, which is off by default.
+
+    \ingroup Assembler
+*/
+template <class T>
+class gsSumFactorization
+{
+public:
+
+    gsSumFactorization() : m_basis(NULL) { }
+
+    /// @brief Prepares the kernel for \a basis. Returns false (and
+    /// the kernel stays inactive) if the basis is not a polynomial
+    /// tensor-product basis, if the quadrature rule is not a
+    /// tensor rule, or if the option "SumFactorization" is off.
+    bool setup(const gsBasis<T> & basis, const gsOptionList & options)
+    {
+        m_basis = NULL;
+        if ( ! options.askSwitch("SumFactorization", false) )
+            return false;
+
+        const index_t qu = options.askInt("quRule", gsQuadrature::GaussLegendre);
+        if ( qu != gsQuadrature::GaussLegendre && qu != gsQuadrature::GaussLobatto )
+            return false;
+
+        if ( options.askSwitch("overInt", false) ) // mixed rules are not tensor rules
+            return false;
+
+        if ( ! isTensor(basis) )
+            return false;
+
+        m_basis = &basis;
+        m_numNodes = gsQuadrature::numNodes(basis, options.getReal("quA"),
+                                            options.getInt("quB"));
+        return true;
+    }
+
+    /// Returns true if the kernel is used on the current basis
+    bool isActive() const { return NULL!=m_basis; }
+
+    /// @brief Evaluates the univariate bases on the element whose
+    /// tensor-product quadrature nodes are \a quNodes
+    void evaluate(const gsMatrix<T> & quNodes)
+    {
+        GISMO_ASSERT(isActive(), "Sum factorization is not set up.");
+        const short_t d = m_basis->dim();
+        GISMO_ASSERT(quNodes.cols()==m_numNodes.prod(),
+                     "The quadrature nodes are not a tensor-product grid.");
+
+        m_vals.resize(d, std::vector<gsMatrix<T> >(2));
+        m_factors.resize(d, std::vector<gsMatrix<T> >(4));
+        index_t stride = 1;
+        gsMatrix<T> nodes;
+        std::vector<gsMatrix<T> > ders;
+        for (short_t k = 0; k != d; ++k)
+        {
+            const index_t nq = m_numNodes[k];
+            nodes.resize(1, nq);
+            for (index_t q = 0; q != nq; ++q)
+                nodes(0,q) = quNodes(k, q*stride);
+            stride *= nq;
+
+            m_basis->component(k).evalAllDers_into(nodes, 1, ders);
+            m_vals[k][0].swap(ders[0]);
+            m_vals[k][1].swap(ders[1]);
+
+            // Products of test and trial functions (and derivatives)
+            const index_t n = m_vals[k][0].rows();
+            for (index_t t = 0; t != 4; ++t)
+            {
+                const gsMatrix<T> & test  = m_vals[k][t%2];
+                const gsMatrix<T> & trial = m_vals[k][t/2];
+                gsMatrix<T> & C = m_factors[k][t];
+                C.resize(n*n, nq);
+                for (index_t j = 0; j != n; ++j)
+                    for (index_t i = 0; i != n; ++i)
+                        C.row(i+n*j) = test.row(i).cwiseProduct(trial.row(j));
+            }
+        }
+    }
+
+    /// @brief Adds to \a localMat the mass integrals weighted by
+    /// \a coefs, i.e. quadrature weights times measure
+    void mass(const gsMatrix<T> & coefs, gsMatrix<T> & localMat)
+    {
+        std::vector<const gsMatrix<T>*> C(m_factors.size());
+        for (size_t k = 0; k != C.size(); ++k)
+            C[k] = &m_factors[k][0];
+        contract(coefs.data(), C, m_buf);
+        scatter(m_buf, localMat);
+    }
+
+    /// @brief Adds to \a localMat the stiffness integrals, where
+    /// column \a q of \a coefs is the \f$d\times d\f$ matrix
+    /// \f$w\,|J|\,(J^TJ)^{-1}\f$ (column-major) acting on the
+    /// parametric gradients at node \a q
+    void stiffness(const gsMatrix<T> & coefs, gsMatrix<T> & localMat)
+    {
+        const short_t d = m_basis->dim();
+        GISMO_ASSERT(coefs.rows()==d*d, "Invalid size of coefficients.");
+        std::vector<const gsMatrix<T>*> C(d);
+        index_t numPairs = 1;
+        for (short_t k = 0; k != d; ++k)
+            numPairs *= m_factors[k][0].rows();
+        m_acc.setZero(numPairs, 1);
+        for (short_t b = 0; b != d; ++b)
+            for (short_t a = 0; a != d; ++a)
+            {
+                // Derivative of the test function in direction a,
+                // of the trial function in direction b
+                for (short_t k = 0; k != d; ++k)
+                    C[k] = &m_factors[k][(k==a) + 2*(k==b)];
+                m_coef = coefs.row(a+d*b);
+                contract(m_coef.data(), C, m_buf);
+                m_acc += m_buf;
+            }
+        scatter(m_acc, localMat);
+    }
+
+    /// @brief Adds to \a localRhs the moments of the function
+    /// values \a coefs (one row per right-hand side) multiplied by
+    /// the row \a weights, i.e. quadrature weights times measure
+    void moments(const gsMatrix<T> & weights, const gsMatrix<T> & coefs,
+                 gsMatrix<T> & localRhs)
+    {
+        std::vector<const gsMatrix<T>*> C(m_vals.size());
+        for (size_t k = 0; k != C.size(); ++k)
+            C[k] = &m_vals[k][0];
+        for (index_t r = 0; r != coefs.rows(); ++r)
+        {
+            m_coef = coefs.row(r).cwiseProduct(weights);
+            contract(m_coef.data(), C, m_buf);
+            localRhs.col(r) += m_buf;
+        }
+    }
+
+    /// Computes the mass coefficients, i.e. quadrature weights times measure
+    static void massCoefs(const gsVector<T> & quWeights, const gsMapData<T> & md,
+                          gsMatrix<T> & coefs)
+    {
+        coefs.noalias() = quWeights.transpose().cwiseProduct(md.measures);
+    }
+
+    /// Computes the stiffness coefficients expected by stiffness()
+    static void stiffnessCoefs(const gsVector<T> & quWeights, const gsMapData<T> & md,
+                               gsMatrix<T> & coefs)
+    {
+        const index_t d = md.dim.first;
+        coefs.resize(d*d, quWeights.rows());
+        gsMatrix<T> metric;
+        for (index_t k = 0; k != quWeights.rows(); ++k)
+        {
+            // (J^T J)^{-1} also covers surfaces embedded in higher dimension
+            metric.noalias() = md.jacobian(k).transpose() * md.jacobian(k);
+            gsAsMatrix<T> K(coefs.col(k).data(), d, d);
+            K.noalias() = (quWeights[k] * md.measure(k)) * metric.cramerInverse();
+        }
+    }
+
+    /// Returns true if \a basis is a polynomial tensor-product basis
+    static bool isTensor(const gsBasis<T> & basis)
+    {
+        return NULL!=dynamic_cast<const gsTensorBasis<2,T>*>(&basis) ||
+               NULL!=dynamic_cast<const gsTensorBasis<3,T>*>(&basis) ||
+               NULL!=dynamic_cast<const gsTensorBasis<4,T>*>(&basis) ;
+    }
+
+private:
+
+    // Contracts the quadrature values \a coefs direction by
+    // direction with the (row-wise) factors \a C. The result holds
+    // one entry per multi-index of factor rows, first direction
+    // running fastest.
+    void contract(const T * coefs, const std::vector<const gsMatrix<T>*> & C,
+                  gsMatrix<T> & result)
+    {
+        index_t P = 1, R = m_numNodes.prod();
+        const T * src = coefs;
+        for (size_t k = 0; k != C.size(); ++k)
+        {
+            const index_t nq = C[k]->cols(), m = C[k]->rows();
+            R /= nq;
+            gsMatrix<T> & dst = (k%2 ? m_tmp : result);
+            dst.resize(P*m*R, 1);
+            for (index_t r = 0; r != R; ++r)
+            {
+                gsAsConstMatrix<T> X(src + r*P*nq, P, nq);
+                gsAsMatrix<T> Y(dst.data() + r*P*m, P, m);
+                Y.noalias() = X * C[k]->transpose();
+            }
+            src = dst.data();
+            P *= m;
+        }
+        if (C.size()%2 == 0) // last stage wrote into m_tmp
+            result.swap(m_tmp);
+    }
+
+    // Adds the contracted pairs of univariate indices into the
+    // element matrix, where local indices are lexicographic
+    void scatter(const gsMatrix<T> & pairs, gsMatrix<T> & localMat) const
+    {
+        const short_t d = static_cast<short_t>(m_vals.size());
+        gsVector<index_t> n(d), cur(d);
+        for (short_t k = 0; k != d; ++k)
+            n[k] = m_vals[k][0].rows();
+        const gsVector<index_t> n2 = n.cwiseProduct(n);
+        cur.setZero();
+        index_t f = 0;
+        do
+        {
+            index_t I = 0, J = 0;
+            for (short_t k = d-1; k >= 0; --k)
+            {
+                I = I*n[k] + cur[k] % n[k];
+                J = J*n[k] + cur[k] / n[k];
+            }
+            localMat(I,J) += pairs(f++,0);
+        } while (nextLexicographic(cur, n2));
+    }
+
+private:
+    const gsBasis<T> * m_basis;
+    gsVector<index_t>  m_numNodes;
+
+    // Univariate values and first derivatives, per direction
+    std::vector<std::vector<gsMatrix<T> > > m_vals;
+
+    // Row-wise products of univariate test and trial functions,
+    // indexed by (test derivative) + 2*(trial derivative)
+    std::vector<std::vector<gsMatrix<T> > > m_factors;
+
+    gsMatrix<T> m_buf, m_tmp, m_coef, m_acc;
+};
+
+} // namespace gismo
@@ -52,6 +52,9 @@ public:
         // Setup Quadrature
         rule = gsQuadrature::get(basis, options); // harmless slicing occurs here
 
+        // Use sum factorization on tensor-product bases
+        sf.setup(basis, options);
+
         // Set Geometry evaluation flags
         md.flags = NEED_MEASURE|NEED_GRAD_TRANSFORM;
     }
@@ -69,7 +72,10 @@ public:
         const index_t numActive = actives.rows();
 
         // Evaluate basis functions on element
-        basis.deriv_into(md.points, basisData);
+        if ( sf.isActive() )
+            sf.evaluate(md.points);
+        else
+            basis.deriv_into(md.points, basisData);
 
         // Compute geometry related values
         geo.computeMap(md);
@@ -82,6 +88,13 @@ public:
     inline void assemble(gsDomainIterator<T>    & /*element*/,
                          gsVector<T> const      & quWeights)
     {
+        if ( sf.isActive() )
+        {
+            gsSumFactorization<T>::stiffnessCoefs(quWeights, md, sfCoefs);
+            sf.stiffness(sfCoefs, localMat);
+            return;
+        }
+
         for (index_t k = 0; k < quWeights.rows(); ++k) // loop over quadrature nodes
         {
             // Multiply quadrature weight by the geometry measure
@@ -103,6 +116,8 @@ private:
     gsMatrix<T>  basisPhGrads;
     using Base:: basisData;
     using Base::actives;
+    using Base::sf;
+    using Base::sfCoefs;
 
     // Local matrix
     using Base::localMat;
@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include <gsAssembler/gsSumFactorization.h>
+
 namespace gismo
 {
 
@@ -49,6 +51,9 @@ public:
         // Setup Quadrature (harmless slicing occurs)
         rule = gsQuadrature::get(basis, options); // harmless slicing occurs here
 
+        // Use sum factorization on tensor-product bases
+        sf.setup(basis, options);
+
         // Set Geometry evaluation flags
         md.flags = NEED_MEASURE;
     }
@@ -66,7 +71,10 @@ public:
         const index_t numActive = actives.rows();
 
         // Evaluate basis functions on element
-        basis.eval_into(md.points, basisData);
+        if ( sf.isActive() )
+            sf.evaluate(md.points);
+        else
+            basis.eval_into(md.points, basisData);
 
         // Compute geometry related values
         geo.computeMap(md);
@@ -79,6 +87,13 @@ public:
     inline void assemble(gsDomainIterator<T>    & ,
                          gsVector<T> const      & quWeights)
     {
+        if ( sf.isActive() )
+        {
+            gsSumFactorization<T>::massCoefs(quWeights, md, sfCoefs);
+            sf.mass(sfCoefs, localMat);
+            return;
+        }
+
         localMat.noalias() =
             basisData * quWeights.asDiagonal() *
             md.measures.asDiagonal() * basisData.transpose();
@@ -147,6 +162,10 @@ protected:
     gsMatrix<T>      basisData;
     gsMatrix<index_t> actives;
 
+    // Sum-factorization kernel and its coefficients
+    gsSumFactorization<T> sf;
+    gsMatrix<T> sfCoefs;
+
     // Local matrix
     gsMatrix<T> localMat;
 
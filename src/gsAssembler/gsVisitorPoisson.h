@@ -14,6 +14,7 @@
 #pragma once
 
 #include <gsAssembler/gsQuadrature.h>
+#include <gsAssembler/gsSumFactorization.h>
 
 namespace gismo
 {
@@ -54,6 +55,9 @@ public:
         // Setup Quadrature
         rule = gsQuadrature::get(basis, options); // harmless slicing occurs here
 
+        // Use sum factorization on tensor-product bases
+        sf.setup(basis, options);
+
         // Set Geometry evaluation flags
         md.flags = NEED_VALUE | NEED_MEASURE | NEED_GRAD_TRANSFORM;
     }
@@ -70,7 +74,10 @@ public:
         numActive = actives.rows();
 
         // Evaluate basis functions on element
-        basis.evalAllDers_into( md.points, 1, basisData);
+        if ( sf.isActive() )
+            sf.evaluate(md.points);
+        else
+            basis.evalAllDers_into( md.points, 1, basisData);
 
         // Compute image of Gauss nodes under geometry mapping as well as Jacobians
         geo.computeMap(md);
@@ -89,6 +96,15 @@ public:
     inline void assemble(gsDomainIterator<T>    & ,
                          gsVector<T> const      & quWeights)
     {
+        if ( sf.isActive() )
+        {
+            gsSumFactorization<T>::massCoefs(quWeights, md, sfCoefs);
+            sf.moments(sfCoefs, rhsVals, localRhs);
+            gsSumFactorization<T>::stiffnessCoefs(quWeights, md, sfCoefs);
+            sf.stiffness(sfCoefs, localMat);
+            return;
+        }
+
         gsMatrix<T> & bVals  = basisData[0];
         gsMatrix<T> & bGrads = basisData[1];
 
@@ -128,6 +144,10 @@ protected:
     gsMatrix<index_t> actives;
     index_t numActive;
 
+    // Sum-factorization kernel and its coefficients
+    gsSumFactorization<T> sf;
+    gsMatrix<T> sfCoefs;
+
 protected:
     // Right hand side ptr for current patch
     const gsFunction<T> * rhs_ptr;
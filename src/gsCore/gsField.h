@@ -126,6 +126,27 @@ public:
             : m_fields->piece(i).eval( point(u, i) );
     }
 
+    /// @brief Same as point(), but evaluated in parallel over
+    /// chunks of the points (see gsFunction::evalParallel_into())
+    void pointParallel_into(const gsMatrix<T>& u, gsMatrix<T>& result, int i = 0) const
+    {
+        static_cast<const gsFunction<T>&>(m_patches->piece(i)).evalParallel_into(u, result);
+    }
+
+    /// @brief Same as value(), but evaluated in parallel over
+    /// chunks of the points (see gsFunction::evalParallel_into())
+    void valueParallel_into(const gsMatrix<T>& u, gsMatrix<T>& result, int i = 0) const
+    {
+        if ( m_parametric )
+            function(i).evalParallel_into(u, result);
+        else
+        {
+            gsMatrix<T> pts;
+            pointParallel_into(u, pts, i);
+            function(i).evalParallel_into(pts, result);
+        }
+    }
+
     // Return the value of the Field at physical value u
     // TO DO: rename to evalPhys()
     gsMatrix<T> pvalue(const gsMatrix<T>& u, int i)  const
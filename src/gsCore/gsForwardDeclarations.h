@@ -295,12 +295,16 @@ template <class T=real_t>                class gsProductOp;
 template <class T=real_t>                class gsCompositePrecOp;
 template <class T=real_t>                class gsKroneckerOp;
 template <class T=real_t>                class gsBlockOp;
+template <class T=real_t>                class gsDistributedMatrixOp;
+template <class T=real_t>                class gsDistributedIndexSet;
+template <class T=real_t>                class gsDistributedAdditiveOp;
 template <class T=real_t>                class gsPatchPreconditionersCreator;
 
 // gsMultiGrid
 
 template <class T=real_t>                class gsMultiGridOp;
 template <class T=real_t>                class gsGridHierarchy;
+template <class T=real_t>                class gsSmoothedAggregation;
 
 // gsIeti
 
@@ -319,6 +323,7 @@ template <short_t d, class T=real_t>     class gsHBox;
 template <short_t d, class T=real_t>     class gsHBoxContainer;
 
 class gsParaviewDataSet;
+class gsVtkDataArrays;
 class gsSurfMesh;
 
 // gsIO
@@ -176,6 +176,19 @@ public:
 
     gsMatrix<T> jacobian(const gsMatrix<T>& u) const;
 
+    /** @brief Evaluates the function (\a n = 0) or its first
+     * derivatives (\a n = 1, same layout as deriv_into()) at the
+     * points \a u, in chunks of points handled by all OpenMP threads.
+     *
+     * Meant for large point sets, e.g. in post-processing or
+     * fitting. The result is the same as eval_into() or deriv_into().
+     */
+    virtual void evalParallel_into(const gsMatrix<T>& u, gsMatrix<T>& result,
+                                   int n = 0) const;
+
+    /// @brief Same as jacobian_into(), evaluated as in evalParallel_into()
+    void jacobianParallel_into(const gsMatrix<T>& u, gsMatrix<T>& result) const;
+
     /** @brief Evaluate second derivatives of the function at points \a u into \a result.
      *
      * Let \em n be the dimension of the source space ( n = domainDim() ).\n
@@ -294,6 +307,18 @@ public:
 
     index_t size() const { return 1;}
 
+protected:
+
+    /// Evaluates as in evalParallel_into(), where the chunks are
+    /// consecutive points of \a u taken in the order \a order (if
+    /// not empty)
+    void evalChunks_into(const gsMatrix<T>& u, const std::vector<index_t> & order,
+                         gsMatrix<T>& result, int n) const;
+
+    /// The number of points per chunk used by evalChunks_into() for
+    /// \a numPts points
+    static index_t chunkSize(const index_t numPts);
+
 private:
 
     template<int mode, int _Dim=-1>
@@ -55,6 +55,77 @@ void gsFunction<T>::jacobian_into(const gsMatrix<T>& u, gsMatrix<T>& result) con
     result.blockTransposeInPlace( targetDim() );
 }
 
+template <class T>
+void gsFunction<T>::evalParallel_into(const gsMatrix<T>& u, gsMatrix<T>& result,
+                                      int n) const
+{
+    evalChunks_into(u, std::vector<index_t>(), result, n);
+}
+
+template <class T>
+void gsFunction<T>::jacobianParallel_into(const gsMatrix<T>& u, gsMatrix<T>& result) const
+{
+    this->evalParallel_into(u, result, 1);
+
+    // Reshape as in jacobian_into()
+    const short_t d = domainDim();
+    result.resize(d, result.size()/d);
+    result.blockTransposeInPlace( targetDim() );
+}
+
+template <class T>
+void gsFunction<T>::evalChunks_into(const gsMatrix<T>& u,
+                                    const std::vector<index_t> & order,
+                                    gsMatrix<T>& result, int n) const
+{
+    GISMO_ASSERT(0==n || 1==n, "Only values (n=0) and first derivatives (n=1) are supported");
+    GISMO_ASSERT(order.empty() || order.size()==static_cast<size_t>(u.cols()),
+                 "Invalid ordering of the points");
+    const index_t numPts = u.cols();
+    result.resize( (0==n ? 1 : domainDim()) * targetDim(), numPts );
+
+    const index_t chunk = chunkSize(numPts);
+    const index_t numChunks = (numPts + chunk - 1) / chunk;
+
+#   pragma omp parallel
+    {
+        gsMatrix<T> pts, vals;
+#       pragma omp for schedule(dynamic,1)
+        for (index_t c = 0; c < numChunks; ++c)
+        {
+            const index_t first = c * chunk;
+            const index_t sz = math::min(chunk, numPts - first);
+            if (order.empty())
+                pts = u.middleCols(first, sz);
+            else
+            {
+                pts.resize(u.rows(), sz);
+                for (index_t j = 0; j != sz; ++j)
+                    pts.col(j) = u.col(order[first+j]);
+            }
+
+            if (0==n)
+                this->eval_into(pts, vals);
+            else
+                this->deriv_into(pts, vals);
+
+            if (order.empty())
+                result.middleCols(first, sz) = vals;
+            else
+                for (index_t j = 0; j != sz; ++j)
+                    result.col(order[first+j]) = vals.col(j);
+        }
+    }
+}
+
+template <class T>
+index_t gsFunction<T>::chunkSize(const index_t numPts)
+{
+    // Several chunks per thread, small enough to stay in cache
+    const index_t nt = omp_get_max_threads();
+    return math::max( (index_t)64, math::min((index_t)4096, numPts/(8*nt)) );
+}
+
 template <class T>
 void gsFunction<T>::div_into(const gsMatrix<T>& u, gsMatrix<T>& result) const
 {
@@ -15,6 +15,10 @@
 
 #include <gsCore/gsLinearAlgebra.h>
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 /* ExprTk options */
 
 //This define will enable printing of debug information to stdout during
@@ -189,23 +193,103 @@ public:
     typedef exprtk::expression<Numeric_t>    Expression_t;
     typedef exprtk::parser<Numeric_t>        Parser_t;
 
+    /// Compiled expressions together with their variables. Every
+    /// thread of the OpenMP team owns one evaluator, hence evaluation
+    /// does not require any synchronization (see LocalEvaluator).
+    struct Evaluator
+    {
+        Evaluator() : vars() { }
+
+        mutable Numeric_t         vars[N_VARS];
+        SymbolTable_t             symbol_table;
+        std::vector<Expression_t> expression;
+
+        void init()
+        {
+            // Identify symbol table
+            symbol_table.add_variable("x",vars[0]);
+            symbol_table.add_variable("y",vars[1]);
+            symbol_table.add_variable("z",vars[2]);
+            symbol_table.add_variable("w",vars[3]);
+            symbol_table.add_variable("u",vars[4]);
+            symbol_table.add_variable("v",vars[5]);
+            symbol_table.add_variable("t",vars[6]);
+            //symbol_table.remove_variable("w",vars[3]);
+            symbol_table.add_pi();
+            //symbol_table.add_constant("C", 1);
+        }
+
+        bool compile(const std::string & str)
+        {
+            if (0==symbol_table.variable_count()) init();
+
+            // String expression
+            expression.push_back(Expression_t());
+            Expression_t & expr = expression.back();
+            //expr.release();
+            expr.register_symbol_table(symbol_table);
+
+            // Parser
+            Parser_t parser;
+            //Collect variable symbols
+            //parser.dec().collect_variables() = true;
+            const bool success = parser.compile(str, expr);
+            if ( ! success )
+                gsWarn<<"gsFunctionExpr error: " <<parser.error() <<" while parsing "<<str<<"\n";
+            return success;
+        }
+
+    private:
+        Evaluator(const Evaluator &);
+        Evaluator & operator= (const Evaluator &);
+    };
+
+public:
+
+    /// @brief Gives the calling thread access to an evaluator, having
+    /// the parameter values set and all components compiled
+    ///
+    /// The evaluator of the OpenMP thread number is used if no other
+    /// thread has claimed it before. All other callers, eg. a
+    /// std::thread or a thread beyond the number of threads at
+    /// construction, share one evaluator, which is locked as long as
+    /// the LocalEvaluator exists.
+    class LocalEvaluator
+    {
+    public:
+        explicit LocalEvaluator(const gsFunctionExprPrivate & data)
+        : m_ev(data.ownEvaluator()), m_lock(data.sharedLock, std::defer_lock)
+        {
+            if (nullptr == m_ev)
+            {
+                m_lock.lock();
+                m_ev = &data.shared;
+            }
+            for (size_t i = m_ev->expression.size(); i < data.string.size(); ++i)
+                m_ev->compile(data.string[i]);
+            copy_n(data.vars, N_VARS, m_ev->vars);
+        }
+
+        Evaluator & operator*() const { return *m_ev; }
+
+    private:
+        Evaluator * m_ev;
+        std::unique_lock<std::mutex> m_lock;
+    };
+
 public:
 
     gsFunctionExprPrivate(const short_t _dim)
-    : vars(), dim(_dim)
+    : vars(), dim(_dim), slots(omp_get_max_threads())
     {
         GISMO_ENSURE( dim <= N_VARS, "The number of variables can be at most 7 (x,y,z,w,u,v,t)." );
-        init();
     }
 
     gsFunctionExprPrivate(const gsFunctionExprPrivate & other)
-    : vars(), dim(other.dim)
+    : vars(), dim(other.dim), slots(omp_get_max_threads())
     {
-        GISMO_ASSERT ( string.size() == expression.size(), "Corrupted FunctionExpr");
-        init();
-        //copy_n(other.vars, N_VARS+1, vars);
-        string    .reserve(string.size());
-        expression.reserve(string.size());
+        copy_n(other.vars, N_VARS, vars);
+        string.reserve(other.string.size());
         for (size_t i = 0; i!= other.string.size(); ++i)
             addComponent(other.string[i]);
     }
@@ -217,56 +301,45 @@ public:
         str.erase(std::remove(str.begin(), str.end(),' '), str.end() );
         gismo::util::string_replace(str, "**", "^");
 
-        // String expression
-        expression.push_back(Expression_t());
-        Expression_t & expr = expression.back();
-        //expr.release();
-        expr.register_symbol_table(symbol_table);
-
-        // Parser
-        Parser_t parser;
-        //Collect variable symbols
-        //parser.dec().collect_variables() = true;
-        bool success = parser.compile(str, expr);
-        if ( ! success )
-            gsWarn<<"gsFunctionExpr error: " <<parser.error() <<" while parsing "<<str<<"\n";
-        /*
-           typedef typename exprtk::parser_t::
-           dependent_entity_collector::symbol_t symbol_t;
-
-           std::deque<symbol_t> symbol_list;
-           parser.dec().symbols(symbol_list);
-           for (size_t i = 0; i != symbol_list.size(); ++i)
-           {
-           symbol_t& symbol = symbol_list[i];
-           // do something
-           }
-        */
-    }
-
-    void init()
-    {
-        //symbol_table.clear();
-        // Identify symbol table
-        symbol_table.add_variable("x",vars[0]);
-        symbol_table.add_variable("y",vars[1]);
-        symbol_table.add_variable("z",vars[2]);
-        symbol_table.add_variable("w",vars[3]);
-        symbol_table.add_variable("u",vars[4]);
-        symbol_table.add_variable("v",vars[5]);
-        symbol_table.add_variable("t",vars[6]);
-        //symbol_table.remove_variable("w",vars[3]);
-        symbol_table.add_pi();
-        //symbol_table.add_constant("C", 1);
+        // Compile once for the calling thread, the other threads
+        // compile their copies on first use
+        LocalEvaluator ev(*this);
     }
 
 public:
-    mutable Numeric_t         vars[N_VARS];
-    SymbolTable_t             symbol_table;
-    std::vector<Expression_t> expression;
+    mutable Numeric_t         vars[N_VARS]; ///< Values of the parameters
     std::vector<std::string>  string;
     short_t dim;
 
+private:
+
+    /// Returns the evaluator of the calling thread's number, or
+    /// nullptr if it is out of range or owned by another thread
+    Evaluator * ownEvaluator() const
+    {
+        const size_t i = omp_get_thread_num();
+        if (i >= slots.size())
+            return nullptr;
+        Slot & slot = slots[i];
+        const std::thread::id me = std::this_thread::get_id();
+        std::thread::id none;
+        if ( me == slot.owner.load() || slot.owner.compare_exchange_strong(none, me) )
+            return &slot.ev;
+        return nullptr;
+    }
+
+    /// An evaluator together with the thread that uses it
+    struct Slot
+    {
+        Slot() : owner(std::thread::id()) { }
+        std::atomic<std::thread::id> owner;
+        Evaluator ev;
+    };
+
+    mutable std::vector<Slot> slots;    ///< One evaluator per thread of the team
+    mutable Evaluator         shared;   ///< Evaluator of all other callers
+    mutable std::mutex        sharedLock;
+
 private:
     gsFunctionExprPrivate();
     gsFunctionExprPrivate operator= (const gsFunctionExprPrivate & other);
@@ -518,16 +591,17 @@ void gsFunctionExpr<T>::eval_into(const gsMatrix<T>& u, gsMatrix<T>& result) con
     const short_t n = targetDim();
     result.resize(n, u.cols());
 
-#pragma omp critical (gsFunctionExpr_run)
+    typename PrivateData_t::LocalEvaluator lev(*my);
+    typename PrivateData_t::Evaluator & ev = *lev;
     for ( index_t p = 0; p!=u.cols(); p++ ) // for all evaluation points
     {
-        copy_n(u.col(p).data(), my->dim, my->vars);
+        copy_n(u.col(p).data(), my->dim, ev.vars);
 
         for (short_t c = 0; c!= n; ++c) // for all components
 #           ifdef GISMO_WITH_ADIFF
-            result(c,p) = my->expression[c].value().getValue();
+            result(c,p) = ev.expression[c].value().getValue();
 #           else
-            result(c,p) = my->expression[c].value();
+            result(c,p) = ev.expression[c].value();
 #           endif
     }
 }
@@ -542,15 +616,16 @@ void gsFunctionExpr<T>::eval_component_into(const gsMatrix<T>& u, const index_t
                   "Given component number is higher then number of components");
 
     result.resize(1, u.cols());
-#   pragma omp critical (gsFunctionExpr_run)
+    typename PrivateData_t::LocalEvaluator lev(*my);
+    typename PrivateData_t::Evaluator & ev = *lev;
     for ( index_t p = 0; p!=u.cols(); ++p )
     {
-        copy_n(u.col(p).data(), my->dim, my->vars);
+        copy_n(u.col(p).data(), my->dim, ev.vars);
 
 #           ifdef GISMO_WITH_ADIFF
-            result(0,p) = my->expression[comp].value().getValue();
+            result(0,p) = ev.expression[comp].value().getValue();
 #           else
-            result(0,p) = my->expression[comp].value();
+            result(0,p) = ev.expression[comp].value();
 #           endif
     }
 }
@@ -565,21 +640,22 @@ void gsFunctionExpr<T>::deriv_into(const gsMatrix<T>& u, gsMatrix<T>& result) co
 
     const short_t n = targetDim();
     result.resize(d*n, u.cols());
-#   pragma omp critical (gsFunctionExpr_run)
+    typename PrivateData_t::LocalEvaluator lev(*my);
+    typename PrivateData_t::Evaluator & ev = *lev;
     for ( index_t p = 0; p!=u.cols(); p++ ) // for all evaluation points
     {
 #       ifdef GISMO_WITH_ADIFF
         for (short_t k = 0; k!=d; ++k)
-            my->vars[k].setVariable(k,d,u(k,p));
+            ev.vars[k].setVariable(k,d,u(k,p));
         for (short_t c = 0; c!= n; ++c) // for all components
-            my->expression[c].value().gradient_into(result.block(c*d,p,d,1));
-            //result.block(c*d,p,d,1) = my->expression[c].value().getGradient(); //fails on constants
+            ev.expression[c].value().gradient_into(result.block(c*d,p,d,1));
+            //result.block(c*d,p,d,1) = ev.expression[c].value().getGradient(); //fails on constants
 #       else
-        copy_n(u.col(p).data(), my->dim, my->vars);
+        copy_n(u.col(p).data(), my->dim, ev.vars);
         for (short_t c = 0; c!= n; ++c) // for all components
             for ( short_t j = 0; j!=d; j++ ) // for all variables
                 result(c*d + j, p) =
-                    exprtk::derivative<T>(my->expression[c], my->vars[j], 0.00001 ) ;
+                    exprtk::derivative<T>(ev.expression[c], ev.vars[j], 0.00001 ) ;
 #       endif
     }
 }
@@ -594,19 +670,20 @@ void gsFunctionExpr<T>::deriv2_into(const gsMatrix<T>& u, gsMatrix<T>& result) c
     const short_t n = targetDim();
     const index_t stride = d + d*(d-1)/2;
     result.resize(stride*n, u.cols() );
-#   pragma omp critical (gsFunctionExpr_run)
+    typename PrivateData_t::LocalEvaluator lev(*my);
+    typename PrivateData_t::Evaluator & ev = *lev;
     for ( index_t p = 0; p!=u.cols(); p++ ) // for all evaluation points
     {
 #       ifndef GISMO_WITH_ADIFF
-        copy_n(u.col(p).data(), my->dim, my->vars);
+        copy_n(u.col(p).data(), my->dim, ev.vars);
 #       endif
 
         for (short_t c = 0; c!= n; ++c) // for all components
         {
 #           ifdef GISMO_WITH_ADIFF
             for (index_t v = 0; v!=d; ++v)
-                my->vars[v].setVariable(v,d,u(v,p));
-            const DScalar &            ads  = my->expression[c].value();
+                ev.vars[v].setVariable(v,d,u(v,p));
+            const DScalar &            ads  = ev.expression[c].value();
             const DScalar::Hessian_t & Hmat = ads.getHessian(); // note: can fail
 
             for ( index_t k=0; k!=d; ++k)
@@ -621,15 +698,15 @@ void gsFunctionExpr<T>::deriv2_into(const gsMatrix<T>& u, gsMatrix<T>& result) c
             {
                 // H_{k,k}
                 result(k,p) = exprtk::
-                    second_derivative<T>(my->expression[c], my->vars[k], 0.00001);
+                    second_derivative<T>(ev.expression[c], ev.vars[k], 0.00001);
 
                 short_t m = d;
                 for (short_t l=k+1; l<d; ++l)
                 {
                     // H_{k,l}
                     result(m++,p) =
-                        mixed_derivative<T>( my->expression[c], my->vars[k],
-                                             my->vars[l], 0.00001 );
+                        mixed_derivative<T>( ev.expression[c], ev.vars[k],
+                                             ev.vars[l], 0.00001 );
                 }
             }
 #           endif
@@ -650,26 +727,25 @@ gsFunctionExpr<T>::hess(const gsMatrix<T>& u, unsigned coord) const
 
     gsMatrix<T> res(d, d);
 
-#   pragma omp critical (gsFunctionExpr_run)
-{
+    typename PrivateData_t::LocalEvaluator lev(*my);
+    typename PrivateData_t::Evaluator & ev = *lev;
 #   ifdef GISMO_WITH_ADIFF
     for (index_t v = 0; v!=d; ++v)
-        my->vars[v].setVariable(v, d, u(v,0) );
-    my->expression[coord].value().hessian_into(res);
+        ev.vars[v].setVariable(v, d, u(v,0) );
+    ev.expression[coord].value().hessian_into(res);
 #   else
-    copy_n(u.data(), my->dim, my->vars);
+    copy_n(u.data(), my->dim, ev.vars);
     for( index_t j=0; j!=d; ++j )
     {
         res(j,j) = exprtk::
-            second_derivative<T>( my->expression[coord], my->vars[j], 0.00001);
+            second_derivative<T>( ev.expression[coord], ev.vars[j], 0.00001);
 
         for( index_t k = 0; k!=j; ++k )
             res(k,j) = res(j,k) =
-                mixed_derivative<T>( my->expression[coord], my->vars[k],
-                                     my->vars[j], 0.00001 );
+                mixed_derivative<T>( ev.expression[coord], ev.vars[k],
+                                     ev.vars[j], 0.00001 );
     }
 #   endif
-}
     return res;
 }
 
@@ -682,22 +758,23 @@ gsMatrix<T> * gsFunctionExpr<T>::mderiv(const gsMatrix<T> & u,
     const short_t n = targetDim();
     gsMatrix<T> * res= new gsMatrix<T>(n,u.cols()) ;
 
-#   pragma omp critical (gsFunctionExpr_run)
+    typename PrivateData_t::LocalEvaluator lev(*my);
+    typename PrivateData_t::Evaluator & ev = *lev;
     for( index_t p=0; p!=res->cols(); ++p )
     {
 #       ifndef GISMO_WITH_ADIFF
-        copy_n(u.col(p).data(), my->dim, my->vars);
+        copy_n(u.col(p).data(), my->dim, ev.vars);
 #       endif
 
         for (short_t c = 0; c!= n; ++c) // for all components
         {
 #           ifdef GISMO_WITH_ADIFF
             for (index_t v = 0; v!=my->dim; ++v)
-                my->vars[v].setVariable(v, my->dim, u(v,p) );
-            (*res)(c,p) = my->expression[c].value().getHessian()(k,j); //note: can fail
+                ev.vars[v].setVariable(v, my->dim, u(v,p) );
+            (*res)(c,p) = ev.expression[c].value().getHessian()(k,j); //note: can fail
 #           else
             (*res)(c,p) =
-                mixed_derivative<T>( my->expression[c], my->vars[k], my->vars[j], 0.00001 ) ;
+                mixed_derivative<T>( ev.expression[c], ev.vars[k], ev.vars[j], 0.00001 ) ;
 #           endif
         }
     }
@@ -712,24 +789,25 @@ gsMatrix<T> gsFunctionExpr<T>::laplacian(const gsMatrix<T>& u) const
     const short_t n = targetDim();
     gsMatrix<T> res(n,u.cols());
 
-    #   pragma omp critical (gsFunctionExpr_run)
+    typename PrivateData_t::LocalEvaluator lev(*my);
+    typename PrivateData_t::Evaluator & ev = *lev;
     for( index_t p = 0; p != res.cols(); ++p )
     {
 #       ifndef GISMO_WITH_ADIFF
-        copy_n(u.col(p).data(), my->dim, my->vars);
+        copy_n(u.col(p).data(), my->dim, ev.vars);
 #       endif
 
         for (short_t c = 0; c!= n; ++c) // for all components
         {
 #           ifdef GISMO_WITH_ADIFF
             for (index_t v = 0; v!=my->dim; ++v)
-                my->vars[v].setVariable(v, my->dim, u(v,p) );
-            res(c,p) = my->expression[c].value().getHessian().trace();
+                ev.vars[v].setVariable(v, my->dim, u(v,p) );
+            res(c,p) = ev.expression[c].value().getHessian().trace();
 #           else
             T & val = res(c,p);
             for ( index_t j = 0; j!=my->dim; ++j )
                 val += exprtk::
-                    second_derivative<T>( my->expression[c], my->vars[j], 0.00001 );
+                    second_derivative<T>( ev.expression[c], ev.vars[j], 0.00001 );
 #           endif
         }
     }
@@ -223,6 +223,17 @@ public:
     // Look at gsFunction class for documentation
     virtual void deriv_into(const gsMatrix<T>& u, gsMatrix<T>& result) const;
 
+    /// @brief Same as gsFunction::evalParallel_into(), but the
+    /// points are first ordered by the element of the basis that
+    /// contains them, so that the chunks consist of points of few
+    /// elements. The active functions are computed once for every
+    /// run of points in the same element, and the coefficients
+    /// accessed by a chunk are few and stay in cache. If the basis
+    /// does not implement gsBasis::elementIndex(), the points are
+    /// evaluated in their given order.
+    void evalParallel_into(const gsMatrix<T>& u, gsMatrix<T>& result,
+                           int n = 0) const;
+
 
     /** @brief Evaluate second derivatives of the function at points \a u into \a result.
      *
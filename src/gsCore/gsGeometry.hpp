@@ -165,6 +165,82 @@ template<class T>
 void gsGeometry<T>::deriv_into(const gsMatrix<T>& u, gsMatrix<T>& result) const
 { this->basis().derivFunc_into(u, m_coefs, result); }
 
+template<class T>
+void gsGeometry<T>::evalParallel_into(const gsMatrix<T>& u, gsMatrix<T>& result,
+                                      int n) const
+{
+    GISMO_ASSERT(0==n || 1==n, "Only values (n=0) and first derivatives (n=1) are supported");
+    const index_t numPts = u.cols();
+    std::vector<index_t> order;
+    gsVector<T> pt;
+    if (0!=numPts)
+    {
+        // Exceptions may not leave a parallel region, therefore probe
+        // whether the basis implements elementIndex() beforehand
+        try { pt = u.col(0); this->basis().elementIndex(pt); }
+        catch (...) { this->evalChunks_into(u, order, result, n); return; }
+    }
+
+    std::vector<size_t> elem(numPts);
+#   pragma omp parallel for private(pt)
+    for (index_t j = 0; j < numPts; ++j)
+    {
+        pt = u.col(j);
+        elem[j] = this->basis().elementIndex(pt);
+    }
+    order.resize(numPts);
+    for (index_t j = 0; j != numPts; ++j)
+        order[j] = j;
+    std::stable_sort(order.begin(), order.end(),
+                     [&elem](index_t a, index_t b) { return elem[a] < elem[b]; });
+
+    const index_t tarDim = this->targetDim();
+    result.resize( (0==n ? 1 : this->domainDim()) * tarDim, numPts );
+    const index_t chunk = this->chunkSize(numPts);
+    const index_t numChunks = (numPts + chunk - 1) / chunk;
+
+#   pragma omp parallel
+    {
+        gsMatrix<T> pts, bVals, vals;
+        gsMatrix<index_t> act;
+#       pragma omp for schedule(dynamic,1)
+        for (index_t c = 0; c < numChunks; ++c)
+        {
+            const index_t last = math::min(numPts, (c+1)*chunk);
+            index_t sz;
+            for (index_t first = c*chunk; first < last; first += sz)
+            {
+                // The run of points in the element of the first one,
+                // which all have the same active functions
+                sz = 1;
+                while (first+sz < last && elem[order[first+sz]] == elem[order[first]])
+                    ++sz;
+                pts.resize(u.rows(), sz);
+                for (index_t j = 0; j != sz; ++j)
+                    pts.col(j) = u.col(order[first+j]);
+
+                this->basis().active_into(pts.col(0), act);
+                if (0==n)
+                    this->basis().eval_into(pts, bVals);
+                else
+                    this->basis().deriv_into(pts, bVals);
+
+                // Linear combination of the coefficients of the
+                // active functions, as in gsBasis::linearCombination_into()
+                const index_t stride = bVals.rows() / act.rows();
+                vals.setZero(tarDim * stride, sz);
+                for (index_t i = 0; i != act.rows(); ++i)
+                    for (index_t k = 0; k != tarDim; ++k)
+                        vals.middleRows(stride*k, stride).noalias() +=
+                            m_coefs(act(i,0), k) * bVals.middleRows(stride*i, stride);
+
+                for (index_t j = 0; j != sz; ++j)
+                    result.col(order[first+j]) = vals.col(j);
+            }
+        }
+    }
+}
+
 template<class T>
 void gsGeometry<T>::deriv2_into(const gsMatrix<T>& u, gsMatrix<T>& result) const
 { this->basis().deriv2Func_into(u, m_coefs, result); }
@@ -380,6 +380,14 @@ public:
     /// \param preim in each column,  the parametric coordinates of the corresponding point in the patch
     void locatePoints(const gsMatrix<T> & points, index_t pid1, gsVector<index_t> & pid2, gsMatrix<T> & preim) const;
 
+    /// @brief Evaluates the patches (\a n = 0) or their derivatives (\a n = 1)
+    /// at the parametric points \a preim, where column \a i lies on patch
+    /// \a pids[i], e.g. as returned by locatePoints(). Each patch
+    /// evaluates its points with gsGeometry::evalParallel_into(). Columns
+    /// with \a pids[i] equal to -1 are left uninitialized.
+    void evalParallel_into(const gsVector<index_t> & pids, const gsMatrix<T> & preim,
+                           gsMatrix<T> & result, int n = 0) const;
+
     T closestDistance(const gsVector<T> & pt,std::pair<index_t,gsVector<T> > & result,
                                                    const T accuracy = 1e-6) const;
 
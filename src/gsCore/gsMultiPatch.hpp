@@ -738,6 +738,34 @@ void gsMultiPatch<T>::locatePoints(const gsMatrix<T> & points,
     }
 }
 
+template<class T>
+void gsMultiPatch<T>::evalParallel_into(const gsVector<index_t> & pids,
+                                        const gsMatrix<T> & preim,
+                                        gsMatrix<T> & result, int n) const
+{
+    GISMO_ASSERT(pids.size()==preim.cols(), "Invalid number of patch indices");
+    result.resize( (0==n ? 1 : parDim()) * geoDim(), preim.cols() );
+
+    // Group the points by patch
+    std::vector<std::vector<index_t> > cols(m_patches.size());
+    for (index_t i = 0; i!=pids.size(); ++i)
+        if (-1 != pids[i])
+            cols[pids[i]].push_back(i);
+
+    gsMatrix<T> pts, vals;
+    for (size_t k = 0; k!= m_patches.size(); ++k)
+    {
+        const index_t np = cols[k].size();
+        if (0==np) continue;
+        pts.resize(preim.rows(), np);
+        for (index_t j = 0; j!=np; ++j)
+            pts.col(j) = preim.col(cols[k][j]);
+        m_patches[k]->evalParallel_into(pts, vals, n);
+        for (index_t j = 0; j!=np; ++j)
+            result.col(cols[k][j]) = vals.col(j);
+    }
+}
+
 template<class T>
 void gsMultiPatch<T>::locatePoints(const gsMatrix<T> & points, index_t pid1,
                                    gsVector<index_t> & pid2, gsMatrix<T> & preim) const
@@ -977,13 +977,12 @@ public:
         std::vector<index_t> box;
         box.push_back(atoi( tmp->first_attribute("level")->value() ));
 
-        std::istringstream str;
-        str.clear();
-        str.str( tmp->value() );
+        const char * str = tmp->value();
         unsigned c;
         for( unsigned i = 0; i < 2*d; i++)
         {
-            str>> c;
+            GISMO_ENSURE( gsGetInt(str, c),
+                          "XML Error: Expected "<<2*d<<" non-negative box indices." );
             box.push_back(c);
         }
 
@@ -26,6 +26,11 @@
 
 #include <gsUtils/gsSortedVector.h>
 
+#include <atomic>
+#include <deque>
+#include <thread>
+#include <unordered_map>
+
 namespace gismo
 {
 
@@ -298,6 +303,7 @@ public:
             freeAll( m_bases );
             m_bases.resize( o.m_bases.size() );
             cloneAll(o.m_bases.begin(), o.m_bases.end(), m_bases.begin());
+            m_activeCache.clear();
         }
         return *this;
     }
@@ -318,6 +324,7 @@ public:
         m_xmatrix_offset = std::move(other.m_xmatrix_offset);
         m_manualLevels   = std::move(other.m_manualLevels);
         m_uIndices   = std::move(other.m_uIndices);
+        m_activeCache.clear();
         return *this;
     }
 #endif
@@ -410,6 +417,114 @@ public:
     /// level \em k (i.e., those taken from \f$ B^k \f$) start.
     std::vector<index_t> m_xmatrix_offset;
 
+    /// \brief The active functions of an element
+    ///
+    /// All points of an element share the same active functions.
+    /// active_into() computes them once per element and stores them in
+    /// an ActiveTable under the key returned by elementKey().
+    struct ActiveEntry
+    {
+        ActiveEntry() : valid(false) { }
+        bool valid;                   ///< True iff \a actives is computed
+        std::vector<index_t> actives; ///< The active functions
+    };
+    typedef std::unordered_map<uint64_t, ActiveEntry> ActiveTable;
+
+    /// Maximum number of elements kept in a table of m_activeCache
+    static const size_t maxActiveTable = 1 << 14;
+
+    /// \brief Tables of the active functions, one per thread of the
+    /// OpenMP team
+    ///
+    /// The table of an OpenMP thread number belongs to the first
+    /// thread that asks for it. All other callers, e.g. a std::thread
+    /// or a thread of a nested team, get no table and use one that is
+    /// local to their call. The tables are filled on demand. clear()
+    /// only increments a counter, so the tables are emptied by their
+    /// owners on the next use; a table is also emptied when it holds
+    /// more than maxActiveTable elements. Copies start empty.
+    class ActiveCache
+    {
+    public:
+        ActiveCache() : m_slots(omp_get_max_threads()), m_generation(0) { }
+
+        ActiveCache(const ActiveCache &)
+        : m_slots(omp_get_max_threads()), m_generation(0) { }
+
+        ActiveCache & operator=(const ActiveCache &) { clear(); return *this; }
+
+        /// Invalidates all tables
+        void clear() { ++m_generation; }
+
+        /// Returns the table of the calling thread, or nullptr if it
+        /// has none
+        ActiveTable * mine() const
+        {
+            const size_t i = omp_get_thread_num();
+            if (i >= m_slots.size())
+                return nullptr;
+            Slot & slot = m_slots[i];
+            const std::thread::id me = std::this_thread::get_id();
+            std::thread::id none;
+            if ( me != slot.owner.load() && !slot.owner.compare_exchange_strong(none, me) )
+                return nullptr;
+            const unsigned gen = m_generation.load();
+            if ( gen != slot.generation || slot.table.size() > maxActiveTable )
+            {
+                slot.table.clear();
+                slot.generation = gen;
+            }
+            return &slot.table;
+        }
+
+    private:
+        /// A table together with the thread that uses it
+        struct Slot
+        {
+            Slot() : owner(std::thread::id()), generation(0) { }
+            std::atomic<std::thread::id> owner;
+            unsigned generation;  ///< Value of m_generation when filled
+            ActiveTable table;
+        };
+
+        mutable std::vector<Slot> m_slots;
+        std::atomic<unsigned>     m_generation;
+    };
+    ActiveCache m_activeCache;
+
+    /// \brief Computes the key in an ActiveTable of the element of
+    /// level \a lvl that contains the point \a pt. Returns false if
+    /// the element indices do not fit in the key.
+    bool elementKey(const gsMatrix<T> & pt, int lvl, uint64_t & key) const
+    {
+        if (lvl >= 64) // the level takes the lowest 6 bits
+            return false;
+        const tensorBasis & tb = *m_bases[lvl];
+        key = 0;
+        for (short_t i = d-1; i >= 0; --i)
+        {
+            const uint64_t n = tb.knots(i).uSize();
+            if (key >= (uint64_t(1) << 58) / n) // key * n + (n-1) overflows
+                return false;
+            key = key * n + tb.knots(i).uFind( pt(i,0) ).uIndex();
+        }
+        key = (key << 6) | lvl;
+        return true;
+    }
+
+    /// \brief Returns the entry of \a table of the element of
+    /// level \a lvl that contains the point \a pt. If the element has
+    /// no key, a new entry is appended to \a uncached instead.
+    ActiveEntry & activeEntry(ActiveTable & table, std::deque<ActiveEntry> & uncached,
+                              const gsMatrix<T> & pt, int lvl) const
+    {
+        uint64_t key;
+        if ( elementKey(pt, lvl, key) )
+            return table[key];
+        uncached.push_back( ActiveEntry() );
+        return uncached.back();
+    }
+
     //------------------------------------
 
 public:
@@ -1310,6 +1310,9 @@ void gsHTensorBasis<d,T>::update_structure() // to do: rename as updateHook
     // Make sure we have computed enough levels
     needLevel( m_tree.getMaxInsLevel() );
 
+    // Forget the active functions of the old elements
+    m_activeCache.clear();
+
     // Setup the characteristic matrices
     m_xmatrix.clear();
     m_xmatrix.resize( m_tree.getMaxInsLevel()+1 );
@@ -1385,8 +1388,12 @@ void gsHTensorBasis<d,T>::active_into(const gsMatrix<T> & u, gsMatrix<index_t>&
     gsMatrix<T> currPoint;
     point low, upp, cur;
     const int maxLevel = m_tree.getMaxInsLevel();
+    ActiveTable * cached = m_activeCache.mine();
+    ActiveTable local; // for callers without a table of their own
+    ActiveTable & table = cached ? *cached : local;
+    std::deque<ActiveEntry> uncached;
 
-    std::vector<std::vector<index_t> > temp_output;//collects the outputs
+    std::vector<const std::vector<index_t>*> temp_output;//collects the outputs
     temp_output.resize( u.cols() );
     size_t sz = 0;
 
@@ -1403,45 +1410,54 @@ void gsHTensorBasis<d,T>::active_into(const gsMatrix<T> & u, gsMatrix<index_t>&
 
         // Identify the level of the point
         const int lvl = m_tree.levelOf(low, maxLevel);
-        for(int i = 0; i <= lvl; i++)
-        {
-            /*
-              m_bases[i]->active_into(currPoint, activesLvl);
 
-              std::set_intersection(m_xmatrix[i].begin(), m_xmatrix[i].end(),
-              activesLvl.data(), activesLvl.data() + activesLvl.size(),
-              std::back_inserter( temp_output[p] ) );
-              +++ Renumbering to H-basis indexing
-            */
-
-            m_bases[i]->active_cwise(currPoint, low, upp);
-            cur = low;
-            do
+        // Look up the element of the point, compute its actives if new
+        ActiveEntry & entry = activeEntry(table, uncached, currPoint, lvl);
+        std::vector<index_t> & act = entry.actives;
+        if ( !entry.valid )
+        {
+            entry.valid = true;
+            for(int i = 0; i <= lvl; i++)
             {
-                CMatrix::const_iterator it =
-                    m_xmatrix[i].find_it_or_fail( m_bases[i]->index(cur) );
-
-                if( it != m_xmatrix[i].end() )// if index is found
+                /*
+                  m_bases[i]->active_into(currPoint, activesLvl);
+
+                  std::set_intersection(m_xmatrix[i].begin(), m_xmatrix[i].end(),
+                  activesLvl.data(), activesLvl.data() + activesLvl.size(),
+                  std::back_inserter( temp_output[p] ) );
+                  +++ Renumbering to H-basis indexing
+                */
+
+                m_bases[i]->active_cwise(currPoint, low, upp);
+                cur = low;
+                do
                 {
-                    temp_output[p].push_back(
-                        this->m_xmatrix_offset[i] + (it - m_xmatrix[i].begin() )
-                        );
+                    CMatrix::const_iterator it =
+                        m_xmatrix[i].find_it_or_fail( m_bases[i]->index(cur) );
+
+                    if( it != m_xmatrix[i].end() )// if index is found
+                    {
+                        act.push_back(
+                            this->m_xmatrix_offset[i] + (it - m_xmatrix[i].begin() )
+                            );
+                    }
                 }
+                while( nextCubePoint(cur,low,upp) );
             }
-            while( nextCubePoint(cur,low,upp) );
         }
+        temp_output[p] = &act;
 
         // update result size
-        if ( temp_output[p].size() > sz )
-            sz = temp_output[p].size();
+        if ( act.size() > sz )
+            sz = act.size();
     }
 
     result.resize(sz, u.cols() );
     for(index_t i = 0; i < result.cols(); i++)
     {
-        result.col(i).topRows(temp_output[i].size())
-            = gsAsConstVector<index_t>(temp_output[i]);
-        result.col(i).bottomRows(sz-temp_output[i].size()).setZero();
+        result.col(i).topRows(temp_output[i]->size())
+            = gsAsConstVector<index_t>(*temp_output[i]);
+        result.col(i).bottomRows(sz-temp_output[i]->size()).setZero();
     }
 }
 
@@ -143,213 +143,36 @@ public:
                              const gsMatrix<T> & u,
                           gsMatrix<T>& result) const;
 
-    // look at eval_into
-    void fastEval_into(const gsMatrix<T>& u,
-                       gsMatrix<T>& result) const
-    {
-        gsMatrix<index_t> indices;
-        this->active_into(u, indices);
-
-        result.setZero(indices.rows(), u.cols());
-
-        const unsigned maxLvl = this->m_tree.getMaxInsLevel() + 1;
-        std::vector< gsMatrix<T> > tmpResults(maxLvl, gsMatrix<T>());
-        std::vector< gsMatrix<index_t> > tmpActive(maxLvl, gsMatrix<index_t>());
-        gsVector<int> processed(maxLvl);
-
-        for (int pt = 0; pt != u.cols(); pt++)
-        {
-            processed.setZero();
-
-            for (int ind = 0; ind != indices.rows(); ind++)
-            {
-                unsigned index = indices(ind, pt);
-                if (ind != 0 && index == 0)
-                    break;
-
-                unsigned lvl = getPresLevelOfBasisFun(index);
-
-                if (processed(lvl) == 0)
-                {
-                    this->m_bases[lvl]->eval_into(u.col(pt), tmpResults[lvl]);
-                    this->m_bases[lvl]->active_into(u.col(pt), tmpActive[lvl]);
-                    processed(lvl) = 1;
-                }
-
-                if (m_is_truncated[index] == -1)
-                {
-                    index_t flatTenIndx = this->flatTensorIndexOf(index, lvl);
-                    int localIndex = -1;
-                    for (int row = 0; row != tmpActive[lvl].rows(); ++row)
-                    {
-                        if (tmpActive[lvl](row, 0) == flatTenIndx)
-                        {
-                            localIndex = row;
-                            break;
-                        }
-                    }
-                    result(ind, pt) = tmpResults[lvl](localIndex, 0);
-                }
-                else // basis function is truncated
-                {
-                    const gsMatrix<T>& basis = tmpResults[lvl];
-                    const gsMatrix<index_t>& active = tmpActive[lvl];
-
-
-                    const gsSparseVector<T>& coefs = getCoefs(index);
-                    T tmp = coefs(active(0, 0)) * basis(0, 0);
-                    for (int i = 1; i < active.rows(); i++)
-                    {
-                        tmp += coefs(active(i, 0)) * basis(i, 0);
-                    }
-                    result(ind, pt) = tmp;
-                }
-            }
-        }
-    }
-
-    // look at deriv_into
-    void fastDeriv_into(const gsMatrix<T>& u,
-                        gsMatrix<T>& result) const
-    {
-        gsMatrix<index_t> indices;
-        this->active_into(u, indices);
+    /// Same as eval_into(), kept for compatibility
+    GISMO_DEPRECATED void fastEval_into(const gsMatrix<T>& u,
+                                        gsMatrix<T>& result) const
+    { this->eval_into(u, result); }
 
-        result.setZero(indices.rows() * d, u.cols());
+    /// Same as deriv_into(), kept for compatibility
+    GISMO_DEPRECATED void fastDeriv_into(const gsMatrix<T>& u,
+                                         gsMatrix<T>& result) const
+    { this->deriv_into(u, result); }
 
-        const unsigned maxLvl = this->m_tree.getMaxInsLevel() + 1;
-        std::vector< gsMatrix<T> > tmpDeriv( maxLvl, gsMatrix<T>());
-        std::vector< gsMatrix<index_t> > tmpActive(maxLvl, gsMatrix<index_t>());
-        gsVector<int> processed(maxLvl);
-
-        for (index_t pt = 0; pt != u.cols(); pt++)
-        {
-            processed.setZero();
-
-            for (int ind = 0; ind != indices.rows(); ind++)
-            {
-                index_t index = indices(ind, pt);
-                if (ind != 0 && index == 0)
-                    break;
-
-                unsigned lvl = getPresLevelOfBasisFun(index);
-
-                if (processed(lvl) == 0)
-                {
-                    this->m_bases[lvl]->deriv_into(u.col(pt), tmpDeriv[lvl]);
-                    this->m_bases[lvl]->active_into(u.col(pt), tmpActive[lvl]);
-                    processed(lvl) = 1;
-                }
-
-                if (m_is_truncated[index] == -1)
-                {
-                    index_t flatTenIndx = this->flatTensorIndexOf(index, lvl);
-                    int localIndex = -1;
-                    for (int row = 0; row != tmpActive[lvl].rows(); ++row)
-                    {
-                        if (tmpActive[lvl](row, 0) == flatTenIndx)
-                        {
-                            localIndex = row;
-                            break;
-                        }
-                    }
-
-                    result.block(ind * d, pt, d, 1) =
-                            tmpDeriv[lvl].block(localIndex * d, 0, d, 1);
-                }
-                else // basis function is truncated
-                {
-                    const gsMatrix<T>& basis = tmpDeriv[lvl];
-                    const gsMatrix<index_t>& active = tmpActive[lvl];
-                    const gsSparseVector<T>& coefs = getCoefs(index);
-
-                    for (unsigned dim = 0; dim != d; dim++) // for all deric
-                    {
-                        for (index_t i = 0; i != active.rows(); ++i)
-                        {
-                            result(ind * d + dim, pt) +=
-                                    coefs(active(i, 0)) * basis(i * d + dim, 0);
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    // look at deriv2_into
-    void fastDeriv2_into(const gsMatrix<T>& u,
-                         gsMatrix<T>& result) const
-    {
-        gsMatrix<index_t> indices;
-        this->active_into(u, indices);
-        const unsigned numDers = (d * (d + 1)) / 2;
-
-        result.setZero(indices.rows() * numDers, u.cols());
-
-        const unsigned maxLvl = this->m_tree.getMaxInsLevel() + 1;
-        std::vector< gsMatrix<T> > tmpDeriv2(maxLvl, gsMatrix<T>());
-        std::vector< gsMatrix<index_t> > tmpActive(maxLvl, gsMatrix<index_t>());
-        gsVector<int> processed(maxLvl);
-
-        for (int pt = 0; pt != u.cols(); pt++)
-        {
-            processed.setZero();
-
-            for (int ind = 0; ind != indices.rows(); ind++)
-            {
-
-                unsigned index = indices(ind, pt);
-                if (ind != 0 && index == 0)
-                    break;
-
-                unsigned lvl = getPresLevelOfBasisFun(index);
-
-                if (processed(lvl) == 0)
-                {
-                    this->m_bases[lvl]->deriv2_into(u.col(pt), tmpDeriv2[lvl]);
-                    this->m_bases[lvl]->active_into(u.col(pt), tmpActive[lvl]);
-                    processed(lvl) = 1;
-                }
-
-                if (m_is_truncated[index] == -1)
-                {
-                    index_t flatTenIndx = this->flatTensorIndexOf(index, lvl);
-                    int localIndx = -1;
-                    for (int row = 0; row != tmpActive[lvl].rows(); ++row)
-                    {
-                        if (tmpActive[lvl](row, 0) == flatTenIndx)
-                        {
-                            localIndx = row;
-                            break;
-                        }
-                    }
-
-                    result.block(ind * numDers, pt, numDers, 1) =
-                            tmpDeriv2[lvl].block(localIndx * numDers, 0, numDers, 1);
-                }
-                else // basis function is truncated
-                {
-                    const gsMatrix<T>& basis = tmpDeriv2[lvl];
-                    const gsMatrix<index_t>& active = tmpActive[lvl];
-                    const gsSparseVector<T>& coefs = getCoefs(index);
-
-                    for (unsigned der = 0; der != numDers; der++)
-                    {
-                        for (index_t i = 0; i != active.rows(); ++i)
-                        {
-                            result(ind * numDers + der, pt) +=
-                                    coefs(active(i, 0)) *
-                                    basis(i * numDers + der, 0);
-                        }
-                    }
-                }
-            }
-        }
-    }
+    /// Same as deriv2_into(), kept for compatibility
+    GISMO_DEPRECATED void fastDeriv2_into(const gsMatrix<T>& u,
+                                          gsMatrix<T>& result) const
+    { this->deriv2_into(u, result); }
 
     // Look at gsBasis class for documentation
     void eval_into(const gsMatrix<T> & u, gsMatrix<T>& result) const;
 
+    /// @brief Evaluates the active functions and their derivatives up
+    /// to order \a n at the points \a u.
+    ///
+    /// The tensor basis of every level that carries an active
+    /// function is evaluated once on the whole point set. Truncated
+    /// functions are then obtained as sparse products of their
+    /// coefficients with these values, instead of evaluating each
+    /// function separately. eval_into(), deriv_into() and
+    /// deriv2_into() use this routine.
+    void evalAllDers_into(const gsMatrix<T> & u, int n,
+                          std::vector<gsMatrix<T> >& result) const;
+
     // Because of overriding one of the "eval_into" functions, all
     // functions in the base class with this name are hidden from the
     // derived class: Compiler does not search the base class as soon
@@ -1085,8 +1085,12 @@ void gsTHBSplineBasis<d,T>::active_into(const gsMatrix<T>& u, gsMatrix<index_t>&
     gsMatrix<index_t> ind;
     point low, upp, cur;
     const int maxLevel = this->m_tree.getMaxInsLevel();
+    typename gsHTensorBasis<d,T>::ActiveTable * cached = this->m_activeCache.mine();
+    typename gsHTensorBasis<d,T>::ActiveTable local; // for callers without a table of their own
+    typename gsHTensorBasis<d,T>::ActiveTable & table = cached ? *cached : local;
+    std::deque<typename gsHTensorBasis<d,T>::ActiveEntry> uncached;
 
-    std::vector<std::vector<index_t> > temp_output;//collects the outputs
+    std::vector<const std::vector<index_t>*> temp_output;//collects the outputs
     temp_output.resize( u.cols() );
     size_t sz = 0;
 
@@ -1102,56 +1106,67 @@ void gsTHBSplineBasis<d,T>::active_into(const gsMatrix<T>& u, gsMatrix<index_t>&
         // Identify the level of the point
         const int lvl = std::min(this->m_tree.levelOf(low, maxLevel),(int) m_xmatrix.size()-1);
 
-        for(int i = 0; i <= lvl; i++)
+        // Look up the element of the point, compute its actives if new.
+        // A truncated function vanishes either on the whole element or
+        // nowhere on it, so the test below holds for all its points
+        typename gsHTensorBasis<d,T>::ActiveEntry & entry =
+            this->activeEntry(table, uncached, currPoint, lvl);
+        std::vector<index_t> & act = entry.actives;
+        if ( !entry.valid )
         {
-            m_bases[i]->active_cwise(currPoint, low, upp);
-            cur = low;
-            do
+            entry.valid = true;
+            for(int i = 0; i <= lvl; i++)
             {
-                typename CMatrix::const_iterator it =
-                    m_xmatrix[i].find_it_or_fail( m_bases[i]->index(cur) );
-
-                if( it != m_xmatrix[i].end() )// if index is found
+                m_bases[i]->active_cwise(currPoint, low, upp);
+                cur = low;
+                do
                 {
-                    const index_t act = this->m_xmatrix_offset[i] + (it - m_xmatrix[i].begin());
+                    typename CMatrix::const_iterator it =
+                        m_xmatrix[i].find_it_or_fail( m_bases[i]->index(cur) );
 
-                    if (this->m_is_truncated[act] == -1) 
-                    {
-                        temp_output[p].push_back(act);
-                    }
-                    else 
+                    if( it != m_xmatrix[i].end() )// if index is found
                     {
-                        const gsSparseVector<T>& coefs = getCoefs(act);
-                        const gsTensorBSplineBasis<d, T>& base =
-                            *this->m_bases[this->m_is_truncated[act]];
-
-                        base.active_into(currPoint, ind);
+                        const index_t a = this->m_xmatrix_offset[i] + (it - m_xmatrix[i].begin());
 
-                        for (index_t k = 0; k < ind.rows(); ++k) 
+                        if (this->m_is_truncated[a] == -1) 
                         {
-                            if (coefs(ind.at(k)) != 0)
+                            act.push_back(a);
+                        }
+                        else 
+                        {
+                            const gsSparseVector<T>& coefs = getCoefs(a);
+                            const gsTensorBSplineBasis<d, T>& base =
+                                *this->m_bases[this->m_is_truncated[a]];
+
+                            base.active_into(currPoint, ind);
+
+                            for (index_t k = 0; k < ind.rows(); ++k) 
                             {
-                                temp_output[p].push_back(act);
-                                break;
+                                if (coefs(ind.at(k)) != 0)
+                                {
+                                    act.push_back(a);
+                                    break;
+                                }
                             }
                         }
                     }
                 }
+                while( nextCubePoint(cur,low,upp) );
             }
-            while( nextCubePoint(cur,low,upp) );
         }
+        temp_output[p] = &act;
 
         // update result size
-        if ( temp_output[p].size() > sz )
-            sz = temp_output[p].size();
+        if ( act.size() > sz )
+            sz = act.size();
     }
 
     result.resize(sz, u.cols() );
     for(index_t i = 0; i < result.cols(); i++)
     {
-        result.col(i).topRows(temp_output[i].size())
-            = gsAsConstVector<index_t>(temp_output[i]);
-        result.col(i).bottomRows(sz-temp_output[i].size()).setZero();
+        result.col(i).topRows(temp_output[i]->size())
+            = gsAsConstVector<index_t>(*temp_output[i]);
+        result.col(i).bottomRows(sz-temp_output[i]->size()).setZero();
     }
 }
 
@@ -1208,75 +1223,97 @@ void gsTHBSplineBasis<d,T>::deriv2Single_into(index_t i,
 template<short_t d, class T>
 void gsTHBSplineBasis<d,T>::eval_into(const gsMatrix<T> & u, gsMatrix<T>& result) const
 {
-    gsMatrix<index_t> indices;
-    gsMatrix<T> res(1, 1);
-    this->active_into(u, indices);
-
-    result.setZero(indices.rows(), u.cols());
-
-    for (index_t i = 0; i < indices.cols(); i++)
-    {
-        for (index_t j = 0; j < indices.rows(); j++)
-        {
-            const index_t index = indices(j, i);
-            if (j != 0 && index == 0)
-                break;
+    std::vector<gsMatrix<T> > ev;
+    this->evalAllDers_into(u, 0, ev);
+    result.swap(ev[0]);
+}
 
-            evalSingle_into(index, u.col(i), res);
-            result(j, i) = res.value();
-        }
-    }
+template<short_t d, class T>
+void gsTHBSplineBasis<d,T>::deriv2_into(const gsMatrix<T>& u, gsMatrix<T>& result)const
+{
+    std::vector<gsMatrix<T> > ev;
+    this->evalAllDers_into(u, 2, ev);
+    result.swap(ev[2]);
 }
 
+template<short_t d, class T>
+void gsTHBSplineBasis<d,T>::deriv_into(const gsMatrix<T>& u, gsMatrix<T>& result) const
+{
+    std::vector<gsMatrix<T> > ev;
+    this->evalAllDers_into(u, 1, ev);
+    result.swap(ev[1]);
+}
 
 template<short_t d, class T>
-void gsTHBSplineBasis<d,T>::deriv2_into(const gsMatrix<T>& u, gsMatrix<T>& result)const
+void gsTHBSplineBasis<d,T>::evalAllDers_into(const gsMatrix<T> & u, int n,
+                                             std::vector<gsMatrix<T> >& result) const
 {
     gsMatrix<index_t> indices;
     this->active_into(u, indices);
+    result.resize(n+1);
 
-    static const short_t numDers = (d * (d + 1)) / 2;
-    gsMatrix<T> res(numDers, 1); // result of deriv2Single_into
-
-    result.setZero(indices.rows() * numDers, u.cols());
-
-    for (int i = 0; i < indices.cols(); i++)
-    {
-        for (int j = 0; j < indices.rows(); j++)
+    // Levels at which the active functions are represented
+    const size_t numLevels = this->m_bases.size();
+    std::vector<bool> needed(numLevels, false);
+    for (index_t i = 0; i < indices.cols(); i++)
+        for (index_t j = 0; j < indices.rows(); j++)
         {
             const index_t index = indices(j, i);
             if (j != 0 && index == 0)
                 break;
-
-            this->deriv2Single_into(index, u.col(i), res);
-
-            result.template block<numDers, 1>(j * numDers, i) = res;
+            needed[getPresLevelOfBasisFun(index)] = true;
         }
-    }
-}
-
-
-template<short_t d, class T>
-void gsTHBSplineBasis<d,T>::deriv_into(const gsMatrix<T>& u, gsMatrix<T>& result) const
-{
 
-    gsMatrix<index_t> indices;
-    this->active_into(u, indices);
-    gsMatrix<T> res(d, 1);
+    // Evaluate each of these tensor levels once on all points
+    std::vector<std::vector<gsMatrix<T> > > lvlVals(numLevels);
+    std::vector<gsMatrix<index_t> > lvlAct(numLevels);
+    std::vector<index_t> stride(n+1, 0);
+    for (size_t lvl = 0; lvl != numLevels; ++lvl)
+    {
+        if (!needed[lvl]) continue;
+        this->m_bases[lvl]->evalAllDers_into(u, n, lvlVals[lvl]);
+        this->m_bases[lvl]->active_into(u, lvlAct[lvl]);
+        for (int k = 0; k <= n; ++k)
+            stride[k] = lvlVals[lvl][k].rows() / lvlAct[lvl].rows();
+    }
 
-    result.setZero(indices.rows() * d, u.cols());
+    for (int k = 0; k <= n; ++k)
+        result[k].setZero(indices.rows() * stride[k], u.cols());
 
-    for (int i = 0; i < indices.cols(); i++)
+    for (index_t i = 0; i < indices.cols(); i++)
     {
-        for (int j = 0; j < indices.rows(); j++)
+        for (index_t j = 0; j < indices.rows(); j++)
         {
-
-            const unsigned index = indices(j, i);
+            const index_t index = indices(j, i);
             if (j != 0 && index == 0)
                 break;
 
-            this->derivSingle_into(index, u.col(i), res);
-            result.template block<d,1>(j * d, i) = res;
+            const unsigned lvl = getPresLevelOfBasisFun(index);
+            const std::vector<gsMatrix<T> > & vals = lvlVals[lvl];
+            const gsMatrix<index_t> & act = lvlAct[lvl];
+
+            if (this->m_is_truncated[index] == -1)
+            {
+                // The tensor actives are sorted, locate the function
+                const index_t * first = act.col(i).data();
+                const index_t loc = std::lower_bound(first, first + act.rows(),
+                                     this->flatTensorIndexOf(index, lvl)) - first;
+                for (int k = 0; k <= n; ++k)
+                    result[k].block(j * stride[k], i, stride[k], 1) =
+                        vals[k].block(loc * stride[k], i, stride[k], 1);
+            }
+            else // basis function is truncated
+            {
+                const gsSparseVector<T>& coefs = getCoefs(index);
+                for (index_t r = 0; r != act.rows(); ++r)
+                {
+                    const T c = coefs.coeff(act(r, i));
+                    if (0 == c) continue;
+                    for (int k = 0; k <= n; ++k)
+                        result[k].block(j * stride[k], i, stride[k], 1).noalias() +=
+                            c * vals[k].block(r * stride[k], i, stride[k], 1);
+                }
+            }
         }
     }
 }
@@ -253,8 +253,16 @@ bool gsFileData<T>::readGismoXmlStream(std::istream & is, bool recursive)
 {
     m_buffer.emplace_back();
     std::vector<char> & buffer = m_buffer.back();
-    buffer.assign( std::istreambuf_iterator<char>(is.rdbuf() ),
-                   std::istreambuf_iterator<char>() );
+    // Read in large blocks, the values are parsed in place later on
+    const size_t blockSize = 1 << 20;
+    size_t size = 0;
+    do
+    {
+        buffer.resize(size + blockSize);
+        is.read(&buffer[size], blockSize);
+        size += is.gcount();
+    } while ( is );
+    buffer.resize(size);
     buffer.push_back('\0');
     // Load file contents
     data->parse<0>(&buffer[0], true);
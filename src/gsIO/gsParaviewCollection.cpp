@@ -12,10 +12,101 @@
 */
 
 #include <gsIO/gsParaviewCollection.h>
+#include <gsParallel/gsOpenMP.h>
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 namespace gismo
 {
+    // Writes the files of finalized data sets in a background thread,
+    // in the order in which they were added.
+    class gsParaviewCollection::writer
+    {
+    public:
+        writer() : m_busy(false), m_stop(false)
+        {
+            m_thread = std::thread(&writer::run, this);
+        }
+
+        // Writes the remaining data sets before returning
+        ~writer()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_cond.notify_all();
+            m_thread.join();
+        }
+
+        void push(gsParaviewDataSet && dataSet)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_queue.push_back(give(dataSet));
+            }
+            m_cond.notify_all();
+        }
+
+        // Blocks until all data sets are written, rethrows the first
+        // exception raised while writing
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait(lock, [this]{ return m_queue.empty() && !m_busy; });
+            if (m_error)
+            {
+                std::exception_ptr error = m_error;
+                m_error = nullptr;
+                std::rethrow_exception(error);
+            }
+        }
+
+    private:
+        void run()
+        {
+            // The writing should not compete with the computation
+            omp_set_num_threads(1);
+            std::unique_lock<std::mutex> lock(m_mutex);
+            for (;;)
+            {
+                m_cond.wait(lock, [this]{ return m_stop || !m_queue.empty(); });
+                if (m_queue.empty())
+                    return; // stopped
+                gsParaviewDataSet dataSet = give(m_queue.front());
+                m_queue.pop_front();
+                m_busy = true;
+                lock.unlock();
+                std::exception_ptr error;
+                try
+                {
+                    dataSet.writeFiles();
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                lock.lock();
+                if (error && !m_error) // keep the first one for wait()
+                    m_error = error;
+                m_busy = false;
+                m_cond.notify_all();
+            }
+        }
+
+    private:
+        std::deque<gsParaviewDataSet> m_queue;
+        bool m_busy, m_stop;
+        std::exception_ptr m_error;
+        std::mutex m_mutex;
+        std::condition_variable m_cond;
+        std::thread m_thread;
+    };
+
     // EVERY PATCH NEEDS TO BE PUT INTO ITS OWN "PART" THUS ITS OWN <DATASET>
     // The part does not need to be specified as long as the <DataSet> appear
     // in the same order for each timestep
@@ -27,8 +118,21 @@ namespace gismo
         GISMO_ENSURE(!dataSet.isEmpty(), "The gsParaviewDataSet you are trying to add is empty!");
         GISMO_ASSERT(time>=0, "Time should be a non-negative real number.");
 
-        if (! dataSet.isSaved()) dataSet.save(); // the actual files are written to disk/finalized
-        std::vector<std::string> filenames( dataSet.filenames() );
+        std::vector<std::string> filenames;
+        if (! dataSet.isSaved() && m_options.askSwitch("async",false))
+        {
+            // the data is sampled here, the files are written in the background
+            dataSet.finalize();
+            filenames = dataSet.filenames();
+            if (!m_writer)
+                m_writer = memory::make_shared(new writer());
+            m_writer->push(give(dataSet));
+        }
+        else
+        {
+            if (! dataSet.isSaved()) dataSet.save(); // the actual files are written to disk/finalized
+            filenames = dataSet.filenames();
+        }
 
         time = time==-1 ? m_time : time;
         mfile << "<!-- Time = " << time << " -->\n"; 
@@ -55,6 +159,12 @@ namespace gismo
         }
     }
 
+    void gsParaviewCollection::wait()
+    {
+        if (m_writer)
+            m_writer->wait();
+    }
+
     void gsParaviewCollection::newTimeStep(gsMultiPatch<real_t> * geometry, real_t time)
     {   
         GISMO_ASSERT( m_dataset.isEmpty() || m_dataset.isSaved(), "Previous timestep has not been saved. try running saveTimeStep() before newTimeStep().");
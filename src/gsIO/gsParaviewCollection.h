@@ -49,6 +49,8 @@ namespace gismo {
     pc.options().setInt("precision",5);
     pc.options().setSwitch("plotElements",true);
     pc.options().setSwitch("plotControlNet",true);
+    pc.options().setString("format","appended"); // raw binary data
+    pc.options().setSwitch("compress",true);       // compressed by zlib
 
     // In your solution loop:
     while ( ... )
@@ -66,6 +68,14 @@ namespace gismo {
     pc.save() // finalize and close the .pvd file
     \endverbatim
 
+    With the option "async" set, saveTimeStep() only samples the
+    geometry and hands the data over to a background thread, which
+    writes the files while the next time step is computed; save()
+    waits until all files are written:
+    \verbatim
+    pc.options().setSwitch("async",true);
+    \endverbatim
+
 
     The above creates a file with extension pvd. When opening this
     file with Paraview, the contents of all parts in the list are
@@ -198,6 +208,7 @@ public:
         GISMO_ASSERT(!m_isSaved, "Error: gsParaviewCollection::save() already called." );
         if (!m_isSaved)
         {
+            wait();
             mfile <<"</Collection>\n";
             mfile <<"</VTKFile>\n";
 
@@ -212,6 +223,11 @@ public:
         }
     }
 
+    /// @brief Blocks until the files of all time steps are written
+    /// (see option "async"). An exception raised while writing in the
+    /// background is rethrown here, and thus also by save().
+    void wait();
+
     /// @brief Accessor to the current options.
     gsOptionList & options() {return m_options;}
 
@@ -235,6 +251,10 @@ private:
 
     index_t counter;
 
+    /// Writes the files of the time steps in the background (option "async")
+    class writer;
+    memory::shared_ptr<writer> m_writer;
+
 private:
     // Construction without a filename is not allowed
     gsParaviewCollection();
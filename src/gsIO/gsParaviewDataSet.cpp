@@ -13,6 +13,7 @@
 
 #include<gsIO/gsParaviewDataSet.h>
 #include<gsIO/gsWriteParaview.h>
+#include<gsIO/gsVtkDataArrays.h>
 
 
 
@@ -32,32 +33,20 @@ namespace gismo
 
         // QUESTION: Can I be certain that the ids are consecutive?
         initFilenames();
+        m_data.resize(m_geometry->nPieces());
         for ( index_t k=0; k!=m_geometry->nPieces(); k++) // For every patch.
         {
             gsMatrix<real_t> activeBases = m_geometry->piece(k).support();
             gsGridIterator<real_t,CUBE> pt(activeBases, nPts);
 
             const gsVector<index_t> & np( pt.numPointsCwise() );
-            index_t np1 = (np.size()>1 ? np(1)-1 : 0);
-            index_t np2 = (np.size()>2 ? np(2)-1 : 0);
-
-            // initializes individual .vts files
-            // for every patch
-            std::ofstream file(m_filenames[k].c_str());
-            file << std::fixed; // no exponents
-            file << std::setprecision(5); // PLOT_PRECISION
-            file <<"<?xml version=\"1.0\"?>\n";
-            file <<"<VTKFile type=\"StructuredGrid\" version=\"0.1\">\n";
-            file <<"<StructuredGrid WholeExtent=\"0 "<< np(0)-1<<" 0 "<< np1 <<" 0 "
-                << np2 <<"\">\n";
-            file <<"<Piece Extent=\"0 "<< np(0)-1<<" 0 "<<np1<<" 0 "
-                << np2 <<"\">\n";
-            file <<"<PointData>\n";
-            file.close();
+            gsVector<index_t> & extent = m_data[k].extent;
+            extent.setOnes(3);
+            extent.head(np.size()) = np;
         }
     }
 
-    
+
     const std::vector<std::string> gsParaviewDataSet::filenames()
     {
         return m_filenames;
@@ -69,47 +58,98 @@ namespace gismo
         GISMO_ASSERT( !m_isSaved, "gsParaviewDataSet already saved.");
         if (!m_isSaved)
         {
-            m_isSaved = true; 
+            finalize();
+            writeFiles();
+        }
+    }
 
-            unsigned nPts = m_options.askInt("numPoints",1000);
-            unsigned precision = m_options.askInt("precision",5);
-            bool plotElements   = m_options.askSwitch("plotElements", false);
-            bool plotControlNet = m_options.askSwitch("plotControlNet", false);
+    void gsParaviewDataSet::finalize()
+    {
+        GISMO_ASSERT( !m_isSaved, "gsParaviewDataSet already saved.");
+        if (m_isSaved)
+            return;
+        m_isSaved = true;
+
+        unsigned nPts = m_options.askInt("numPoints",1000);
+        bool plotElements   = m_options.askSwitch("plotElements", false);
+        bool plotControlNet = m_options.askSwitch("plotControlNet", false);
 
-            std::vector<std::string> points = toVTK(*m_geometry,nPts,precision); //m_evaltr->geoMap2vtk(*m_geometry,nPts, precision);
-            // QUESTION: Can I be certain that the ids are consecutive?
-            for ( index_t k=0; k!=m_geometry->nPieces(); k++) // For every patch.
+        std::vector<gsMatrix<real_t> > points = toVTK(*m_geometry,nPts); //m_evaltr->geoMap2vtk(*m_geometry,nPts, precision);
+        const index_t n = m_geometry->nPieces();
+        for ( index_t k=0; k!=n; k++) // For every patch.
+            m_data[k].points.swap(points[k]);
+
+        if (plotControlNet || plotElements)
+        {
+#           pragma omp parallel for schedule(dynamic,1)
+            for ( index_t k=0; k < n; k++) // For every patch.
             {
-                std::ofstream file;
-                file.open(m_filenames[k].c_str(), std::ios_base::app); // Append to file 
-                file <<"</PointData>\n\n\n<!-- GEOMETRY -->\n<Points>\n";
-                file << points[k];
-                file << "</Points>\n</Piece>\n</StructuredGrid>\n</VTKFile>";
-                file.close();
+                const gsGeometry<real_t> & patch = static_cast<const gsGeometry<real_t>&>(m_geometry->piece(k));
                 if (plotControlNet)
-                {
-                    writeSingleControlNet( m_geometry->piece(k), m_basename + "_cnet" + std::to_string(k));
-                    m_filenames.push_back( m_basename + "_cnet" + std::to_string(k)+".vtp");
-                } 
+                    writeSingleControlNet( patch, m_basename + "_cnet" + std::to_string(k));
                 if ( plotElements)
                 {
                     int numPoints = m_options.getInt("plotElements.resolution");
                     if (-1 == numPoints )
                     {
-                        const real_t evalPtsPerElem = 16 * (1.0 / m_geometry->piece(k).basis().numElements());
+                        const real_t evalPtsPerElem = 16 * (1.0 / patch.basis().numElements());
 
                         // copied from gsWriteParaview
                         numPoints = cast<real_t,int>(
-                            static_cast<real_t>(math::max( m_geometry->piece(k).basis().maxDegree()-1, (short_t)1))
+                            static_cast<real_t>(math::max( patch.basis().maxDegree()-1, (short_t)1))
                             * math::pow(evalPtsPerElem, (real_t)(1.0)/static_cast<real_t>(m_geometry->domainDim())) );
                     }
-                    gsMesh<real_t> msh( gsMultiBasis<real_t>(*m_geometry).basis(k), numPoints);
-                    static_cast<const gsGeometry<real_t>&>(m_geometry->piece(k)).evaluateMesh(msh);
+                    gsMesh<real_t> msh( patch.basis(), numPoints);
+                    patch.evaluateMesh(msh);
                     gsWriteParaview(msh, m_basename + "_mesh" + std::to_string(k), false);
-                    m_filenames.push_back( m_basename + "_mesh" + std::to_string(k)+".vtp");
                 }
             }
-            // output text files for each part.
+        }
+
+        // The file names, in the order of the patches
+        for ( index_t k=0; k!=n; k++)
+        {
+            if (plotControlNet)
+                m_filenames.push_back( m_basename + "_cnet" + std::to_string(k)+".vtp");
+            if ( plotElements)
+                m_filenames.push_back( m_basename + "_mesh" + std::to_string(k)+".vtp");
+        }
+    }
+
+    void gsParaviewDataSet::writeFiles() const
+    {
+        GISMO_ASSERT( m_isSaved, "gsParaviewDataSet::finalize() has not been called.");
+        const unsigned precision = m_options.askInt("precision",5);
+        const gsVtkDataArrays::format format =
+            gsVtkDataArrays::formatFromString(m_options.askString("format","ascii"));
+        const bool compress = m_options.askSwitch("compress",false);
+
+        const index_t n = m_data.size();
+#       pragma omp parallel for schedule(dynamic,1)
+        for ( index_t k=0; k < n; k++) // For every patch.
+        {
+            const vtsData & data = m_data[k];
+            const gsVector<index_t> & np = data.extent;
+            gsVtkDataArrays arrays(format, compress);
+
+            std::ofstream file(m_filenames[k].c_str(), std::ios_base::out | std::ios_base::binary);
+            file << std::fixed; // no exponents
+            file << std::setprecision(precision);
+            file <<"<?xml version=\"1.0\"?>\n";
+            file <<"<VTKFile type=\"StructuredGrid\""<< arrays.fileAttributes() <<">\n";
+            file <<"<StructuredGrid WholeExtent=\"0 "<< np(0)-1<<" 0 "<< np(1)-1 <<" 0 "
+                << np(2)-1 <<"\">\n";
+            file <<"<Piece Extent=\"0 "<< np(0)-1<<" 0 "<<np(1)-1<<" 0 "
+                << np(2)-1 <<"\">\n";
+            file <<"<PointData>\n";
+            for (size_t f = 0; f != data.fields.size(); ++f)
+                arrays.write(file, data.fields[f], data.numComp[f], data.labels[f]);
+            file <<"</PointData>\n\n\n<!-- GEOMETRY -->\n<Points>\n";
+            arrays.write(file, data.points, 3);
+            file << "</Points>\n</Piece>\n</StructuredGrid>\n";
+            arrays.writeAppendedData(file);
+            file << "</VTKFile>";
+            file.close();
         }
     }
 
@@ -123,8 +163,19 @@ namespace gismo
         return m_isSaved;
     }
 
+    void gsParaviewDataSet::addData(index_t k, const std::string & label,
+                                    gsMatrix<real_t> & values, index_t numComp)
+    {
+        vtsData & data = m_data[k];
+        GISMO_ASSERT( values.cols() == data.extent.prod(), "Wrong number of values.");
+        data.labels.push_back(label);
+        data.fields.push_back(gsMatrix<real_t>());
+        data.fields.back().swap(values);
+        data.numComp.push_back(numComp);
+    }
+
     void gsParaviewDataSet::initFilenames()
-    {   
+    {
         std::vector<std::string> names;
         for ( index_t k=0; k!=m_geometry->nPieces(); k++) // For every patch.
         {
@@ -30,6 +30,15 @@ namespace gismo
     This class is used by gsParaviewCollection to manage said files, 
     but can be used by the user explicitly as well.
 
+    The fields are sampled when they are added and kept in memory
+    until the data set is saved; then all files are written at once.
+    The sampling of the geometry and of fields given as gsField, as
+    well as the writing of the files, run in parallel over the
+    patches. Saving can be split into finalize(), which samples the
+    geometry, and writeFiles(), which only accesses the data held by
+    the data set; gsParaviewCollection uses this to write the files
+    in a background thread.
+
     \ingroup IO
 */
 class GISMO_EXPORT gsParaviewDataSet // a collection of .vts files 
@@ -41,6 +50,17 @@ private:
     gsExprEvaluator<real_t> * m_evaltr;
     gsOptionList m_options;
     bool m_isSaved;
+
+    /// The sampled data of one .vts file
+    struct vtsData
+    {
+        gsVector<index_t> extent;               ///< Number of points in every direction
+        std::vector<std::string> labels;        ///< Names of the fields
+        std::vector<gsMatrix<real_t> > fields;  ///< Values of the fields, one column per point
+        std::vector<index_t> numComp;           ///< Number of components of the fields
+        gsMatrix<real_t> points;                ///< Points of the geometry
+    };
+    std::vector<vtsData> m_data; ///< The data of every patch
     
 public:
     /// @brief Basic constructor
@@ -60,7 +80,7 @@ public:
                         m_isSaved(false)
                         {}
                    
-    /// @brief Evaluates an expression, and writes that data to the vtk files.
+    /// @brief Evaluates an expression, the data is written to the vtk files by save().
     /// @tparam E 
     /// @param expr The gsExpression to be evaluated
     /// @param label The name that will be displayed in Paraview for this field.   
@@ -69,24 +89,15 @@ public:
                   std::string label)
     {
         GISMO_ENSURE( !m_isSaved, "You cannot add more fields if the gsParaviewDataSet has been saved.");
-        // evaluates the expression and appends it to the vts files
-        //for every patch
+        // evaluates the expression for every patch
         unsigned nPts = m_options.askInt("numPoints",1000);
-        unsigned precision = m_options.askInt("precision",5);
 
         //gsExprEvaluator<real_t> ev;
         //gsMultiBasis<real_t> mb(*m_geometry);
         //ev.setIntegrationElements(mb);
-        std::vector<std::string> tags = toVTK(expr,nPts,precision,label);
-        std::vector<std::string> fnames = filenames();
-
-        for ( index_t k=0; k!=m_geometry->nPieces(); k++) // For every patch.
-        {
-            std::ofstream file;
-            file.open( fnames[k].c_str(), std::ios_base::app); // Append to file
-            file << tags[k];
-            file.close(); 
-        }
+        std::vector<gsMatrix<real_t> > vals = toVTK(expr,nPts);
+        for ( size_t k=0; k!=vals.size(); k++) // For every patch.
+            addData(k, label, vals[k], vals[k].rows()==1 ? 1 : 3);
     }
 
     // Just here to stop the recursion
@@ -110,7 +121,7 @@ public:
         addFields(   newlabels, rest...);   // Recursion
     }
 
-    /// @brief Evaluates a gsField ( the function part ), and writes that data to the vtk files.
+    /// @brief Evaluates a gsField ( the function part ), the data is written to the vtk files by save().
     /// @tparam T
     /// @param field The gsField to be evaluated
     /// @param label The name that will be displayed in Paraview for this field.   
@@ -123,21 +134,12 @@ public:
                       field.nPieces() == m_geometry->nPieces() && 
                       field.patches().coefsSize() == m_geometry->coefsSize()),
                     "Provided gsField and stored geometry are not compatible!" );
-        // evaluates the field  and appends it to the vts files
-        //for every patch
+        // evaluates the field for every patch
         unsigned nPts = m_options.askInt("numPoints",1000);
-        unsigned precision = m_options.askInt("precision",5);
 
-        std::vector<std::string> tags = toVTK( field, nPts, precision, label);
-        std::vector<std::string> fnames = filenames();
-
-        for ( index_t k=0; k!=m_geometry->nPieces(); k++) // For every patch.
-        {
-            std::ofstream file;
-            file.open( fnames[k].c_str(), std::ios_base::app); // Append to file
-            file << tags[k];
-            file.close(); 
-        }
+        std::vector<gsMatrix<real_t> > vals = toVTK( field, nPts);
+        for ( size_t k=0; k!=vals.size(); k++) // For every patch.
+            addData(k, label, vals[k], 3);
     }
 
     /// @brief Recursive form of addField()
@@ -159,8 +161,23 @@ public:
     /// @return A vector of strings
     const std::vector<std::string> filenames();
 
+    /// @brief Samples the geometry and writes all files to disk.
     void save();
 
+    /// @brief Samples the geometry and writes the meshes and control
+    /// nets (if requested), but not the .vts files of the patches.
+    ///
+    /// Afterwards, no fields can be added and the data set holds all
+    /// data of the .vts files, which are written by writeFiles().
+    void finalize();
+
+    /// @brief Writes the .vts files of a finalized data set, in
+    /// parallel over the patches.
+    ///
+    /// Neither the geometry nor the evaluator are accessed, so this
+    /// can be called by another thread, on a copy of the data set.
+    void writeFiles() const;
+
     bool isEmpty();
 
     bool isSaved();
@@ -171,6 +188,9 @@ public:
         gsOptionList opt;
         opt.addInt("numPoints", "Number of points per-patch.", 1000);
         opt.addInt("precision", "Number of decimal digits.", 5);
+        opt.addString("format", "Encoding of the data: ascii, binary (base64) or appended (raw).", "ascii");
+        opt.addSwitch("compress", "Compress binary and appended data with zlib.", false);
+        opt.addSwitch("async", "Write the files of the time steps in a background thread (gsParaviewCollection).", false);
         opt.addInt("plotElements.resolution", "Drawing resolution for element mesh.", -1);
         opt.addSwitch("makeSubfolder", "Export vtk files to subfolder ( below the .pvd file ).", true);
         opt.addString("subfolder","Name of subfolder where the vtk files will be stored.", "");
@@ -182,145 +202,84 @@ public:
     gsOptionList & options() {return m_options;}
 
 private:
-    /// @brief  Evaluates gsFunctionSet over all pieces( patches ) and returns all <DataArray> xml tags as a vector of strings
+    /// @brief Returns the points of a grid with about \a nPts points on the box \a ab
+    template< class T>
+    static gsMatrix<T> gridPoints(const gsMatrix<T> & ab, unsigned nPts)
+    {
+        gsGridIterator<T,CUBE> grid(ab, nPts);
+        gsMatrix<T> result(ab.rows(), grid.numPoints());
+        index_t col = 0;
+        for( grid.reset(); grid; ++grid, ++col )
+            result.col(col) = *grid;
+        return result;
+    }
+
+    /// @brief  Evaluates gsFunctionSet over all pieces( patches ), in parallel
     /// @tparam T 
     /// @param funSet gsFunctionSet to be evaluated
     /// @param nPts   Number of evaluation points, per patch.
-    /// @param precision Number of decimal points in xml output
-    /// @return Vector of strings of all <DataArrays>
+    /// @return The values on every piece, one column per point
     template< class T>
-    static std::vector<std::string> toVTK(const gsFunctionSet<T> & funSet, unsigned nPts=1000, unsigned precision=5, std::string label="")
+    static std::vector<gsMatrix<real_t> > toVTK(const gsFunctionSet<T> & funSet, unsigned nPts=1000)
     {   
-        std::vector<std::string> out;
-        gsMatrix<T> evalPoint, xyzPoints;
+        const index_t n = funSet.nPieces();
+        std::vector<gsMatrix<real_t> > out(n);
 
         // Loop over all patches
-        for ( index_t i=0; i != funSet.nPieces(); ++i )
+#       pragma omp parallel for schedule(dynamic,1)
+        for ( index_t i=0; i < n; ++i )
         {
-            gsGridIterator<T,CUBE> grid(funSet.piece(i).support(), nPts);
-
-            // Evaluate the MultiPatch for every parametric point of the grid iterator
-            xyzPoints.resize( funSet.targetDim(), grid.numPoints() );
-            index_t col = 0;
-            for( grid.reset(); grid; ++grid )
-            {
-                evalPoint = *grid; // ..
-                xyzPoints.col(col) =  funSet.piece(i).eval(evalPoint);
-                col++;
-            }
-
-            out.push_back( toDataArray(xyzPoints, label, precision)  );
+            const gsMatrix<T> pts = gridPoints(funSet.piece(i).support(), nPts);
+            out[i] = funSet.piece(i).eval(pts).template cast<real_t>();
         }
         return out; 
     }
 
+    /// @brief  Evaluates a gsField over all patches, in parallel
     template< class T>
-    static std::vector<std::string> toVTK(const gsField<T> & field, unsigned nPts=1000, unsigned precision=5, std::string label="")
+    static std::vector<gsMatrix<real_t> > toVTK(const gsField<T> & field, unsigned nPts=1000)
     {   
-        std::vector<std::string> out;
-        gsMatrix<T> evalPoint, xyzPoints;
+        const index_t n = field.nPieces();
+        std::vector<gsMatrix<real_t> > out(n);
 
         // Loop over all patches
-        for ( index_t i=0; i != field.nPieces(); ++i )
+#       pragma omp parallel for schedule(dynamic,1)
+        for ( index_t i=0; i < n; ++i )
         {
-            gsGridIterator<T,CUBE> grid(field.fields().piece(i).support(), nPts);
-
-            // Evaluate the MultiPatch for every parametric point of the grid iterator
-            xyzPoints.resize( field.dim(), grid.numPoints());
-            index_t col = 0;
-            for( grid.reset(); grid; ++grid )
-            {
-                evalPoint = *grid; // ..
-                xyzPoints.col(col) =  field.value(evalPoint, i);
-                col++;
-            }
-
-            out.push_back( toDataArray(xyzPoints, label, precision)  );
+            const gsMatrix<T> pts = gridPoints(field.patches().piece(i).support(), nPts);
+            out[i] = field.value(pts, i).template cast<real_t>();
         }
         return out; 
     }
 
-    /// @brief  Evaluates one expression over all patches and returns all <DataArray> xml tags as a vector of strings
+    /// @brief  Evaluates one expression over all patches
     /// @tparam T 
     /// @param expr Expression to be evaluated
-    /// @param label The label with which the expression will appear in Paraview
-    /// @return Vector of strings of all <DataArrays>
+    /// @return The values on every patch, one column per point
     template<class E>
-    std::vector<std::string> toVTK(const expr::_expr<E> & expr,
-                                            unsigned nPts=1000,
-                                            unsigned precision=5,
-                                            std::string label="SolutionField")
+    std::vector<gsMatrix<real_t> > toVTK(const expr::_expr<E> & expr,
+                                         unsigned nPts=1000)
     {   
-        std::vector<std::string> out;
-        std::stringstream dataArray;
-        dataArray.setf( std::ios::fixed ); // write floating point values in fixed-point notation.
-        dataArray.precision(precision);
-        // m_exprdata->parse(expr);
-
         //if false, embed topology ?
         const index_t n = m_evaltr->exprData()->multiBasis().nBases();
+        std::vector<gsMatrix<real_t> > out(n);
 
-        gsMatrix<real_t> pts, vals, ab;
+        gsMatrix<real_t> ab;
 
+        // The evaluator is not thread-safe
         for ( index_t i=0; i != n; ++i )
         {
             ab = m_evaltr->exprData()->multiBasis().piece(i).support();
             gsGridIterator<real_t,CUBE> pt(ab, nPts);
             m_evaltr->eval(expr, pt, i);
             
-            vals = m_evaltr->allValues(m_evaltr->elementwise().size()/pt.numPoints(), pt.numPoints());
-
-            dataArray <<"<DataArray type=\"Float32\" Name=\""<< label <<"\" format=\"ascii\" NumberOfComponents=\""<< ( vals.rows()==1 ? 1 : 3) <<"\">\n";
-            if ( vals.rows()==1 )
-                for ( index_t j=0; j<vals.cols(); ++j)
-                    dataArray<< vals.at(j) <<" ";
-            else
-            {
-                for ( index_t j=0; j<vals.cols(); ++j)
-                {
-                    for ( index_t k=0; k!=vals.rows(); ++k)
-                        dataArray<< vals(k,j) <<" ";
-                    for ( index_t k=vals.rows(); k<3; ++k)
-                        dataArray<<"0 ";
-                }
-            }
-            dataArray <<"\n</DataArray>\n";
-            out.push_back( dataArray.str() );
-            dataArray.str(std::string()); // Clear the dataArray stringstream
+            out[i] = m_evaltr->allValues(m_evaltr->elementwise().size()/pt.numPoints(), pt.numPoints());
         }
         return out; 
     }
 
-
-    /// @brief Formats the coordinates of points as a <DataArray> xml tag for ParaView export.
-    /// @tparam T Arithmetic type
-    /// @param points A gsMatrix<T> with the coordinates of the points, stored column-wise. Its size is (numDims, numPoints)
-    /// @param label A string with the label of the data
-    /// @param precision Number of decimal points in xml output
-    /// @return The raw xml string 
-    template<class T>
-    static std::string toDataArray(const gsMatrix<T> & points, const std::string label, unsigned precision)
-    {
-        std::stringstream stream;
-        stream.setf( std::ios::fixed ); // write floating point values in fixed-point notation.
-        stream.precision(precision); 
-        // Format as vtk xml string
-        stream <<"<DataArray type=\"Float32\" format=\"ascii\" ";
-        if ( "" != label )
-            stream << "Name=\"" << label <<"\" ";
-        stream << "NumberOfComponents=\"3\">\n";
-        // For every point
-        for ( index_t j=0; j<points.cols(); ++j)
-        {
-            for ( index_t i=0; i!=points.rows(); ++i)
-                stream<< points(i,j) <<" ";
-            for ( index_t i=points.rows(); i<3; ++i)
-                stream<<"0 ";
-        }
-        stream <<"\n</DataArray>\n";
-
-        return stream.str();
-    }
+    /// @brief Stores the values of a field on patch \a k
+    void addData(index_t k, const std::string & label, gsMatrix<real_t> & values, index_t numComp);
 
     void initFilenames();
 
@@ -0,0 +1,172 @@
+/** @file gsVtkDataArrays.cpp
+
+    @brief Writes the data arrays of VTK XML (Paraview) files in ascii,
+    base64 or appended raw encoding.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <gsIO/gsVtkDataArrays.h>
+
+#include <zlib/zlib.h> // G+Smo
+
+#include <sstream>
+
+namespace gismo
+{
+
+namespace
+{
+
+// The header entries of the binary data (header_type="UInt64")
+typedef uint64_t vtkHeader;
+
+// Size of the blocks that are compressed separately, as used by VTK
+const size_t vtkBlockSize = 32768;
+
+// Appends the base64 encoding of the bytes to the stream
+void base64Encode(std::ostream & os, const char * data, size_t n)
+{
+    static const char table[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const unsigned char * in = reinterpret_cast<const unsigned char*>(data);
+
+    std::string out;
+    out.reserve( 4 * ((n + 2) / 3) );
+    size_t i = 0;
+    for (; i + 2 < n; i += 3)
+    {
+        const unsigned v = (in[i] << 16) | (in[i+1] << 8) | in[i+2];
+        out += table[ v >> 18        ];
+        out += table[(v >> 12) & 0x3F];
+        out += table[(v >>  6) & 0x3F];
+        out += table[ v        & 0x3F];
+    }
+    if (i < n)
+    {
+        const unsigned v = (in[i] << 16) | (i + 1 < n ? in[i+1] << 8 : 0);
+        out += table[ v >> 18        ];
+        out += table[(v >> 12) & 0x3F];
+        out += (i + 1 < n ? table[(v >> 6) & 0x3F] : '=');
+        out += '=';
+    }
+    os << out;
+}
+
+bool isLittleEndian()
+{
+    const unsigned short one = 1;
+    return 1 == *reinterpret_cast<const unsigned char*>(&one);
+}
+
+} // anonymous namespace
+
+gsVtkDataArrays::format gsVtkDataArrays::formatFromString(const std::string & fmt)
+{
+    if ( "ascii"    == fmt ) return ascii;
+    if ( "binary"   == fmt ) return binary;
+    if ( "appended" == fmt ) return appended;
+    GISMO_ERROR("Unknown VTK data format \""<< fmt <<"\", use ascii, binary or appended.");
+}
+
+std::string gsVtkDataArrays::fileAttributes() const
+{
+    if ( ascii == m_format )
+        return " version=\"0.1\"";
+
+    std::string result(" version=\"1.0\" byte_order=\"");
+    result += isLittleEndian() ? "LittleEndian" : "BigEndian";
+    result += "\" header_type=\"UInt64\"";
+    if ( m_compress )
+        result += " compressor=\"vtkZLibDataCompressor\"";
+    return result;
+}
+
+std::string gsVtkDataArrays::attributes(index_t numComp, const std::string & name,
+                                        bool float64)
+{
+    std::ostringstream str;
+    str << (float64 ? "type=\"Float64\" " : "type=\"Float32\" ");
+    if ( "" != name )
+        str << "Name=\"" << name << "\" ";
+    str << "NumberOfComponents=\"" << numComp << "\"";
+    return str.str();
+}
+
+void gsVtkDataArrays::writeBinary(std::ostream & os, const std::string & attributes,
+                                  const char * data, size_t nBytes)
+{
+    // The header holds the number of bytes; for compressed data it
+    // holds the number of blocks, the block size, the size of the last
+    // block and the compressed sizes of the blocks.
+    std::vector<vtkHeader> header;
+    std::string compressed;
+    if ( m_compress )
+    {
+        const size_t nBlocks = (nBytes + vtkBlockSize - 1) / vtkBlockSize;
+        header.resize(3 + nBlocks);
+        header[0] = nBlocks;
+        header[1] = vtkBlockSize;
+        header[2] = nBlocks ? nBytes - (nBlocks - 1) * vtkBlockSize : 0;
+
+        std::vector<Bytef> buffer( compressBound(vtkBlockSize) );
+        for (size_t b = 0; b < nBlocks; ++b)
+        {
+            const size_t size = (b + 1 < nBlocks ? vtkBlockSize : header[2]);
+            uLongf len = buffer.size();
+            const int status = compress2(buffer.data(), &len,
+                                         reinterpret_cast<const Bytef*>(data + b * vtkBlockSize),
+                                         size, Z_BEST_SPEED);
+            GISMO_ENSURE( Z_OK == status, "gsVtkDataArrays: Compression failed." );
+            compressed.append(reinterpret_cast<const char*>(buffer.data()), len);
+            header[3 + b] = len;
+        }
+        data = compressed.data();
+    }
+    else
+        header.assign(1, nBytes);
+
+    const char * headerData = reinterpret_cast<const char*>(header.data());
+    const size_t headerSize = header.size() * sizeof(vtkHeader);
+    const size_t dataSize   = m_compress ? compressed.size() : nBytes;
+
+    if ( binary == m_format )
+    {
+        os << "<DataArray " << attributes << " format=\"binary\">\n";
+        if ( m_compress ) // header and data are encoded separately
+        {
+            base64Encode(os, headerData, headerSize);
+            base64Encode(os, data, dataSize);
+        }
+        else              // header and data are encoded together
+        {
+            std::string block(headerData, headerSize);
+            block.append(data, dataSize);
+            base64Encode(os, block.data(), block.size());
+        }
+        os << "\n</DataArray>\n";
+    }
+    else
+    {
+        os << "<DataArray " << attributes << " format=\"appended\" offset=\""
+           << m_appended.size() << "\"/>\n";
+        m_appended.append(headerData, headerSize);
+        m_appended.append(data, dataSize);
+    }
+}
+
+void gsVtkDataArrays::writeAppendedData(std::ostream & os)
+{
+    if ( appended != m_format )
+        return;
+    os << "<AppendedData encoding=\"raw\">\n_";
+    os.write(m_appended.data(), m_appended.size());
+    os << "\n</AppendedData>\n";
+    m_appended.clear();
+}
+
+} // namespace gismo
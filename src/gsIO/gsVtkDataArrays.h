@@ -0,0 +1,184 @@
+/** @file gsVtkDataArrays.h
+
+    @brief Writes the data arrays of VTK XML (Paraview) files in ascii,
+    base64 or appended raw encoding.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gsCore/gsLinearAlgebra.h>
+
+#include <ostream>
+#include <sstream>
+
+namespace gismo
+{
+
+/**
+    \brief Writes the \c DataArray elements of one VTK XML file.
+
+    The values are written as \c Float64 if their type is more precise
+    than \c float, or if the precision of the stream exceeds the one of
+    \c float, and as \c Float32 otherwise. The encodings are
+    - \c ascii: as text, formatted by the stream (default),
+    - \c binary: inline, base64 encoded,
+    - \c appended: as raw bytes in an \c AppendedData section at the
+      end of the file; the \c DataArray elements only hold the offsets.
+
+    Binary and appended data can additionally be compressed by zlib.
+    The binary formats need the attributes given by \ref fileAttributes
+    in the \c VTKFile element; the appended data is written by \ref
+    writeAppendedData right before the closing \c VTKFile tag:
+
+    \verbatim
+    gsVtkDataArrays arrays(gsVtkDataArrays::appended, true);
+    file << "<VTKFile type=\"StructuredGrid\"" << arrays.fileAttributes() << ">\n";
+    ...
+    arrays.write(file, values, 3, "SolutionField");
+    ...
+    arrays.writeAppendedData(file);
+    file << "</VTKFile>\n";
+    \endverbatim
+
+    The functions gsWriteParaview write ascii data; gsParaviewDataSet
+    and gsParaviewCollection take the format from their options
+    "format" and "compress".
+
+    \ingroup IO
+*/
+class GISMO_EXPORT gsVtkDataArrays
+{
+public:
+
+    /// The encodings of the data
+    enum format
+    {
+        ascii    = 0, ///< text
+        binary   = 1, ///< inline base64
+        appended = 2  ///< raw, appended to the file
+    };
+
+    /// Constructor, \a compress is ignored for the \c ascii format
+    explicit gsVtkDataArrays(format fmt = ascii, bool compress = false)
+    : m_format(fmt), m_compress(compress && fmt != ascii)
+    { }
+
+    /// @brief Parses the format from one of the strings "ascii",
+    /// "binary" and "appended"
+    static format formatFromString(const std::string & fmt);
+
+    /// The format
+    format dataFormat() const { return m_format; }
+
+    /// Returns true iff the binary data are compressed
+    bool compressed() const { return m_compress; }
+
+    /// @brief The attributes of the \c VTKFile element (including
+    /// version), starting with a space
+    std::string fileAttributes() const;
+
+    /// @brief Writes a \c DataArray with the columns of \a data as
+    /// tuples
+    ///
+    /// @param os       The stream of the file
+    /// @param data     The values, one column per point
+    /// @param numComp  The number of components; if \a data has less
+    ///                 rows, the missing components are set to zero
+    /// @param name     The name of the array (optional)
+    template<class T>
+    void write(std::ostream & os, const gsMatrix<T> & data, index_t numComp,
+               const std::string & name = "")
+    {
+        const index_t nr = data.rows(), nc = data.cols();
+        const bool float64 =
+            std::numeric_limits<T>::digits > std::numeric_limits<float>::digits ||
+            os.precision() > std::numeric_limits<float>::digits10;
+        if ( ascii == m_format )
+        {
+            os << "<DataArray " << attributes(numComp, name, float64) << " format=\"ascii\">\n";
+            // Chunks of points are formatted in parallel, with the
+            // settings of the stream, and written in order
+            const index_t chunk = 4096, nChunks = (nc + chunk - 1) / chunk;
+            std::vector<std::string> text(nChunks);
+            const std::ios_base::fmtflags flags = os.flags();
+            const std::streamsize prec = os.precision();
+#           pragma omp parallel for schedule(dynamic,1) if(nChunks>1)
+            for ( index_t c=0; c<nChunks; ++c)
+            {
+                std::ostringstream str;
+                str.flags(flags);
+                str.precision(prec);
+                for ( index_t j=c*chunk; j<math::min(nc,(c+1)*chunk); ++j)
+                {
+                    for ( index_t i=0; i!=nr; ++i)
+                        str << data(i,j) <<" ";
+                    for ( index_t i=nr; i<numComp; ++i)
+                        str << "0 ";
+                }
+                text[c] = str.str();
+            }
+            for ( index_t c=0; c<nChunks; ++c)
+                os << text[c];
+            os << "\n</DataArray>\n";
+            return;
+        }
+
+        const index_t nComp = math::max(nr, numComp);
+        if ( float64 )
+        {
+            copyValues(data, nComp, m_values64);
+            writeBinary(os, attributes(numComp, name, true),
+                        reinterpret_cast<const char*>(m_values64.data()),
+                        m_values64.size() * sizeof(double));
+        }
+        else
+        {
+            copyValues(data, nComp, m_values32);
+            writeBinary(os, attributes(numComp, name, false),
+                        reinterpret_cast<const char*>(m_values32.data()),
+                        m_values32.size() * sizeof(float));
+        }
+    }
+
+    /// @brief Writes the \c AppendedData section, if any; call this
+    /// once, right before the closing \c VTKFile tag
+    void writeAppendedData(std::ostream & os);
+
+private:
+
+    /// Attributes of the \c DataArray element, apart from the format
+    static std::string attributes(index_t numComp, const std::string & name,
+                                  bool float64);
+
+    /// Copies \a data to \a values, padded to \a nComp components
+    template<class T, class V>
+    static void copyValues(const gsMatrix<T> & data, index_t nComp,
+                           std::vector<V> & values)
+    {
+        const index_t nr = data.rows(), nc = data.cols();
+        values.assign(nc * nComp, V(0));
+        for ( index_t j=0; j<nc; ++j)
+            for ( index_t i=0; i!=nr; ++i)
+                values[j*nComp+i] = cast<T,V>(data(i,j));
+    }
+
+    /// Writes \a nBytes raw bytes of values in binary or appended format
+    void writeBinary(std::ostream & os, const std::string & attributes,
+                     const char * data, size_t nBytes);
+
+private:
+    format m_format;
+    bool   m_compress;
+
+    std::vector<float>  m_values32; ///< Buffers for the values of the
+    std::vector<double> m_values64; ///< current array
+    std::string m_appended;         ///< The appended data
+};
+
+} // namespace gismo
@@ -16,6 +16,7 @@
 
 #include <gsIO/gsParaviewCollection.h>
 #include <gsIO/gsIOUtils.h>
+#include <gsIO/gsVtkDataArrays.h>
 
 #include <gsCore/gsGeometry.h>
 #include <gsCore/gsGeometrySlice.h>
@@ -279,56 +280,35 @@ void gsWriteParaviewTPgrid(const gsMatrix<T> & eval_geo  ,
                            const gsVector<index_t> & np,
                            std::string const & fn)
 {
-    const int n = eval_geo.rows();
     GISMO_ASSERT(eval_geo.cols()==eval_field.cols()
                  && static_cast<index_t>(np.prod())==eval_geo.cols(),
                  "Data do not match");
 
     std::string mfn(fn);
     mfn.append(".vts");
-    std::ofstream file(mfn.c_str());
+    std::ofstream file(mfn.c_str(), std::ios::out | std::ios::binary);
     file << std::fixed; // no exponents
     file << std::setprecision (PLOT_PRECISION);
+    gsVtkDataArrays arrays;
 
     index_t np1 = (np.size()>1 ? np(1)-1 : 0);
     index_t np2 = (np.size()>2 ? np(2)-1 : 0);
     
     file <<"<?xml version=\"1.0\"?>\n";
-    file <<"<VTKFile type=\"StructuredGrid\" version=\"0.1\">\n";
+    file <<"<VTKFile type=\"StructuredGrid\""<< arrays.fileAttributes() <<">\n";
     file <<"<StructuredGrid WholeExtent=\"0 "<< np(0)-1<<" 0 "<< np1 <<" 0 "
          << np2 <<"\">\n";
     file <<"<Piece Extent=\"0 "<< np(0)-1<<" 0 "<<np1<<" 0 "
          << np2 <<"\">\n";
     file <<"<PointData "<< ( eval_field.rows()==1 ?"Scalars":"Vectors")<<"=\"SolutionField\">\n";
-    file <<"<DataArray type=\"Float32\" Name=\"SolutionField\" format=\"ascii\" NumberOfComponents=\""<< ( eval_field.rows()==1 ? 1 : 3) <<"\">\n";
-    if ( eval_field.rows()==1 )
-        for ( index_t j=0; j<eval_field.cols(); ++j)
-            file<< eval_field.at(j) <<" ";
-    else
-    {
-        for ( index_t j=0; j<eval_field.cols(); ++j)
-        {
-            for ( index_t i=0; i!=eval_field.rows(); ++i)
-                file<< eval_field(i,j) <<" ";
-            for ( index_t i=eval_field.rows(); i<3; ++i)
-                file<<"0 ";
-        }
-    }
-    file <<"</DataArray>\n";
+    arrays.write(file, eval_field, eval_field.rows()==1 ? 1 : 3, "SolutionField");
     file <<"</PointData>\n";
     file <<"<Points>\n";
-    file <<"<DataArray type=\"Float32\" NumberOfComponents=\"3\">\n";
-    for ( index_t j=0; j<eval_geo.cols(); ++j)
-    {
-        for ( index_t i=0; i!=n; ++i)
-            file<< eval_geo(i,j) <<" ";
-        for ( index_t i=n; i<3; ++i)
-            file<<"0 ";
-    }
-    file <<"</DataArray>\n";
+    arrays.write(file, eval_geo, 3);
     file <<"</Points>\n";
     file <<"</Piece>\n";
     file <<"</StructuredGrid>\n";
+    arrays.writeAppendedData(file);
     file <<"</VTKFile>\n";
 
     file.close();
@@ -350,8 +330,9 @@ void writeSinglePatchField(const gsFunction<T> & geometry,
     gsVector<unsigned> np = uniformSampleCount(a, b, npts);
     gsMatrix<T> pts = gsPointGrid(a, b, np);
 
-    gsMatrix<T> eval_geo = geometry.eval(pts);//pts
-    gsMatrix<T>  eval_field = isParam ? parField.eval(pts) : parField.eval(eval_geo);
+    gsMatrix<T> eval_geo, eval_field;
+    geometry.evalParallel_into(pts, eval_geo);
+    parField.evalParallel_into(isParam ? pts : eval_geo, eval_field);
 
     if ( 3 - d > 0 )
     {
@@ -478,7 +459,8 @@ void writeSingleGeometry(gsFunction<T> const& func,
     gsVector<unsigned> np = uniformSampleCount(a,b, npts );
     gsMatrix<T> pts = gsPointGrid(a,b,np) ;
 
-    gsMatrix<T>  eval_func = func.eval  ( pts ) ;//pts
+    gsMatrix<T>  eval_func;
+    func.evalParallel_into( pts, eval_func ) ;
 
     if ( 3 - d > 0 )
     {
@@ -507,13 +489,14 @@ void writeSingleGeometry(gsFunction<T> const& func,
 
     std::string mfn(fn);
     mfn.append(".vts");
-    std::ofstream file(mfn.c_str());
+    std::ofstream file(mfn.c_str(), std::ios::out | std::ios::binary);
     if ( ! file.is_open() )
         gsWarn<<"writeSingleGeometry: Problem opening file \""<<fn<<"\""<<std::endl;
     file << std::fixed; // no exponents
     file << std::setprecision (PLOT_PRECISION);
+    gsVtkDataArrays arrays;
     file <<"<?xml version=\"1.0\"?>\n";
-    file <<"<VTKFile type=\"StructuredGrid\" version=\"0.1\">\n";
+    file <<"<VTKFile type=\"StructuredGrid\""<< arrays.fileAttributes() <<">\n";
     file <<"<StructuredGrid WholeExtent=\"0 "<<np(0)-1<<" 0 "<<np(1)-1<<" 0 "<<np(2)-1<<"\">\n";
     file <<"<Piece Extent=\"0 "<< np(0)-1<<" 0 "<<np(1)-1<<" 0 "<<np(2)-1<<"\">\n";
     // Add norm of the point as data
@@ -530,23 +513,17 @@ void writeSingleGeometry(gsFunction<T> const& func,
     {
         //gsWarn<< "4th dimension as scalar data.\n";
         file <<"<PointData "<< "Scalars=\"Coordinate4\">\n";
-        file <<"<DataArray type=\"Float32\" Name=\"Coordinate4\" format=\"ascii\" NumberOfComponents=\"1\">\n";
-        for ( index_t j=0; j!=eval_func.cols(); ++j)
-            file<< eval_func(3,j) <<" ";
-        file <<"</DataArray>\n";
+        arrays.write<T>(file, eval_func.row(3), 1, "Coordinate4");
         file <<"</PointData>\n";
     }
     //---------
 
     file <<"<Points>\n";
-    file <<"<DataArray type=\"Float32\" NumberOfComponents=\"3\">\n";
-    for ( index_t j=0; j<eval_func.cols(); ++j)
-        for ( index_t i=0; i!=3; ++i)
-            file<< eval_func(i,j) <<" ";
-    file <<"</DataArray>\n";
+    arrays.write<T>(file, eval_func.topRows(3), 3);
     file <<"</Points>\n";
     file <<"</Piece>\n";
     file <<"</StructuredGrid>\n";
+    arrays.writeAppendedData(file);
     file <<"</VTKFile>\n";
     file.close();
 }
@@ -566,7 +543,8 @@ void writeSingleCurve(gsFunction<T> const& func,
     gsVector<unsigned> np = uniformSampleCount(a,b, npts );
     gsMatrix<T> pts = gsPointGrid(a,b,np) ;
 
-    gsMatrix<T>  eval_func = func.eval  ( pts ) ;//pts
+    gsMatrix<T>  eval_func;
+    func.evalParallel_into( pts, eval_func ) ;
 
     np.conservativeResize(3);
     np.bottomRows(2).setOnes();
@@ -674,28 +652,29 @@ void gsWriteParaview(const gsField<T> & field,
     }
     */
 
-    const unsigned n = field.nPieces();
+    const index_t n = field.nPieces();
     gsParaviewCollection collection(fn);
-    std::string fileName, fileName_nopath;
 
-    for ( unsigned i=0; i < n; ++i )
+    // The patches are written in parallel
+#   pragma omp parallel for schedule(dynamic,1)
+    for ( index_t i=0; i < n; ++i )
     {
         const gsBasis<T> & dom = field.isParametrized() ?
             field.igaFunction(i).basis() : field.patch(i).basis();
 
-        fileName = fn + pDelim + util::to_string(i);
-        fileName_nopath = gsFileManager::getFilename(fileName);
+        const std::string fileName = fn + pDelim + util::to_string(i);
         writeSinglePatchField( field, i, fileName, npts );
-        collection.addPart(fileName_nopath + ".vts");
         if ( mesh )
-        {
-            fileName+= "_mesh";
-            fileName_nopath = gsFileManager::getFilename(fileName);
-            writeSingleCompMesh(dom, field.patch(i), fileName);
-
-            collection.addPart(fileName_nopath + ".vtp");
-        }
+            writeSingleCompMesh(dom, field.patch(i), fileName + "_mesh");
+    }
 
+    for ( index_t i=0; i < n; ++i )
+    {
+        const std::string fileName_nopath =
+            gsFileManager::getFilename(fn + pDelim + util::to_string(i));
+        collection.addPart(fileName_nopath + ".vts");
+        if ( mesh )
+            collection.addPart(fileName_nopath + "_mesh.vtp");
     }
     collection.save();
 }
@@ -717,17 +696,17 @@ void gsWriteParaview(gsFunctionSet<T> const& geo,
 
     GISMO_ASSERT(geo.nPieces()==func.nPieces(),"Function sets must have same number of pieces, but func has "<<func.nPieces()<<" and geo has "<<geo.nPieces());
 
-    const unsigned n = geo.nPieces();
+    const index_t n = geo.nPieces();
     gsParaviewCollection collection(fn);
-    std::string fileName, fileName_nopath;
 
-    for ( unsigned i=0; i < n; ++i )
-    {
-        fileName = fn + pDelim + util::to_string(i);
-        fileName_nopath = gsFileManager::getFilename(fileName);
-        writeSinglePatchField( geo.function(i), func.function(i), true, fileName, npts );
-        collection.addPart(fileName_nopath + ".vts");
-    }
+    // The patches are written in parallel
+#   pragma omp parallel for schedule(dynamic,1)
+    for ( index_t i=0; i < n; ++i )
+        writeSinglePatchField( geo.function(i), func.function(i), true,
+                               fn + pDelim + util::to_string(i), npts );
+
+    for ( index_t i=0; i < n; ++i )
+        collection.addPart(gsFileManager::getFilename(fn + pDelim + util::to_string(i)) + ".vts");
     collection.save();
 }
 
@@ -939,42 +918,38 @@ void gsWriteParaview( std::vector<gsGeometry<T> *> const & Geo,
                       std::string const & fn,
                       unsigned npts, bool mesh, bool ctrlNet, const std::string pDelim)
 {
-    const size_t n = Geo.size();
+    const index_t n = Geo.size();
 
     gsParaviewCollection collection(fn);
-    std::string fnBase, fnBase_nopath;
 
-    for ( size_t i=0; i<n ; i++)
+    // The patches are written in parallel
+#   pragma omp parallel for schedule(dynamic,1)
+    for ( index_t i=0; i<n ; i++)
     {
-        fnBase = fn + pDelim + util::to_string(i);
-        fnBase_nopath = gsFileManager::getFilename(fnBase);
+        const std::string fnBase = fn + pDelim + util::to_string(i);
 
-        if ( Geo.at(i)->domainDim() == 1 )
-        {
+        if ( Geo[i]->domainDim() == 1 )
             writeSingleCurve(*Geo[i], fnBase, npts);
-            collection.addPart(fnBase_nopath + ".vtp");
-        }
         else
-        {
             writeSingleGeometry( *Geo[i], fnBase, npts ) ;
-            collection.addPart(fnBase_nopath + ".vts");
-        }
 
         if ( mesh )
-        {
-            const std::string fileName = fnBase + "_mesh";
-            const std::string fileName_nopath = gsFileManager::getFilename(fileName);
-            writeSingleCompMesh(Geo[i]->basis(), *Geo[i], fileName);
-            collection.addPart(fileName_nopath + ".vtp");
-        }
+            writeSingleCompMesh(Geo[i]->basis(), *Geo[i], fnBase + "_mesh");
 
         if ( ctrlNet ) // Output the control net
-        {
-            const std::string fileName = fnBase + "_cnet";
-            const std::string fileName_nopath = gsFileManager::getFilename(fileName);
-            writeSingleControlNet(*Geo[i], fileName);
-            collection.addPart(fileName_nopath + ".vtp");
-        }
+            writeSingleControlNet(*Geo[i], fnBase + "_cnet");
+    }
+
+    for ( index_t i=0; i<n ; i++)
+    {
+        const std::string fnBase_nopath =
+            gsFileManager::getFilename(fn + pDelim + util::to_string(i));
+
+        collection.addPart(fnBase_nopath + ( Geo[i]->domainDim() == 1 ? ".vtp" : ".vts" ));
+        if ( mesh )
+            collection.addPart(fnBase_nopath + "_mesh.vtp");
+        if ( ctrlNet )
+            collection.addPart(fnBase_nopath + "_cnet.vtp");
     }
     collection.save();
 }
@@ -24,6 +24,87 @@
 
 namespace gismo {
 
+bool gsParseDouble(const char * & str, double & var)
+{
+    // Powers of ten that are exact in double precision
+    static const double pow10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    internal::skipSpace(str);
+    const char * p = str;
+    const bool neg = ('-' == *p);
+    if ( '-' == *p || '+' == *p ) ++p;
+
+    // Significand of up to 19 digits and decimal exponent
+    uint64_t mant = 0;
+    int digits = 0, exp10 = 0;
+    bool any = false, exact = true;
+    for (; *p >= '0' && *p <= '9'; ++p, any = true)
+    {
+        if ( digits < 19 )
+        {
+            mant = 10 * mant + (*p - '0');
+            digits += (0 != mant);
+        }
+        else
+        {
+            exact = false;
+            ++exp10;
+        }
+    }
+    if ( '.' == *p )
+        for (++p; *p >= '0' && *p <= '9'; ++p, any = true)
+        {
+            if ( digits < 19 )
+            {
+                mant = 10 * mant + (*p - '0');
+                digits += (0 != mant);
+                --exp10;
+            }
+            else
+                exact = false;
+        }
+    if ( any && ('e' == *p || 'E' == *p) )
+    {
+        const char * q = p + 1;
+        const bool eneg = ('-' == *q);
+        if ( '-' == *q || '+' == *q ) ++q;
+        if ( *q >= '0' && *q <= '9' )
+        {
+            int e = 0;
+            for (; *q >= '0' && *q <= '9'; ++q)
+                if ( e < 100000 ) e = 10 * e + (*q - '0');
+            exp10 += eneg ? -e : e;
+            p = q;
+        }
+    }
+
+    const bool end = ( '\0'==*p || ' '==*p || '\n'==*p || '\t'==*p || '\r'==*p
+                       || '\f'==*p || '\v'==*p || '/'==*p );
+    if ( any && end && exact && mant <= (uint64_t(1) << 53) &&
+         exp10 >= -22 && exp10 <= 22 )
+    {
+        // Both the significand and the power of ten are exact, hence
+        // the result is correctly rounded (Clinger's fast path)
+        const double v = static_cast<double>(mant);
+        var = exp10 < 0 ? v / pow10[-exp10] : v * pow10[exp10];
+        if ( neg ) var = -var;
+    }
+    else
+    {
+        // Long significands, large exponents, inf, nan, hex, ...
+        char * q;
+        const double v = strtod(str, &q);
+        if ( q == str ) return false;
+        var = v;
+        p = q;
+        // Skip the rest of the token, as gsGetReal(std::istream&,T&)
+        while ( *p && '/'!=*p && ' '!=*p && '\n'!=*p && '\t'!=*p && '\r'!=*p ) ++p;
+    }
+    str = p;
+    return true;
+}
+
 namespace internal {
 
 
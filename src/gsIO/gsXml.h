@@ -26,6 +26,8 @@
 //#include <rapidxml/rapidxml_iterators.hpp> // External file
 
 #include <cstring>
+#include <sstream>
+#include <map>
 
 /*
 // Forward declare rapidxml structures
@@ -186,6 +188,108 @@ gsGetValue(std::istream & is, T & var)
 
 namespace internal {
 
+/// Advances \a str past white space
+inline void skipSpace(const char * & str)
+{
+    while ( ' '==*str || '\n'==*str || '\t'==*str || '\r'==*str
+            || '\f'==*str || '\v'==*str ) ++str;
+}
+
+}// end namespace internal
+
+/// @brief Reads a double from the C string \a str, in the manner of
+/// std::from_chars
+///
+/// White space is skipped and \a str is advanced past the number; a
+/// '/' ends the number. Returns false if \a str holds no number.
+GISMO_EXPORT bool gsParseDouble(const char * & str, double & var);
+
+/// @brief Reads a real number (or a fraction a/b) from the C string
+/// \a str and advances \a str past it
+///
+/// As gsGetReal(std::istream&,T&), but without temporary strings for
+/// double and float.
+template<class T>
+inline bool gsGetReal(const char * & str, T & var)
+{
+    GISMO_STATIC_ASSERT(!std::numeric_limits<T>::is_integer,
+        "The second parameter needs to be a real type.");
+    // Other number types are read with their stream operators
+    internal::skipSpace(str);
+    const char * end = str;
+    while ( *end && ' '!=*end && '\n'!=*end && '\t'!=*end && '\r'!=*end ) ++end;
+    if ( end == str ) return false;
+    std::istringstream is( std::string(str, end) );
+    str = end;
+    return gsGetReal(is, var);
+}
+
+template<>
+inline bool gsGetReal(const char * & str, double & var)
+{
+    if ( !gsParseDouble(str, var) ) return false;
+    if ( '/' == *str )
+    {
+        double den;
+        if ( !gsParseDouble(++str, den) ) return false;
+        var /= den;
+    }
+    return true;
+}
+
+template<>
+inline bool gsGetReal(const char * & str, float & var)
+{
+    double tmp;
+    if ( !gsGetReal(str, tmp) ) return false;
+    var = static_cast<float>(tmp);
+    return true;
+}
+
+/// @brief Reads an integer from the C string \a str and advances \a
+/// str past it
+///
+/// Returns false, leaving \a str and \a var unchanged, if \a str
+/// holds no integer, if the value does not fit in \a Z, or if it is
+/// negative and \a Z is unsigned.
+template<class Z>
+inline bool gsGetInt(const char * & str, Z & var)
+{
+    GISMO_STATIC_ASSERT(std::numeric_limits<Z>::is_integer,
+        "The second parameter needs to be an integer type.");
+    internal::skipSpace(str);
+    const char * p = str;
+    const bool neg = ('-' == *p);
+    if ( neg && !std::numeric_limits<Z>::is_signed ) return false;
+    if ( '-' == *p || '+' == *p ) ++p;
+    if ( *p < '0' || *p > '9' ) return false;
+    // Negative values are accumulated as such, to reach the minimum
+    const Z lim = neg ? std::numeric_limits<Z>::min() : std::numeric_limits<Z>::max();
+    Z val = 0;
+    for (; *p >= '0' && *p <= '9'; ++p)
+    {
+        const Z dg = static_cast<Z>(*p - '0');
+        if ( neg ? val < (lim + dg) / 10 : val > (lim - dg) / 10 )
+            return false; // overflow
+        val = neg ? static_cast<Z>(10 * val - dg) : static_cast<Z>(10 * val + dg);
+    }
+    var = val;
+    str = p;
+    return true;
+}
+
+template <typename Z>
+typename util::enable_if<std::numeric_limits<Z>::is_integer, bool>::type
+gsGetValue(const char * & str, Z & var)
+{ return gsGetInt<Z>(str,var); }
+
+template <typename T>
+typename util::enable_if<!std::numeric_limits<T>::is_integer, bool>::type
+gsGetValue(const char * & str, T & var)
+{ return gsGetReal<T>(str,var); }
+
+namespace internal {
+
 typedef rapidxml::xml_node<char>        gsXmlNode;
 typedef rapidxml::xml_attribute<char>   gsXmlAttribute;
 typedef rapidxml::xml_document<char>    gsXmlTree;
@@ -263,6 +367,23 @@ inline gsXmlNode * searchId(const int id, gsXmlNode * root, const char *tag_name
     return NULL;
 }
 
+/// Helper to index the children of \em root by their \em id value,
+/// for repeated searches (the first child with each id is kept).
+/// \param root parent node
+/// \param tag_name Limit to tags named \em tag_name .
+inline std::map<int, gsXmlNode*> indexById(gsXmlNode * root, const char *tag_name = NULL)
+{
+    std::map<int, gsXmlNode*> result;
+    for (gsXmlNode * child = root->first_node(tag_name);
+         child; child = child->next_sibling(tag_name))
+    {
+        const gsXmlAttribute * id_at = child->first_attribute("id");
+        if ( id_at )
+            result.insert( std::make_pair(atoi(id_at->value()), child) );
+    }
+    return result;
+}
+
 /// Helper to read an object by a given \em label :
 /// \param node parent node, we check his children to get the given \em label
 /// \param label
@@ -298,6 +419,23 @@ Object * getById(gsXmlNode * node, const int & id)
              <<" with id="<<id<<" not found.\n";
     return NULL;
 }
+
+/// Helper to read an object by a given \em id value, using an index
+/// made by indexById()
+/// \param index the nodes by id
+/// \param id
+template<class Object>
+Object * getById(const std::map<int, gsXmlNode*> & index, const int & id)
+{
+    const std::map<int, gsXmlNode*>::const_iterator it = index.find(id);
+    if (index.end() != it)
+    {
+        return internal::gsXml<Object>::get(it->second);
+    }
+    std::cerr<<"gsXmlUtils Warning: "<< internal::gsXml<Object>::tag()
+             <<" with id="<<id<<" not found.\n";
+    return NULL;
+}
 /// Helper to allocate XML value
 GISMO_EXPORT char * makeValue( const std::string & value, gsXmlTree & data);
 
@@ -71,8 +71,7 @@ void getMatrixFromXml ( gsXmlNode * node, unsigned const & rows,
                         unsigned const & cols, gsMatrix<T> & result )
 {
     //gsWarn<<"Reading "<< node->name() <<" matrix of size "<<rows<<"x"<<cols<<"Geometry..\n";
-    std::istringstream str;
-    str.str( node->value() );
+    const char * str = node->value();
     result.resize(rows,cols);
 
     for (unsigned i=0; i<rows; ++i) // Read is RowMajor
@@ -122,13 +121,12 @@ void getSparseEntriesFromXml ( gsXmlNode * node,
 {
     result.clear();
 
-    std::istringstream str;
-    str.str( node->value() );
+    const char * str = node->value();
     index_t r,c;
     T val;
 
     //while( (str >> r) && (str >> c) && (str >> val) )
-    while( (str >> r) && (str >> c) && ( gsGetValue(str,val)) )
+    while( gsGetInt(str,r) && gsGetInt(str,c) && ( gsGetValue(str,val)) )
         result.add(r,c,val);
 }
 
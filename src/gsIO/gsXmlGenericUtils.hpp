@@ -124,9 +124,6 @@ Object * getHTensorBasisFromXml ( gsXmlNode * node)
     gsTensorBSplineBasis<d,T> * tp = 
         gsXml<gsTensorBSplineBasis<d,T> >::get(tmp);
     
-    // Initialize the HBSplineBasis
-    std::istringstream str;
-    
     // Insert all boxes
     unsigned c;
     std::vector<index_t> all_boxes;
@@ -134,11 +131,11 @@ Object * getHTensorBasisFromXml ( gsXmlNode * node)
          tmp; tmp = tmp->next_sibling("box"))
     {
         all_boxes.push_back(atoi( tmp->first_attribute("level")->value() ));
-        str.clear();
-        str.str( tmp->value() );
+        const char * str = tmp->value();
         for( unsigned i = 0; i < 2*d; i++)
         {
-            str>> c;
+            GISMO_ENSURE( gsGetInt(str, c),
+                          "XML Error: Expected "<<2*d<<" non-negative box indices." );
             all_boxes.push_back(c);
         }
     }
@@ -990,6 +990,10 @@ public:
         std::istringstream str ;
         str.str( tmp->value() );
         
+        // Index the geometries once, instead of searching for every patch
+        const std::map<int, gsXmlNode*> index = indexById(toplevel,
+                                 gsXml< gsGeometry<T> >::tag().c_str());
+
         std::vector< gsGeometry<T> *> patches;
         std::map<int,int> ids;
         if ( ! strcmp( tmp->first_attribute("type")->value(),"id_range") )
@@ -999,9 +1003,9 @@ public:
             gsGetInt(str, last);
             for ( int i = first; i<=last; ++i )
             {
-                GISMO_ASSERT( searchId(i, toplevel) != NULL, 
+                GISMO_ASSERT( index.count(i), 
                               "No Geometry with Id "<<i<<" found in the XML data.");
-                patches.push_back( getById< gsGeometry<T> >( toplevel, i ) );
+                patches.push_back( getById< gsGeometry<T> >( index, i ) );
                 patches.back()->setId(i);
                 ids[i] = i - first;
             }
@@ -1011,9 +1015,9 @@ public:
             int c = 0;
             for (int pindex; gsGetInt(str, pindex);)
             {
-                GISMO_ASSERT( searchId(pindex, toplevel) != NULL, 
+                GISMO_ASSERT( index.count(pindex), 
                               "No Geometry with Id "<<pindex<<" found in the XML data.");
-                patches.push_back( getById< gsGeometry<T> >( toplevel, pindex ) );
+                patches.push_back( getById< gsGeometry<T> >( index, pindex ) );
                 patches.back()->setId(pindex);
                 ids[pindex] = c++;
             }
@@ -1126,6 +1130,10 @@ public:
         std::istringstream iss;
         iss.str( patchNode->value() );
 
+        // Index the bases once, instead of searching for every patch
+        const std::map<int, gsXmlNode*> index = indexById(topLevel,
+                                 gsXml< gsBasis<T> >::tag().c_str());
+
         typename gsMultiBasis<T>::BasisContainer bases;
         std::map<int, int> ids;
         if ( !strcmp( patchNode->first_attribute("type")->value(), "id_range") )
@@ -1135,7 +1143,7 @@ public:
             gsGetInt(iss, last);
             for (int i = first; i <= last; ++i)
             {
-                bases.push_back( getById< gsBasis<T> >( topLevel, i ) );
+                bases.push_back( getById< gsBasis<T> >( index, i ) );
                 ids[i] = i - first;
             }
         }
@@ -1144,7 +1152,7 @@ public:
             int c = 0;
             for ( int pindex; gsGetInt(iss, pindex); )
             {
-                bases.push_back( getById< gsBasis<T> >( topLevel, pindex ) );
+                bases.push_back( getById< gsBasis<T> >( index, pindex ) );
                 ids[pindex] = c++;
             }
         }
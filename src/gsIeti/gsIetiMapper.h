@@ -140,6 +140,19 @@ public:
     /// @brief Construct the global solution from a vector of patch-local ones
     Matrix constructGlobalSolutionFromLocalSolutions( const std::vector<Matrix>& localContribs );
 
+    /// @brief Construct the global solution from the patch-local ones for
+    /// the given patches
+    ///
+    /// @param localContribs  The local solutions for the patches in \a patches
+    /// @param patches        The indices of the patches
+    ///
+    /// The entries of the global solution that do not belong to the given
+    /// patches are zero. Every dof is taken from one patch only, so the
+    /// results for a partition of the patches (e.g., among processes)
+    /// add up to the result of the function above.
+    Matrix constructGlobalSolutionFromLocalSolutions( const std::vector<Matrix>& localContribs,
+                                                      const std::vector<index_t>& patches );
+
 public:
 
     /// @brief Returns the number of Lagrange multipliers.
@@ -111,6 +111,44 @@ gsIetiMapper<T>::constructGlobalSolutionFromLocalSolutions( const std::vector<Ma
     return result;
 }
 
+template <class T>
+typename gsIetiMapper<T>::Matrix
+gsIetiMapper<T>::constructGlobalSolutionFromLocalSolutions( const std::vector<Matrix>& localContribs,
+                                                            const std::vector<index_t>& patches )
+{
+    GISMO_ASSERT( m_status&1, "gsIetiMapper: The class has not been initialized." );
+    GISMO_ASSERT( patches.size() == localContribs.size(),
+        "gsIetiMapper::constructGlobalSolutionFromLocalSolutions; The number of local contributions does "
+        "not argee with the number of patches." );
+
+    // Like above, a dof is taken from the last patch it belongs to
+    const index_t nPatches = m_dofMapperGlobal.numPatches();
+    std::vector<index_t> lastPatch( m_dofMapperGlobal.freeSize(), -1 );
+    for (index_t k=0; k<nPatches; ++k)
+    {
+        const index_t sz=m_dofMapperLocal[k].size();
+        for (index_t i=0; i<sz; ++i)
+            if (m_dofMapperLocal[k].is_free(i,0) && m_dofMapperGlobal.is_free(i,k))
+                lastPatch[m_dofMapperGlobal.index(i,k)] = k;
+    }
+
+    Matrix result;
+    result.setZero( m_dofMapperGlobal.freeSize(), localContribs.empty() ? 1 : localContribs[0].cols() );
+
+    for (size_t j=0; j<patches.size(); ++j)
+    {
+        const index_t k = patches[j];
+        const index_t sz=m_dofMapperLocal[k].size();
+        for (index_t i=0; i<sz; ++i)
+        {
+            if (m_dofMapperLocal[k].is_free(i,0) && m_dofMapperGlobal.is_free(i,k)
+                && lastPatch[m_dofMapperGlobal.index(i,k)] == k)
+                result.row(m_dofMapperGlobal.index(i,k)) = localContribs[j].row(m_dofMapperLocal[k].index(i,0));
+        }
+    }
+    return result;
+}
+
 namespace {
 struct dof_helper {
     index_t globalIndex;
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <gsSolver/gsMatrixOp.h>
+#include <gsSolver/gsDistributedIndexSet.h>
 
 namespace gismo
 {
@@ -62,6 +63,22 @@ namespace gismo
  *
  *  The right-hand sides are stored in a vector accessible via \ref localRhs.
  *
+ *  The local solvers are set up and applied in parallel, one subdomain per
+ *  thread at a time. So, each subdomain needs a solver object of its own.
+ *
+ *  The system can also be distributed over the processes of a
+ *  communicator (see \ref distribute). Then, every process adds only the
+ *  subdomains (patches) it owns, with jump matrices referring to the
+ *  global Lagrange multipliers, and the primal problem is added by every
+ *  process via \ref addSharedSubdomain. The Lagrange multipliers are
+ *  distributed as described in \a gsDistributedIndexSet, i.e., the vectors
+ *  of Lagrange multipliers (like the right-hand side for the Schur
+ *  complement and the solution) hold only the owned entries. The
+ *  Schur complement is realized by a \a gsDistributedAdditiveOp, so
+ *  only processes with neighboring patches exchange data, apart from one
+ *  reduction for the primal problem. The solver for the Schur complement
+ *  has to sum up its inner products, cf. gsConjugateGradient::setComm.
+ *
  *  @ingroup Solver
 **/
 
@@ -75,6 +92,7 @@ class gsIetiSystem
     typedef gsSparseMatrix<T,RowMajor>        JumpMatrix;      ///< Sparse matrix type for jumps
     typedef memory::shared_ptr<JumpMatrix>    JumpMatrixPtr;   ///< Shared pointer to sparse matrix type for jumps
     typedef gsMatrix<T>                       Matrix;          ///< Matrix type
+    typedef typename gsDistributedIndexSet<T>::Ptr IndexSetPtr;    ///< Shared pointer to the distribution of the multipliers
 public:
 
     /// @brief Reserves the memory required to store the number of subdomains
@@ -91,9 +109,44 @@ public:
     /// @param localSolverOp    The operator that represents a solver for the
     ///                         local problem. This parameter is optional; the
     ///                         solver is created automatically if needed.
+    ///
+    /// The local solvers are applied in parallel (by OpenMP threads) only
+    /// if every subdomain has its own solver object, since the solvers
+    /// might have buffers of their own. Note that only the objects given
+    /// here are compared: if several solvers share an operator internally,
+    /// they must be safe to be applied concurrently.
     void addSubdomain(JumpMatrixPtr jumpMatrix, OpPtr localMatrixOp,
         Matrix localRhs, OpPtr localSolverOp = OpPtr());
 
+    /// @brief Adds a new subdomain that is shared by all processes, like
+    ///        the primal problem
+    ///
+    /// The parameters are the same as for \ref addSubdomain. The local matrix
+    /// and the right-hand side have to be the same on all processes, while
+    /// the jump matrix is the contribution of this process: the jump matrix
+    /// of the subdomain is the sum of the given matrices over all processes,
+    /// see also gsPrimalSystem::accumulate. If the system is not
+    /// distributed, this is the same as \ref addSubdomain.
+    void addSharedSubdomain(JumpMatrixPtr jumpMatrix, OpPtr localMatrixOp,
+        Matrix localRhs, OpPtr localSolverOp = OpPtr());
+
+    /// @brief Distributes the Lagrange multipliers over the processes (collective)
+    ///
+    /// Every process uses the Lagrange multipliers that act on its
+    /// subdomains. This function has to be called after all subdomains
+    /// have been added.
+    void distribute(const gsMpiComm & comm);
+
+    /// @brief Sets the distribution of the Lagrange multipliers
+    ///
+    /// All Lagrange multipliers that act on the subdomains of this
+    /// process have to be local indices of the distribution.
+    void setDistribution(IndexSetPtr distribution)       { m_distribution = give(distribution); }
+
+    /// @brief The distribution of the Lagrange multipliers; a null pointer
+    ///        if the system is not distributed
+    const IndexSetPtr& distribution() const              { return m_distribution; }
+
     /// Access the jump matrix
     JumpMatrixPtr&       jumpMatrix(index_t k)           { return m_jumpMatrices[k];   }
     const JumpMatrixPtr& jumpMatrix(index_t k) const     { return m_jumpMatrices[k];   }
@@ -110,7 +163,7 @@ public:
     OpPtr&               localSolverOp(index_t k)        { return m_localSolverOps[k]; }
     const OpPtr&         localSolverOp(index_t k) const  { return m_localSolverOps[k]; }
 
-    /// @brief Returns the number of Lagrange multipliers
+    /// @brief Returns the (global) number of Lagrange multipliers
     ///
     /// This requires that at least one jump matrix has been set.
     index_t nLagrangeMultipliers() const
@@ -145,6 +198,8 @@ public:
 
     /// @brief Returns \a gsLinearOperator that represents the IETI problem as
     ///        saddle point problem
+    ///
+    /// This is not available if the system is distributed.
     OpPtr saddlePointProblem() const;
 
     /// @brief Returns the right-hand-side that is required for the saddle point
@@ -159,11 +214,17 @@ public:
 
 private:
     void setupSparseLUSolvers() const;                ///< Setup solvers if not provided by user
+    bool distinctSolverOps() const;                   ///< True iff no solver object appears twice
+
+    /// The jump matrices, restricted to the local Lagrange multipliers if the system is distributed
+    std::vector<JumpMatrixPtr> localJumpMatrices() const;
 
     std::vector<JumpMatrixPtr>  m_jumpMatrices;       ///< Stores the jump matrices
     std::vector<OpPtr>          m_localMatrixOps;     ///< Stores the local matrix ops \f$ \tilde A_k \f$
     std::vector<Matrix>         m_localRhs;           ///< Stores the local right-hand sides
     mutable std::vector<OpPtr>  m_localSolverOps;     ///< Stores the local solvers
+    std::vector<bool>           m_shared;             ///< Stores which subdomains are shared by all processes
+    IndexSetPtr                 m_distribution;       ///< The distribution of the Lagrange multipliers
 };
 
 } // namespace gismo
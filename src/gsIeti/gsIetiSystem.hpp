@@ -15,6 +15,7 @@
 
 #include <gsSolver/gsBlockOp.h>
 #include <gsSolver/gsAdditiveOp.h>
+#include <gsSolver/gsDistributedAdditiveOp.h>
 
 namespace gismo
 {
@@ -26,6 +27,7 @@ void gsIetiSystem<T>::reserve(index_t n)
     this->m_localRhs.reserve(n);
     this->m_localSolverOps.reserve(n);
     this->m_jumpMatrices.reserve(n);
+    this->m_shared.reserve(n);
 }
 
 template<class T>
@@ -44,29 +46,92 @@ void gsIetiSystem<T>::addSubdomain(JumpMatrixPtr jumpMatrix, OpPtr localMatrixOp
     this->m_localMatrixOps.push_back(give(localMatrixOp));
     this->m_localRhs.push_back(give(localRhs));
     this->m_localSolverOps.push_back(give(localSolverOp));
+    this->m_shared.push_back(false);
+}
+
+template<class T>
+void gsIetiSystem<T>::addSharedSubdomain(JumpMatrixPtr jumpMatrix, OpPtr localMatrixOp, Matrix localRhs, OpPtr localSolverOp)
+{
+    addSubdomain(give(jumpMatrix), give(localMatrixOp), give(localRhs), give(localSolverOp));
+    this->m_shared.back() = true;
+}
+
+template<class T>
+void gsIetiSystem<T>::distribute(const gsMpiComm & comm)
+{
+    // A process might not have any subdomains
+    index_t nMultipliers = m_jumpMatrices.empty() ? 0 : nLagrangeMultipliers();
+    nMultipliers = comm.max(nMultipliers);
+
+    std::vector<index_t> used;
+    const size_t sz = this->m_jumpMatrices.size();
+    for (size_t k=0; k<sz; ++k)
+    {
+        const JumpMatrix& jm = *(this->m_jumpMatrices[k]);
+        for (index_t i=0; i<jm.outerSize(); ++i)
+            if (typename JumpMatrix::InnerIterator(jm, i))
+                used.push_back(i);
+    }
+    m_distribution = gsDistributedIndexSet<T>::make(give(used), nMultipliers, comm);
+}
+
+template<class T>
+std::vector<typename gsIetiSystem<T>::JumpMatrixPtr> gsIetiSystem<T>::localJumpMatrices() const
+{
+    if (!m_distribution)
+        return m_jumpMatrices;
+
+    const size_t sz = this->m_jumpMatrices.size();
+    std::vector<JumpMatrixPtr> result(sz);
+    for (size_t k=0; k<sz; ++k)
+        result[k] = m_distribution->restrictRows(*(this->m_jumpMatrices[k])).moveToPtr();
+    return result;
 }
 
 template<class T>
 void gsIetiSystem<T>::setupSparseLUSolvers() const
 {
-    const size_t sz = this->m_localSolverOps.size();
-    for (size_t i=0; i<sz; ++i)
+    const index_t sz = this->m_localSolverOps.size();
+    std::vector<index_t> todo;
+    for (index_t i=0; i<sz; ++i)
     {
         if (!m_localSolverOps[i]) // If not yet provided...
         {
-            SparseMatrixOp* matop = dynamic_cast<SparseMatrixOp*>(this->m_localMatrixOps[i].get());
-            GISMO_ENSURE( matop, "gsIetiSystem::setupSparseLUSolvers The local solvers can only "
+            GISMO_ENSURE( dynamic_cast<SparseMatrixOp*>(this->m_localMatrixOps[i].get()),
+              "gsIetiSystem::setupSparseLUSolvers The local solvers can only "
               "be computed on the fly if the local systems in localMatrixOps are of type "
               "gsMatrixOp<gsSparseMatrix<T>>. Please provide solvers via members .addSubdomain "
               "or .solverOp" );
-            this->m_localSolverOps[i] = makeSparseLUSolver(SparseMatrix(matop->matrix()));
+            todo.push_back(i);
         }
     }
+
+    // The factorizations are independent of each other
+    const index_t nTodo = todo.size();
+#   pragma omp parallel for schedule(dynamic,1)
+    for (index_t j=0; j<nTodo; ++j)
+    {
+        const index_t i = todo[j];
+        const SparseMatrixOp* matop = static_cast<const SparseMatrixOp*>(this->m_localMatrixOps[i].get());
+        this->m_localSolverOps[i] = makeSparseLUSolver(SparseMatrix(matop->matrix()));
+    }
+}
+
+template<class T>
+bool gsIetiSystem<T>::distinctSolverOps() const
+{
+    std::vector<const Op*> ops(m_localSolverOps.size());
+    for (size_t i=0; i<m_localSolverOps.size(); ++i)
+        ops[i] = m_localSolverOps[i].get();
+    std::sort(ops.begin(), ops.end());
+    return std::adjacent_find(ops.begin(), ops.end()) == ops.end();
 }
 
 template<class T>
 typename gsIetiSystem<T>::OpPtr gsIetiSystem<T>::saddlePointProblem() const
 {
+    GISMO_ENSURE( !m_distribution, "gsIetiSystem::saddlePointProblem is not available "
+        "for distributed systems." );
     const size_t sz = this->m_localMatrixOps.size();
     typename gsBlockOp<T>::Ptr result = gsBlockOp<T>::make( sz+1, sz+1 );
     for (size_t i=0; i<sz; ++i)
@@ -83,7 +148,20 @@ template<class T>
 typename gsIetiSystem<T>::OpPtr gsIetiSystem<T>::schurComplement() const
 {
     setupSparseLUSolvers();
-    return gsAdditiveOp<T>::make( this->m_jumpMatrices, this->m_localSolverOps );
+    if (!m_distribution)
+        return gsAdditiveOp<T>::make( this->m_jumpMatrices, this->m_localSolverOps );
+
+    const std::vector<JumpMatrixPtr> jumpMatrices = localJumpMatrices();
+    typename gsDistributedAdditiveOp<T>::Ptr result = gsDistributedAdditiveOp<T>::make(m_distribution);
+    const size_t sz = jumpMatrices.size();
+    for (size_t i=0; i<sz; ++i)
+    {
+        if (m_shared[i])
+            result->addSharedOperator( jumpMatrices[i], this->m_localSolverOps[i] );
+        else
+            result->addOperator( jumpMatrices[i], this->m_localSolverOps[i] );
+    }
+    return result;
 }
 
 
@@ -91,15 +169,30 @@ template<class T>
 gsMatrix<T> gsIetiSystem<T>::rhsForSchurComplement() const
 {
     setupSparseLUSolvers();
-    Matrix result;
-    result.setZero( this->nLagrangeMultipliers(), this->m_localRhs[0].cols());
     const index_t numPatches = this->m_jumpMatrices.size();
+    std::vector<Matrix> tmp(numPatches);
+    // The local solvers might have buffers of their own, see gsAdditiveOp
+#   pragma omp parallel for schedule(dynamic,1) if(distinctSolverOps())
     for (index_t i=0; i<numPatches; ++i)
+        this->m_localSolverOps[i]->apply( this->m_localRhs[i], tmp[i] );
+
+    if (!m_distribution)
     {
-        Matrix tmp;
-        this->m_localSolverOps[i]->apply( this->m_localRhs[i], tmp );
-        result += *(this->m_jumpMatrices[i]) * tmp;
+        Matrix result;
+        result.setZero( this->nLagrangeMultipliers(), this->m_localRhs[0].cols());
+        for (index_t i=0; i<numPatches; ++i)
+            result += *(this->m_jumpMatrices[i]) * tmp[i];
+        return result;
     }
+
+    // The local right-hand sides of the shared subdomains are the same on
+    // all processes, so the contributions of their jump matrices add up
+    const std::vector<JumpMatrixPtr> jumpMatrices = localJumpMatrices();
+    Matrix local, result;
+    local.setZero( m_distribution->numLocal(), numPatches > 0 ? this->m_localRhs[0].cols() : 1 );
+    for (index_t i=0; i<numPatches; ++i)
+        local += *(jumpMatrices[i]) * tmp[i];
+    m_distribution->addToOwned(local, result);
     return result;
 }
 
@@ -109,11 +202,28 @@ std::vector< gsMatrix<T> > gsIetiSystem<T>::constructSolutionFromLagrangeMultipl
     setupSparseLUSolvers();
 
     const index_t numPatches = this->m_jumpMatrices.size();
-    std::vector<Matrix> result;
+
+    // For distributed systems, the values of the local multipliers are
+    // needed; the contributions to the shared subdomains are summed up
+    const std::vector<JumpMatrixPtr> jumpMatrices = localJumpMatrices();
+    Matrix localMultipliers;
+    if (m_distribution)
+        m_distribution->toLocal(multipliers, localMultipliers);
+    const Matrix& lambda = m_distribution ? localMultipliers : multipliers;
+
+    std::vector<Matrix> result, jumps(numPatches);
+    for (index_t i=0; i<numPatches; ++i)
+    {
+        jumps[i].noalias() = jumpMatrices[i]->transpose()*lambda;
+        if (m_distribution && m_shared[i])
+            m_distribution->comm().sum( jumps[i].data(), static_cast<int>(jumps[i].size()) );
+    }
+
     result.resize(numPatches);
+#   pragma omp parallel for schedule(dynamic,1) if(distinctSolverOps())
     for (index_t i=0; i<numPatches; ++i)
     {
-        this->m_localSolverOps[i]->apply( this->m_localRhs[i]-this->m_jumpMatrices[i]->transpose()*multipliers, result[i] );
+        this->m_localSolverOps[i]->apply( this->m_localRhs[i]-jumps[i], result[i] );
     }
     return result;
 }
@@ -121,6 +231,8 @@ std::vector< gsMatrix<T> > gsIetiSystem<T>::constructSolutionFromLagrangeMultipl
 template<class T>
 gsMatrix<T> gsIetiSystem<T>::rhsForSaddlePoint() const
 {
+    GISMO_ENSURE( !m_distribution, "gsIetiSystem::rhsForSaddlePoint is not available "
+        "for distributed systems." );
     const index_t sz = m_localMatrixOps.size();
     index_t rows = nLagrangeMultipliers();
     for (index_t k=0; k<sz; ++k)
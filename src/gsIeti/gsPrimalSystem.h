@@ -15,6 +15,7 @@
 
 #include <gsSolver/gsMatrixOp.h>
 #include <gsMatrix/gsVector.h>
+#include <gsParallel/gsMpi.h>
 
 namespace gismo
 {
@@ -79,6 +80,12 @@ namespace gismo
  *  After solving, the member \ref distributePrimalSolution distributes the
  *  solution obtained for the primal problem back to the individual patches.
  *
+ *  If the patches are distributed over several processes, every process
+ *  calls \ref handleConstraints for its own patches and \ref accumulate
+ *  afterwards, which sums up the primal problem over the processes. The
+ *  primal problem is then added to the IETI system by
+ *  gsIetiSystem::addSharedSubdomain.
+ *
  *  @ingroup Solver
 **/
 
@@ -265,6 +272,14 @@ public:
     /// @returns        The solution for the K patches
     std::vector<Matrix> distributePrimalSolution( std::vector<Matrix> sol );
 
+    /// @brief Sums up the local stiffness matrix and the right-hand side
+    ///        for the primal problem over all processes (collective)
+    ///
+    /// The jump matrix is not changed, so it holds the contribution of the
+    /// patches of this process afterwards, as expected by
+    /// gsIetiSystem::addSharedSubdomain.
+    void accumulate( const gsMpiComm & comm );
+
     /// Returns the jump matrix for the primal problem
     JumpMatrix&                           jumpMatrix()        { return m_jumpMatrix;                    }
     const JumpMatrix&                     jumpMatrix() const  { return m_jumpMatrix;                    }
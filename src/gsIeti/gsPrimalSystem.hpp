@@ -268,4 +268,44 @@ gsPrimalSystem<T>::distributePrimalSolution( std::vector<Matrix> sol )
 }
 
 
+template <class T>
+void gsPrimalSystem<T>::accumulate( const gsMpiComm & comm )
+{
+    comm.sum( m_localRhs.data(), static_cast<int>(m_localRhs.size()) );
+
+    // The entries of the matrices of all processes are collected
+    const int nProcs = comm.size();
+    int nnz = static_cast<int>(m_localMatrix.nonZeros());
+    std::vector<int> counts(nProcs), offsets(nProcs+1, 0);
+    comm.allgather( &nnz, 1, counts.data() );
+    for (int p=0; p<nProcs; ++p)
+        offsets[p+1] = offsets[p] + counts[p];
+
+    std::vector<index_t> rows, cols;
+    std::vector<T> values;
+    rows.reserve(nnz);
+    cols.reserve(nnz);
+    values.reserve(nnz);
+    for (index_t i=0; i<m_localMatrix.outerSize(); ++i)
+        for (typename SparseMatrix::InnerIterator it(m_localMatrix,i); it; ++it)
+        {
+            rows.push_back(it.row());
+            cols.push_back(it.col());
+            values.push_back(it.value());
+        }
+
+    std::vector<index_t> allRows(offsets.back()), allCols(offsets.back());
+    std::vector<T> allValues(offsets.back());
+    comm.allgatherv( rows.data(), nnz, allRows.data(), counts.data(), offsets.data() );
+    comm.allgatherv( cols.data(), nnz, allCols.data(), counts.data(), offsets.data() );
+    comm.allgatherv( values.data(), nnz, allValues.data(), counts.data(), offsets.data() );
+
+    gsSparseEntries<T> entries;
+    entries.reserve(offsets.back());
+    for (int q=0; q<offsets.back(); ++q)
+        entries.add( allRows[q], allCols[q], allValues[q] );
+    m_localMatrix.setFrom(entries);
+    m_localMatrix.makeCompressed();
+}
+
 } // namespace gismo
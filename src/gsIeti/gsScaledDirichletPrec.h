@@ -15,6 +15,7 @@
 
 #include <gsSolver/gsMatrixOp.h>
 #include <gsUtils/gsSortedVector.h>
+#include <gsSolver/gsDistributedIndexSet.h>
 
 namespace gismo
 {
@@ -71,6 +72,15 @@ namespace gismo
  *  \ref scalingMatrix. They can be provided by the caller or generated by
  *  calling \ref setupMultiplicityScaling.
  *
+ *  The preconditioner is a \a gsAdditiveOp, so the local Schur complements
+ *  are applied in parallel.
+ *
+ *  If the IETI system is distributed over several processes (see
+ *  gsIetiSystem::distribute), every process adds only its own subdomains
+ *  and the distribution of the Lagrange multipliers is passed via
+ *  \ref setDistribution. Then, the preconditioner is a
+ *  \a gsDistributedAdditiveOp.
+ *
  *  @ingroup Solver
 **/
 
@@ -83,6 +93,7 @@ class gsScaledDirichletPrec
     typedef gsSparseMatrix<T,RowMajor>        JumpMatrix;      ///< Sparse matrix type for jumps
     typedef memory::shared_ptr<JumpMatrix>    JumpMatrixPtr;   ///< Shared pointer to sparse matrix type for jumps
     typedef gsMatrix<T>                       Matrix;          ///< Matrix type
+    typedef typename gsDistributedIndexSet<T>::Ptr IndexSetPtr;    ///< Shared pointer to the distribution of the multipliers
 public:
 
     /// @brief Reserves the memory required to store the given number of subdomain
@@ -128,6 +139,13 @@ public:
     Matrix&              localScaling(index_t k)         { return m_localScaling[k];  }
     const Matrix&        localScaling(index_t k) const   { return m_localScaling[k];  }
 
+    /// @brief Sets the distribution of the Lagrange multipliers, usually
+    ///        the one of the IETI system (gsIetiSystem::distribution)
+    void setDistribution(IndexSetPtr distribution)       { m_distribution = give(distribution); }
+
+    /// The distribution of the Lagrange multipliers; a null pointer if not distributed
+    const IndexSetPtr&   distribution() const            { return m_distribution;     }
+
     /// @brief Extracts the skeleton dofs from the jump matrix
     ///
     /// @param jumpMatrix    The jump matrix
@@ -224,6 +242,7 @@ public:
     std::vector<JumpMatrixPtr>  m_jumpMatrices;     ///< The jump matrices \f$ \hat B_k \f$
     std::vector<OpPtr>          m_localSchurOps;    ///< The local Schur complements \f$ S_k \f$
     std::vector<Matrix>         m_localScaling;     ///< The diagonal entries of \f$ D_k \f$ as vectors
+    IndexSetPtr                 m_distribution;     ///< The distribution of the Lagrange multipliers
 };
 
 } // namespace gismo
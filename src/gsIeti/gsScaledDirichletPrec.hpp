@@ -16,6 +16,7 @@
 #include <gsSolver/gsProductOp.h>
 #include <gsSolver/gsSumOp.h>
 #include <gsSolver/gsAdditiveOp.h>
+#include <gsSolver/gsDistributedAdditiveOp.h>
 
 namespace gismo
 {
@@ -197,6 +198,9 @@ gsScaledDirichletPrec<T>::preconditioner() const
     }
 
     typename gsAdditiveOp<T>::Ptr result = gsAdditiveOp<T>::make();
+    typename gsDistributedAdditiveOp<T>::Ptr distributedResult;
+    if (m_distribution)
+        distributedResult = gsDistributedAdditiveOp<T>::make(m_distribution);
 
     for (index_t i=0; i<pnr; ++i)
     {
@@ -204,9 +208,14 @@ gsScaledDirichletPrec<T>::preconditioner() const
         local->addOperator(scalingOps[i]);
         local->addOperator(m_localSchurOps[i]);
         local->addOperator(scalingOps[i]);
-        result->addOperator(m_jumpMatrices[i],local);
+        if (m_distribution)
+            distributedResult->addOperator(m_distribution->restrictRows(*(m_jumpMatrices[i])).moveToPtr(),local);
+        else
+            result->addOperator(m_jumpMatrices[i],local);
     }
 
+    if (m_distribution)
+        return distributedResult;
     return result;
 }
 
@@ -0,0 +1,142 @@
+/** @file gsSmoothedAggregation.h
+
+    @brief Algebraic multigrid by smoothed aggregation
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gsMultiGrid/gsMultiGrid.h>
+#include <gsIO/gsOptionList.h>
+
+namespace gismo
+{
+
+/** @brief
+ *  Algebraic multigrid hierarchy by smoothed aggregation
+ *
+ *  This class sets up a grid hierarchy from a sparse matrix alone, by
+ *  the smoothed aggregation method of Vaněk, Mandel and Brezina
+ *  (Computing 56, 1996). On each level, the unknowns are grouped into
+ *  aggregates of strongly connected unknowns. The tentative prolongation
+ *  interpolates the constants on the aggregates; it is smoothed by one
+ *  damped Jacobi step, and the coarse matrix is the Galerkin product
+ *  \f$ P^T A P \f$. The hierarchy is built until the number of unknowns
+ *  is at most "CoarseSize", or "MaxLevels" levels are reached.
+ *
+ *  The setup is multithreaded, except for the (greedy) aggregation,
+ *  whose cost is small: the strength of the connections and the sparse
+ *  matrix products are computed row-wise in parallel.
+ *
+ *  The matrix is assumed to be symmetric and positive definite, and
+ *  its kernel is assumed to be spanned by the constants (if the Neumann
+ *  problem is considered), like for scalar elliptic problems.
+ *
+ *  The hierarchy plugs into \a gsMultiGridOp, see makeMultiGridOp(), so
+ *  the usual multigrid cycles are used. Like for \a gsMultiGridOp, the
+ *  level 0 is the coarsest one.
+ *
+ *  @ingroup Solver
+**/
+template< typename T >
+class gsSmoothedAggregation
+{
+public:
+
+    /// Matrix type
+    typedef gsSparseMatrix<T> SpMatrix;
+
+    /// Row-major matrix type, used for the transfer matrices
+    typedef gsSparseMatrix<T, RowMajor> SpMatrixRowMajor;
+
+    /// Shared pointer to a matrix
+    typedef memory::shared_ptr<SpMatrix> SpMatrixPtr;
+
+    /// Shared pointer to a row-major matrix
+    typedef memory::shared_ptr<SpMatrixRowMajor> SpMatrixRowMajorPtr;
+
+    /// @brief Sets up the hierarchy for the given matrix
+    ///
+    /// @param fineMatrix                The matrix on the finest level
+    /// @param opt                       A gsOptionList, see defaultOptions()
+    gsSmoothedAggregation(const SpMatrix & fineMatrix, const gsOptionList & opt = defaultOptions())
+    { init(memory::make_shared(new SpMatrix(fineMatrix)), opt); }
+
+    /// @brief Sets up the hierarchy for the given matrix
+    ///
+    /// @param fineMatrix                The matrix (as smart pointer) on the finest level
+    /// @param opt                       A gsOptionList, see defaultOptions()
+    gsSmoothedAggregation(SpMatrixPtr fineMatrix, const gsOptionList & opt = defaultOptions())
+    { init(give(fineMatrix), opt); }
+
+    /// Returns a list of default options
+    static gsOptionList defaultOptions()
+    {
+        gsOptionList opt;
+        opt.addInt   ( "MaxLevels",           "Maximum number of levels in the hierarchy", 10 );
+        opt.addInt   ( "CoarseSize",          "Maximum number of unknowns on the coarsest level", 500 );
+        opt.addReal  ( "StrengthThreshold",   "Threshold theta for strong connections: "
+                                              "|a_ij| > theta sqrt(|a_ii a_jj|)", 0.08 );
+        opt.addReal  ( "ProlongationDamping", "Damping of the Jacobi step for the prolongation, "
+                                              "divided by the spectral radius of D^{-1}A", 4./3 );
+        opt.addString( "Smoother",            "Smoother for makeMultiGridOp: Chebyshev (cheb), "
+                                              "SymmetricGaussSeidel (sgs), ColoredSymmetricGaussSeidel (csgs) "
+                                              "or Jacobi (j)", "cheb" );
+        return opt;
+    }
+
+    /// Number of levels
+    index_t numLevels() const                                   { return m_matrices.size(); }
+
+    /// Matrix on the given level
+    const SpMatrix & matrix(index_t lvl) const                  { return *m_matrices[lvl]; }
+
+    /// Prolongation from level \a lvl to level \a lvl + 1
+    const SpMatrixRowMajor & transferMatrix(index_t lvl) const  { return *m_prolong[lvl]; }
+
+    /// Returns the transfer matrices, which can be used for setting up \a gsMultiGridOp
+    std::vector<SpMatrixRowMajor> getTransferMatrices() const
+    {
+        std::vector<SpMatrixRowMajor> result(m_prolong.size());
+        for (size_t i = 0; i < m_prolong.size(); ++i)
+            result[i] = *m_prolong[i];
+        return result;
+    }
+
+    /// @brief Returns a \a gsMultiGridOp for the hierarchy
+    ///
+    /// The coarse matrices are shared with this object. The smoothers are
+    /// chosen by the option "Smoother", the coarsest level is solved by a
+    /// sparse Cholesky factorization.
+    typename gsMultiGridOp<T>::uPtr makeMultiGridOp() const;
+
+private:
+
+    /// Builds the hierarchy
+    void init(SpMatrixPtr fineMatrix, const gsOptionList & opt);
+
+private:
+    std::vector<SpMatrixPtr>          m_matrices;  ///< Matrices, coarsest first
+    std::vector<SpMatrixRowMajorPtr>  m_prolong;   ///< Prolongations
+    std::vector<SpMatrixRowMajorPtr>  m_restrict;  ///< Restrictions (transposed prolongations)
+    std::string                       m_smoother;
+};
+
+/// @brief Returns an algebraic multigrid preconditioner by smoothed aggregation for \a mat
+///
+/// \relates gsSmoothedAggregation
+template<typename T>
+typename gsMultiGridOp<T>::uPtr makeSmoothedAggregationOp(const gsSparseMatrix<T> & mat,
+    const gsOptionList & opt = gsSmoothedAggregation<T>::defaultOptions())
+{ return gsSmoothedAggregation<T>(mat, opt).makeMultiGridOp(); }
+
+} // namespace gismo
+
+#ifndef GISMO_BUILD_LIB
+#include GISMO_HPP_HEADER(gsSmoothedAggregation.hpp)
+#endif
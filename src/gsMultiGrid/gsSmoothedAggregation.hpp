@@ -0,0 +1,320 @@
+/** @file gsSmoothedAggregation.hpp
+
+    @brief Algebraic multigrid by smoothed aggregation
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <gsSolver/gsMatrixOp.h>
+#include <gsSolver/gsSimplePreconditioners.h>
+#include <gsSolver/gsChebyshevOp.h>
+
+namespace gismo
+{
+
+namespace internal
+{
+
+/// Computes C = A * B for row-major matrices, row by row in parallel
+/// (Gustavson's algorithm); the column indices of C are sorted
+template<class T>
+void parallelSparseProduct(const gsSparseMatrix<T,RowMajor> & A, const gsSparseMatrix<T,RowMajor> & B,
+                           gsSparseMatrix<T,RowMajor> & C)
+{
+    GISMO_ASSERT( A.cols() == B.rows(), "The dimensions do not agree." );
+    GISMO_ASSERT( A.isCompressed() && B.isCompressed(), "The matrices must be compressed." );
+    const index_t m = A.rows(), n = B.cols();
+    const index_t * aOuter = A.outerIndexPtr(), * aInner = A.innerIndexPtr();
+    const index_t * bOuter = B.outerIndexPtr(), * bInner = B.innerIndexPtr();
+    const T * aVal = A.valuePtr(), * bVal = B.valuePtr();
+
+    // Number of non-zeros per row
+    std::vector<index_t> outer(m+1, 0);
+#   pragma omp parallel if(m > 1000)
+    {
+        std::vector<index_t> marker(n, -1);
+#       pragma omp for schedule(static)
+        for (index_t i = 0; i < m; ++i)
+        {
+            index_t cnt = 0;
+            for (index_t k = aOuter[i]; k < aOuter[i+1]; ++k)
+                for (index_t l = bOuter[aInner[k]]; l < bOuter[aInner[k]+1]; ++l)
+                    if (marker[bInner[l]] != i)
+                    {
+                        marker[bInner[l]] = i;
+                        ++cnt;
+                    }
+            outer[i+1] = cnt;
+        }
+    }
+    for (index_t i = 0; i < m; ++i)
+        outer[i+1] += outer[i];
+
+    C.resize(m, n);
+    C.resizeNonZeros(outer[m]);
+    std::copy(outer.begin(), outer.end(), C.outerIndexPtr());
+    index_t * cInner = C.innerIndexPtr();
+    T * cVal = C.valuePtr();
+
+    // The rows of a thread are processed in increasing order, so a position
+    // before the start of the current row belongs to a previous row
+#   pragma omp parallel if(m > 1000)
+    {
+        std::vector<index_t> pos(n, -1);
+        std::vector< std::pair<index_t,T> > row;
+#       pragma omp for schedule(static)
+        for (index_t i = 0; i < m; ++i)
+        {
+            const index_t start = outer[i];
+            index_t end = start;
+            for (index_t k = aOuter[i]; k < aOuter[i+1]; ++k)
+            {
+                const T a = aVal[k];
+                for (index_t l = bOuter[aInner[k]]; l < bOuter[aInner[k]+1]; ++l)
+                {
+                    const index_t j = bInner[l];
+                    if (pos[j] < start)
+                    {
+                        pos[j] = end;
+                        cInner[end] = j;
+                        cVal[end++] = a * bVal[l];
+                    }
+                    else
+                        cVal[pos[j]] += a * bVal[l];
+                }
+            }
+
+            row.resize(end - start);
+            for (index_t k = start; k < end; ++k)
+                row[k-start] = std::make_pair(cInner[k], cVal[k]);
+            std::sort(row.begin(), row.end());
+            for (index_t k = start; k < end; ++k)
+            {
+                cInner[k] = row[k-start].first;
+                cVal[k]   = row[k-start].second;
+            }
+        }
+    }
+}
+
+/// Groups the unknowns into aggregates of strongly connected unknowns;
+/// returns the number of aggregates
+template<class T>
+index_t smoothedAggregationAggregates(const gsSparseMatrix<T,RowMajor> & A, T theta, std::vector<index_t> & agg)
+{
+    const index_t n = A.rows();
+    const index_t * outer = A.outerIndexPtr(), * inner = A.innerIndexPtr();
+    const T * val = A.valuePtr();
+
+    // Strength of the connections
+    gsMatrix<T> diag(n, 1);
+#   pragma omp parallel for schedule(static) if(n > 1000)
+    for (index_t i = 0; i < n; ++i)
+    {
+        diag(i,0) = 0;
+        for (index_t k = outer[i]; k < outer[i+1]; ++k)
+            if (inner[k] == i)
+                diag(i,0) = math::abs(val[k]);
+    }
+    std::vector<char> strong(A.nonZeros());
+#   pragma omp parallel for schedule(static) if(n > 1000)
+    for (index_t i = 0; i < n; ++i)
+        for (index_t k = outer[i]; k < outer[i+1]; ++k)
+            strong[k] = inner[k] != i && val[k] != (T)(0)
+                && math::abs(val[k]) > theta * math::sqrt(diag(i,0) * diag(inner[k],0));
+
+    // Phase 1: unknowns whose strong neighbors are all free form aggregates with them
+    agg.assign(n, -1);
+    index_t nAgg = 0;
+    for (index_t i = 0; i < n; ++i)
+    {
+        if (agg[i] != -1)
+            continue;
+        bool free = true;
+        for (index_t k = outer[i]; k < outer[i+1] && free; ++k)
+            free = !strong[k] || agg[inner[k]] == -1;
+        if (!free)
+            continue;
+        agg[i] = nAgg;
+        for (index_t k = outer[i]; k < outer[i+1]; ++k)
+            if (strong[k])
+                agg[inner[k]] = nAgg;
+        ++nAgg;
+    }
+
+    // Phase 2: the remaining unknowns join the aggregate of their strongest neighbor
+    const std::vector<index_t> agg1(agg);
+    for (index_t i = 0; i < n; ++i)
+    {
+        if (agg1[i] != -1)
+            continue;
+        T best = 0;
+        for (index_t k = outer[i]; k < outer[i+1]; ++k)
+            if (strong[k] && agg1[inner[k]] != -1 && math::abs(val[k]) > best)
+            {
+                best = math::abs(val[k]);
+                agg[i] = agg1[inner[k]];
+            }
+    }
+
+    // Phase 3: the unknowns without aggregated neighbors form new aggregates
+    for (index_t i = 0; i < n; ++i)
+    {
+        if (agg[i] != -1)
+            continue;
+        agg[i] = nAgg;
+        for (index_t k = outer[i]; k < outer[i+1]; ++k)
+            if (strong[k] && agg[inner[k]] == -1)
+                agg[inner[k]] = nAgg;
+        ++nAgg;
+    }
+    return nAgg;
+}
+
+} // namespace internal
+
+template<typename T>
+void gsSmoothedAggregation<T>::init(SpMatrixPtr fineMatrix, const gsOptionList & opt)
+{
+    GISMO_ASSERT( fineMatrix->rows() == fineMatrix->cols(), "gsSmoothedAggregation needs quadratic matrices." );
+
+    const index_t maxLevels  = opt.askInt   ( "MaxLevels",           10   );
+    const index_t coarseSize = opt.askInt   ( "CoarseSize",          500  );
+    const T theta            = opt.askReal  ( "StrengthThreshold",   0.08 );
+    const T omega            = opt.askReal  ( "ProlongationDamping", 4./3 );
+    m_smoother               = opt.askString( "Smoother",            "cheb" );
+
+    // The hierarchy is built from the finest level; it is reversed at the end
+    std::vector<SpMatrixPtr> mats(1, fineMatrix);
+    std::vector<SpMatrixRowMajorPtr> prolong, restriction;
+
+    SpMatrixRowMajor A = *fineMatrix, P0, AP, P, Ac;
+    A.makeCompressed();
+    std::vector<index_t> agg;
+    gsMatrix<T> dinv, x, y;
+
+    while ( A.rows() > coarseSize && (index_t)(mats.size()) < maxLevels )
+    {
+        const index_t n = A.rows();
+        const index_t nAgg = internal::smoothedAggregationAggregates(A, theta, agg);
+        if (nAgg >= n) // no coarsening
+            break;
+
+        // Tentative prolongation: normalized constants on the aggregates
+        std::vector<index_t> aggSize(nAgg, 0);
+        for (index_t i = 0; i < n; ++i)
+            ++aggSize[agg[i]];
+        P0.resize(n, nAgg);
+        P0.resizeNonZeros(n);
+        for (index_t i = 0; i <= n; ++i)
+            P0.outerIndexPtr()[i] = i;
+#       pragma omp parallel for schedule(static) if(n > 1000)
+        for (index_t i = 0; i < n; ++i)
+        {
+            P0.innerIndexPtr()[i] = agg[i];
+            P0.valuePtr()[i] = (T)(1) / math::sqrt((T)(aggSize[agg[i]]));
+        }
+
+        // Inverse of the diagonal and spectral radius of D^{-1}A by the power method
+        dinv = A.diagonal();
+        dinv = dinv.cwiseInverse();
+        x.setOnes(n, 1);
+        for (index_t i = 0; i < n; i += 2)
+            x(i,0) = -1;
+        T rho = 1;
+        for (index_t it = 0; it < 15; ++it)
+        {
+            y.noalias() = dinv.asDiagonal() * (A * x);
+            rho = y.norm() / x.norm();
+            x.swap(y);
+            x /= x.norm();
+        }
+
+        // Smoothed prolongation: P = (I - omega/rho D^{-1} A) P0
+        internal::parallelSparseProduct(A, P0, P);
+        const T w = omega / rho;
+        std::vector<char> found(n, 0);
+        bool missing = false;
+#       pragma omp parallel for schedule(static) reduction(||:missing) if(n > 1000)
+        for (index_t i = 0; i < n; ++i)
+        {
+            for (index_t k = P.outerIndexPtr()[i]; k < P.outerIndexPtr()[i+1]; ++k)
+            {
+                P.valuePtr()[k] *= -w * dinv(i,0);
+                if (P.innerIndexPtr()[k] == agg[i])
+                {
+                    P.valuePtr()[k] += P0.valuePtr()[i];
+                    found[i] = 1;
+                }
+            }
+            missing = missing || !found[i];
+        }
+        if (missing) // only if the pattern of A P0 misses an entry of P0
+        {
+            // Add the entries of P0 to the rows where they are missing
+            gsSparseEntries<T> entries;
+            for (index_t i = 0; i < n; ++i)
+                if (!found[i])
+                    entries.add(i, agg[i], P0.valuePtr()[i]);
+            SpMatrixRowMajor Pm(n, nAgg);
+            Pm.setFrom(entries);
+            P = P + Pm;
+        }
+        P.prune((T)(0));
+
+        // Galerkin product
+        internal::parallelSparseProduct(A, P, AP);
+        SpMatrixRowMajorPtr Pt(new SpMatrixRowMajor(P.transpose()));
+        internal::parallelSparseProduct(*Pt, AP, Ac);
+
+        prolong.push_back(SpMatrixRowMajorPtr(new SpMatrixRowMajor(give(P))));
+        restriction.push_back(Pt);
+        mats.push_back(SpMatrixPtr(new SpMatrix(Ac)));
+        A.swap(Ac);
+    }
+
+    m_matrices.assign(mats.rbegin(), mats.rend());
+    m_prolong.assign(prolong.rbegin(), prolong.rend());
+    m_restrict.assign(restriction.rbegin(), restriction.rend());
+}
+
+template<typename T>
+typename gsMultiGridOp<T>::uPtr gsSmoothedAggregation<T>::makeMultiGridOp() const
+{
+    typedef typename gsLinearOperator<T>::Ptr OpPtr;
+    const index_t nLevels = numLevels();
+    std::vector<OpPtr> ops(nLevels), prolong(nLevels-1), restriction(nLevels-1);
+    for (index_t i = 0; i < nLevels; ++i)
+        ops[i] = makeMatrixOp(m_matrices[i]);
+    for (index_t i = 0; i < nLevels-1; ++i)
+    {
+        prolong[i]  = makeMatrixOp(m_prolong[i]);
+        restriction[i] = makeMatrixOp(m_restrict[i]);
+    }
+
+    typename gsMultiGridOp<T>::uPtr mg = gsMultiGridOp<T>::make(ops, prolong, restriction,
+        makeSparseCholeskySolver(m_matrices[0]));
+
+    for (index_t i = 1; i < nLevels; ++i)
+    {
+        typename gsPreconditionerOp<T>::Ptr smootherOp;
+        if ( m_smoother == "Chebyshev" || m_smoother == "cheb" )
+            smootherOp = makeChebyshevOp(m_matrices[i]);
+        else if ( m_smoother == "SymmetricGaussSeidel" || m_smoother == "sgs" )
+            smootherOp = makeSymmetricGaussSeidelOp(m_matrices[i]);
+        else if ( m_smoother == "ColoredSymmetricGaussSeidel" || m_smoother == "csgs" )
+            smootherOp = makeColoredSymmetricGaussSeidelOp(m_matrices[i]);
+        else if ( m_smoother == "Jacobi" || m_smoother == "j" )
+            smootherOp = makeJacobiOp(m_matrices[i], (T)(2)/3);
+        else
+            GISMO_ERROR("gsSmoothedAggregation: Unknown smoother " << m_smoother << ".");
+        mg->setSmoother(i, smootherOp);
+    }
+    return mg;
+}
+
+} // namespace gismo
@@ -0,0 +1,9 @@
+#include <gsMultiGrid/gsSmoothedAggregation.h>
+#include <gsMultiGrid/gsSmoothedAggregation.hpp>
+
+namespace gismo
+{
+
+CLASS_TEMPLATE_INST gsSmoothedAggregation<real_t>;
+
+} // namespace gismo
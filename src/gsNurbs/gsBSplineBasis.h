@@ -314,6 +314,17 @@ public:
     virtual void evalAllDers_into(const gsMatrix<T> & u, int n,
                                   std::vector<gsMatrix<T> >& result) const;
 
+    /// @brief Same as evalAllDers_into(), but consecutive points of
+    /// \a u lying in the same knot span are evaluated together.
+    ///
+    /// The span is located once per run of points and the recurrences
+    /// run over structure-of-arrays buffers with the points in the
+    /// innermost (vectorizable) loop. The results are identical to
+    /// evalAllDers_into(). Best suited for points sorted by element,
+    /// such as quadrature nodes or sampling grids.
+    void evalAllDersBatch_into(const gsMatrix<T> & u, int n,
+                               std::vector<gsMatrix<T> >& result) const;
+
     // Look at gsBasis class for a description
     virtual void evalAllDersSingle_into(index_t i, const gsMatrix<T> & u,
                                         int n, gsMatrix<T>& result) const;
@@ -1056,6 +1056,171 @@ evalAllDers_into(const gsMatrix<T> & u, int n,
 }
 
 
+template <class T>
+void gsTensorBSplineBasis<1,T>::
+evalAllDersBatch_into(const gsMatrix<T> & u, int n,
+                      std::vector<gsMatrix<T> >& result) const
+{
+    GISMO_ASSERT( u.rows() == 1 , "gsBSplineBasis accepts points with one coordinate.");
+
+    const int p1 = m_p + 1;       // degree plus one
+
+    result.resize(n+1);
+    for(int k=0; k<=n; k++)
+        result[k].resize(m_p + 1, u.cols());
+
+    // Buffers with the point index running fastest, i.e. entry q of
+    // the run is at position i*np + q for scalar quantity i
+    std::vector<T> ndu, left, right, a, d;
+
+    index_t v = 0;
+    while (v < u.cols())
+    {
+        // Check if the point is in the domain
+        if ( ! inDomain( u(0,v) ) )
+        {
+            for(int k=0; k<=n; k++)
+                result[k].col(v).setZero();
+            ++v;
+            continue;
+        }
+
+        // Find the run of points in the span of the first one
+        typename KnotVectorType::iterator span = m_knots.iFind( u(0,v) );
+        const T ul = *span, ur = *(span+1);
+        index_t e = v + 1;
+        while ( e < u.cols() && ul <= u(0,e) &&
+                ( u(0,e) < ur || (u(0,e) == ur && inDomain(u(0,e)) &&
+                                  m_knots.iFind(u(0,e)) == span) ) )
+            ++e;
+        const index_t np = e - v;
+
+        ndu  .resize(p1 * p1 * np);
+        left .resize(p1 * np);
+        right.resize(p1 * np);
+        a    .resize(2 * p1 * np);
+        d    .resize(np);
+        const T * uu = &u(0,v);
+
+        // Function values triangle and knot differences, as in
+        // evalAllDers_into()
+        for (index_t q = 0; q != np; ++q)
+            ndu[q] = (T)(1) ; // 0-th degree function value
+        for(int j=1; j<= m_p; j++) // For all degrees ( ndu column)
+        {
+            const T kl = *(span+1-j), kr = *(span+j);
+            T * lj = &left [j*np];
+            T * rj = &right[j*np];
+            for (index_t q = 0; q != np; ++q)
+            {
+                lj[q] = uu[q] - kl;
+                rj[q] = kr - uu[q];
+                d[q]  = (T)(0) ; // saved
+            }
+
+            for(int r=0; r<j ; r++) // For all (except the last)  basis functions of degree j ( ndu row)
+            {
+                const T * R  = &right[(r+1)*np];
+                const T * L  = &left [(j-r)*np];
+                const T * N0 = &ndu[(r*p1 + j-1)*np];
+                T * Nd = &ndu[(j*p1 + r)*np];
+                T * N1 = &ndu[(r*p1 + j)*np];
+                for (index_t q = 0; q != np; ++q)
+                {
+                    Nd[q] = R[q] + L[q] ;
+                    const T temp = N0[q] / Nd[q] ;
+                    N1[q] = d[q] + R[q] * temp ;
+                    d[q]  = L[q] * temp ;
+                }
+            }
+            T * Nj = &ndu[(j*p1 + j)*np];
+            for (index_t q = 0; q != np; ++q)
+                Nj[q] = d[q] ;
+        }
+
+        // Assign 0-derivative equal to function values
+        for (int j=0; j <= m_p ; ++j )
+        {
+            const T * Nj = &ndu[(j*p1 + m_p)*np];
+            for (index_t q = 0; q != np; ++q)
+                result.front()(j,v+q) = Nj[q];
+        }
+
+        // Compute the derivatives
+        for(int r = 0; r <= m_p; r++)
+        {
+            // alternate rows in array a
+            T* a1 = &a[0];
+            T* a2 = &a[p1*np];
+
+            for (index_t q = 0; q != np; ++q)
+                a1[q] = (T)(1) ;
+
+            // Compute the k-th derivative of the r-th basis function
+            for(int k=1; k<=n; k++)
+            {
+                const int rk = r-k, pk = m_p-k ;
+                std::fill(d.begin(), d.end(), (T)(0));
+
+                if(r >= k)
+                {
+                    const T * Nd = &ndu[((pk+1)*p1 + rk)*np];
+                    const T * Nv = &ndu[(rk*p1 + pk)*np];
+                    for (index_t q = 0; q != np; ++q)
+                    {
+                        a2[q] = a1[q] / Nd[q] ;
+                        d[q]  = a2[q] * Nv[q] ;
+                    }
+                }
+
+                const int j1 = ( rk >= -1  ? 1   : -rk     );
+                const int j2 = ( r-1 <= pk ? k-1 : m_p - r );
+
+                for(int j = j1; j <= j2; j++)
+                {
+                    const T * Nd = &ndu[((pk+1)*p1 + rk+j)*np];
+                    const T * Nv = &ndu[((rk+j)*p1 + pk)*np];
+                    T * a2j = a2 + j*np;
+                    const T * a1j = a1 + j*np, * a1m = a1 + (j-1)*np;
+                    for (index_t q = 0; q != np; ++q)
+                    {
+                        a2j[q] = (a1j[q] - a1m[q]) / Nd[q] ;
+                        d[q] += a2j[q] * Nv[q] ;
+                    }
+                }
+
+                if(r <= pk)
+                {
+                    const T * Nd = &ndu[((pk+1)*p1 + r)*np];
+                    const T * Nv = &ndu[(r*p1 + pk)*np];
+                    T * a2k = a2 + k*np;
+                    const T * a1m = a1 + (k-1)*np;
+                    for (index_t q = 0; q != np; ++q)
+                    {
+                        a2k[q] = -a1m[q] / Nd[q] ;
+                        d[q] += a2k[q] * Nv[q] ;
+                    }
+                }
+
+                for (index_t q = 0; q != np; ++q)
+                    result[k](r, v+q) = d[q];
+
+                std::swap(a1, a2);              // Switch rows
+            }
+        }
+
+        v = e;
+    }// end for all runs of points
+
+    // Multiply through by the factor factorial(m_p)/factorial(m_p-k)
+    int r = m_p ;
+    for(int k=1; k<=n; k++)
+    {
+        result[k].array() *= (T)(r) ;
+        r *= m_p - k ;
+    }
+}
+
 template <class T>
 void gsTensorBSplineBasis<1,T>::refine_withCoefs(gsMatrix<T>& coefs, const std::vector<T>& knots)
 {
@@ -66,8 +66,7 @@ public:
         }
 
         // Case: mode: none/default
-        std::istringstream str;
-        str.str( node->value() );
+        const char * str = node->value();
         for (T knot; gsGetReal(str, knot);)
             knotValues.push_back(knot);
 
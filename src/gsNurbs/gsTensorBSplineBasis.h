@@ -217,6 +217,19 @@ public:
     // Look at gsBasis class for a description
     void active_into(const gsMatrix<T> & u, gsMatrix<index_t>& result) const;
 
+    /// @brief Evaluates the nonzero basis functions (\a n = 0) and
+    /// also their gradients (\a n = 1) on the tensor-product grid of
+    /// the coordinates in \a grid, which has one row vector per
+    /// direction.
+    ///
+    /// The result is the same as evalAllDers_into() on the points of
+    /// gsPointGrid(grid), first direction running fastest. The
+    /// univariate functions are evaluated once per coordinate, with
+    /// gsBSplineBasis::evalAllDersBatch_into(), and the tensor
+    /// products are built direction by direction.
+    void evalAllDersGrid_into(const std::vector<gsMatrix<T> > & grid, int n,
+                              std::vector<gsMatrix<T> >& result) const;
+
     /// Returns a box with the coordinate-wise active functions
     /// \param u evaluation points
     /// \param low lower left corner of the box
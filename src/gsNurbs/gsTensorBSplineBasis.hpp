@@ -43,6 +43,60 @@ active_cwise(const gsMatrix<T> & u,
     }
 }
 
+template<short_t d, class T>
+void gsTensorBSplineBasis<d,T>::
+evalAllDersGrid_into(const std::vector<gsMatrix<T> > & grid, int n,
+                     std::vector<gsMatrix<T> >& result) const
+{
+    GISMO_ASSERT( grid.size() == d, "Expecting one coordinate vector per direction");
+    GISMO_ASSERT( 0<=n && n<=1, "evalAllDersGrid_into() is implemented for n=0,1 only");
+
+    std::vector<gsMatrix<T> > values[d];
+    for (short_t i = 0; i < d; ++i)
+        component(i).evalAllDersBatch_into(grid[i], n, values[i]);
+
+    // Products of the univariate factors, rows and columns of the
+    // first direction running fastest
+    const gsMatrix<T> * f[d];
+    gsMatrix<T> tmp;
+    const auto tensorProduct = [&](gsMatrix<T> & res)
+    {
+        res = *f[0];
+        for (short_t k = 1; k < d; ++k)
+        {
+            const gsMatrix<T> & F = *f[k];
+            const index_t R = res.rows(), V = res.cols();
+            tmp.resize(R * F.rows(), V * F.cols());
+            for (index_t vk = 0; vk != F.cols(); ++vk)
+                for (index_t v = 0; v != V; ++v)
+                    for (index_t rk = 0; rk != F.rows(); ++rk)
+                        tmp.col(v + V*vk).segment(R*rk, R).noalias() = F(rk,vk) * res.col(v);
+            res.swap(tmp);
+        }
+    };
+
+    result.resize(n+1);
+    for (short_t i = 0; i < d; ++i)
+        f[i] = &values[i][0];
+    tensorProduct(result[0]);
+
+    if (n>=1)
+    {
+        // Partial derivatives are interleaved, row r*d+k is the
+        // derivative of function r w.r.t. variable k
+        gsMatrix<T> der;
+        result[1].resize(d*result[0].rows(), result[0].cols());
+        for (short_t k = 0; k < d; ++k)
+        {
+            f[k] = &values[k][1];
+            tensorProduct(der);
+            f[k] = &values[k][0];
+            for (index_t r = 0; r != der.rows(); ++r)
+                result[1].row(r*d+k) = der.row(r);
+        }
+    }
+}
+
 template<short_t d, class T>
 void gsTensorBSplineBasis<d,T>::
 refine_withTransfer(gsSparseMatrix<T,RowMajor> & transfer, 
@@ -364,6 +364,16 @@ public:
         return 0;
     }
 
+    /** @brief Start the computation of the sum over all processes
+        for each component of an array (non-blocking); the result is
+        available in every process after waiting for \a req
+    */
+    template<typename T>
+    static int isum (T* inout, int len, const MPI_Request* req)
+    {
+        return 0;
+    }
+
     /** @brief Compute the product of the argument over all processes
         and return the result in every process. Assumes that T has an
         operator*
@@ -627,6 +637,47 @@ public:
         return 0;
     }
 
+    /** @brief Sends data from all tasks to all tasks.
+     *
+     * The block of data with index from k*sendcount to
+     * (k+1)*sendcount-1 in the send array of each task is sent to
+     * task k, which stores the block received from task j at index
+     * j*recvcount to (j+1)*recvcount-1 of its recv array.
+     *
+     * @param[in] send The array to send.
+     * @param[out] recv The buffer to store the received data in.
+     * @param[in] sendcount The number of elements sent to each task.
+     * @param[in] recvcount The number of elements received from each task.
+     */
+    template<typename T>
+    static int alltoall (T* send, T* recv, int sendcount, int recvcount)
+    {
+        for (int i=0; i<sendcount; i++)
+            recv[i] = send[i];
+        return 0;
+    }
+
+    /** @brief Sends data of variable length from all tasks to all tasks.
+     *
+     * Each task sends sendcount[k] elements, starting at
+     * send+senddispl[k], to task k, which stores the elements received
+     * from task j at recv+recvdispl[j].
+     *
+     * @param[in] send The array to send.
+     * @param[in] sendcount The number of elements sent to each task.
+     * @param[in] senddispl The offsets of the blocks sent to each task.
+     * @param[out] recv The buffer to store the received data in.
+     * @param[in] recvcount The number of elements received from each task.
+     * @param[in] recvdispl The offsets of the blocks received from each task.
+     */
+    template<typename T>
+    static int alltoallv (T* send, int* sendcount, int* senddispl, T* recv, int* recvcount, int* recvdispl)
+    {
+        for (int i=0; i<*sendcount; i++)
+            recv[*recvdispl+i] = send[*senddispl+i];
+        return 0;
+    }
+
     /**
      * @brief Gathers data from all tasks and distribute it to all.
      *
@@ -1070,7 +1121,7 @@ public:
         }
     }
 
-    gsMpiComm(const gsSerialComm &) : m_comm(MPI_COMM_SELF) { }
+    gsMpiComm(const gsSerialComm &) : rank_(0), size_(1), m_comm(MPI_COMM_SELF) { }
 
     /**
      * @brief The type of the mpi communicator.
@@ -1358,8 +1409,7 @@ public:
                             root,m_comm);
     }
 
-    /// @copydoc gsSerialComm::scatter()
-    /// @note out must have space for P*len elements
+    /// @copydoc gsSerialComm::alltoall()
     template<typename T>
     int alltoall (T* send, T* recv, int sendcount, int recvcount) const
     {
@@ -1368,7 +1418,7 @@ public:
                             m_comm);
     }
 
-    /// @copydoc gsSerialComm::scatterv()
+    /// @copydoc gsSerialComm::alltoallv()
     template<typename T>
     int alltoallv (T* send, int* sendcount, int* senddispl, T* recv, int* recvcount, int* recvdispl) const
     {
@@ -44,6 +44,9 @@ namespace gismo
 ///
 /// but much faster.
 ///
+/// The operators \f$ A_i \f$ are applied in parallel, unless the same
+/// operator object has been added more than once.
+///
 /// @ingroup Solvers
 
 template<class T>
@@ -182,6 +185,12 @@ public:
     }
 
 protected:
+    /// @brief Returns true iff no operator object appears twice in \a m_ops
+    ///
+    /// Only the given objects are compared; operators shared by them
+    /// internally are not detected.
+    bool distinctOps() const;
+
     TransferPtrContainer m_transfers;   ///< Transfer matrices
     OpContainer m_ops;                  ///< Operators to be applied in the subspaces
 
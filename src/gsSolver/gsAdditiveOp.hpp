@@ -14,22 +14,41 @@
 namespace gismo
 {
 
+template<typename T>
+bool gsAdditiveOp<T>::distinctOps() const
+{
+    std::vector<const gsLinearOperator<T>*> ops(m_ops.size());
+    for (size_t i=0; i<m_ops.size(); ++i)
+        ops[i] = m_ops[i].get();
+    std::sort(ops.begin(), ops.end());
+    return std::adjacent_find(ops.begin(), ops.end()) == ops.end();
+}
+
 template<typename T>
 void gsAdditiveOp<T>::apply(const gsMatrix<T>& input, gsMatrix<T>& x) const
 {
     GISMO_ASSERT( this->rows() == input.rows(), "The dimensions do not fit." );
 
-    x.setZero( input.rows(), input.cols() );
-
     const index_t n = m_ops.size();
-    gsMatrix<T> res_local, corr_local;
 
-    for (index_t i=0; i<n; ++i)
+    // The local problems are independent, so they are solved in parallel.
+    // The local operators might have buffers of their own, so this is only
+    // done if none of them appears twice.
+    std::vector< gsMatrix<T> > corr_local(n);
+#   pragma omp parallel if(n > 1 && distinctOps())
     {
-        res_local.noalias() = m_transfers[i]->transpose()*input;
-        m_ops[i]->apply(res_local, corr_local);
-        x.noalias() += *(m_transfers[i])*corr_local;
+        gsMatrix<T> res_local;
+#       pragma omp for schedule(dynamic,1)
+        for (index_t i=0; i<n; ++i)
+        {
+            res_local.noalias() = m_transfers[i]->transpose()*input;
+            m_ops[i]->apply(res_local, corr_local[i]);
+        }
     }
+
+    x.setZero( input.rows(), input.cols() );
+    for (index_t i=0; i<n; ++i)
+        x.noalias() += *(m_transfers[i])*corr_local[i];
 }
 
 } // namespace gismo
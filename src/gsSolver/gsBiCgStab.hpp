@@ -23,18 +23,18 @@ bool gsBiCgStab<T>::initIteration( const typename gsBiCgStab<T>::VectorType& rhs
 
     // m_res = rhs - A * x;
     m_mat->apply(x,m_tmp);
-    m_res = rhs - m_tmp;
+    internal::parallelAxpbypcz((T)(1), rhs, (T)(-1), m_tmp, (T)(0), m_res);
 
-    m_r0 = m_res;
+    internal::parallelAxpby((T)(1), m_res, (T)(0), m_r0);
 
-    m_p.setZero(m_mat->cols(), 1);
-    m_v.setZero(m_mat->cols(), 1);
+    internal::parallelSetZero(m_p, m_mat->cols(), 1);
+    internal::parallelSetZero(m_v, m_mat->cols(), 1);
 
     m_alpha = 1;
     m_rho = 1;
     m_w = 1;
 
-    m_error = m_res.norm() / m_rhs_norm;
+    m_error = internal::parallelNorm(m_res) / m_rhs_norm;
 
     return m_error < m_tol;
 
@@ -44,41 +44,43 @@ template<class T>
 bool gsBiCgStab<T>::step( typename gsBiCgStab<T>::VectorType& x )
 {
     T rho_old = m_rho;
-    m_rho = m_r0.col(0).dot(m_res.col(0));
+    m_rho = internal::parallelDot(m_r0, m_res);
 
-    if (math::abs(m_rho) < m_restartThereshold * m_r0.col(0).dot(m_r0.col(0)) )
+    if (math::abs(m_rho) < m_restartThereshold * internal::parallelDot(m_r0, m_r0) )
     {
         gsInfo << "Residual almost orthogonal, restart with new r0 \n";
-        m_r0 = m_res;
-        m_rho = m_r0.col(0).dot(m_r0.col(0)); //= r0_sqnorm
+        internal::parallelAxpby((T)(1), m_res, (T)(0), m_r0);
+        m_rho = internal::parallelDot(m_r0, m_r0); //= r0_sqnorm
     }
 
     T beta = (m_rho/rho_old)*(m_alpha/m_w);
-    m_p = m_res + beta*(m_p - m_w * m_v);
+    // m_p = m_res + beta*(m_p - m_w * m_v)
+    internal::parallelAxpbypcz((T)(1), m_res, -beta*m_w, m_v, beta, m_p);
 
     // Apply preconditioning by solving Ahat m_y = m_p
     m_precond->apply(m_p, m_y);
     // m_v = A * m_y;
     m_mat->apply(m_y, m_v);
-    m_alpha = m_rho/(m_r0.col(0).dot(m_v.col(0)));
+    m_alpha = m_rho/internal::parallelDot(m_r0, m_v);
 
-    m_s.noalias() = m_res - m_alpha * m_v;
+    internal::parallelAxpbypcz((T)(1), m_res, -m_alpha, m_v, (T)(0), m_s);
     // Apply preconditioning by solving Ahat m_z = m_s
     m_precond->apply(m_s, m_z);
 
     // m_t = A * m_z;
     m_mat->apply(m_z, m_t);
 
-    if (m_t.col(0).dot(m_t.col(0)) > 0)
-        m_w = m_t.col(0).dot(m_s.col(0))/m_t.col(0).dot(m_t.col(0));
+    const T tt = internal::parallelDot(m_t, m_t);
+    if (tt > 0)
+        m_w = internal::parallelDot(m_t, m_s)/tt;
     else
         m_w = 0;
 
     // Update iterate and residual
-    x.noalias() += m_alpha * m_y + m_w * m_z;
-    m_res.noalias() -= m_alpha * m_v + m_w * m_t;
+    internal::parallelAxpbypcz(m_alpha, m_y, m_w, m_z, (T)(1), x);
+    internal::parallelAxpbypcz(-m_alpha, m_v, -m_w, m_t, (T)(1), m_res);
 
-    m_error = m_res.norm() / m_rhs_norm;
+    m_error = internal::parallelNorm(m_res) / m_rhs_norm;
     return m_error < m_tol;
 
 }
@@ -0,0 +1,111 @@
+/** @file gsBlockCG.h
+
+    @brief Block conjugate gradient solver for several right-hand sides
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gsSolver/gsIterativeSolver.h>
+
+namespace gismo
+{
+
+/// @brief The block conjugate gradient method.
+///
+/// Solves a symmetric positive definite system for several right-hand
+/// sides (the columns of the right-hand side) at once. The search
+/// space of each column is the sum of the Krylov spaces of all
+/// columns, which reduces the number of iterations. Moreover, the
+/// operator and the preconditioner are applied to all search
+/// directions at once (a sparse matrix times a dense block, SpMM).
+///
+/// This is the breakdown-free variant by Ji and Li (Comput. Math.
+/// Appl. 73, 2017): the block of search directions is orthonormalized
+/// in every step, and directions which are (numerically) linearly
+/// dependent are dropped. So, the block size may decrease during the
+/// iteration, for instance, if some of the systems have converged.
+///
+/// The error is the maximum of the relative residuals of the columns.
+/// If the method breaks down, i.e., if the operator or the
+/// preconditioner turns out not to be positive definite, the solver
+/// stops with a warning and the error of the last iterate, which is
+/// above the tolerance.
+///
+/// \ingroup Solver
+template<class T = real_t>
+class gsBlockCG : public gsIterativeSolver<T>
+{
+public:
+    typedef gsIterativeSolver<T> Base;
+
+    typedef gsMatrix<T>  VectorType;
+
+    typedef typename Base::LinOpPtr LinOpPtr;
+
+    typedef memory::shared_ptr<gsBlockCG> Ptr;
+    typedef memory::unique_ptr<gsBlockCG> uPtr;
+
+    /// @brief Constructor using a matrix (operator) and optionally a preconditionner
+    ///
+    /// @param mat     The operator to be solved for, see gsIterativeSolver for details
+    /// @param precond The preconditioner, defaulted to the identity
+    template< typename OperatorType >
+    explicit gsBlockCG( const OperatorType& mat, const LinOpPtr& precond = LinOpPtr() )
+    : Base(mat, precond) {}
+
+    /// @brief Make function using a matrix (operator) and optionally a preconditionner
+    ///
+    /// @param mat     The operator to be solved for, see gsIterativeSolver for details
+    /// @param precond The preconditioner, defaulted to the identity
+    template< typename OperatorType >
+    static uPtr make( const OperatorType& mat, const LinOpPtr& precond = LinOpPtr() )
+    { return uPtr( new gsBlockCG(mat, precond) ); }
+
+    bool initIteration( const VectorType& rhs, VectorType& x );
+    bool step( VectorType& x );
+
+    /// Returns the current number of search directions
+    index_t blockSize() const { return m_P.cols(); }
+
+    /// Prints the object as a string.
+    std::ostream &print(std::ostream &os) const
+    {
+        os << "gsBlockCG\n";
+        return os;
+    }
+
+private:
+
+    /// Computes the maximum of the relative residuals of the columns
+    void computeError();
+
+    /// Computes the new search directions from \a W
+    void orthonormalize( gsMatrix<T> & W );
+
+private:
+    using Base::m_mat;
+    using Base::m_precond;
+    using Base::m_max_iters;
+    using Base::m_tol;
+    using Base::m_num_iter;
+    using Base::m_rhs_norm;
+    using Base::m_error;
+
+    gsMatrix<T> m_R;             ///< Residuals
+    gsMatrix<T> m_Z;             ///< Preconditioned residuals
+    gsMatrix<T> m_P;             ///< Search directions
+    gsMatrix<T> m_Q;             ///< Image of the search directions
+    gsMatrix<T> m_rhsNorms;      ///< Norms of the columns of the right-hand side
+};
+
+} // namespace gismo
+
+#ifndef GISMO_BUILD_LIB
+#include GISMO_HPP_HEADER(gsBlockCG.hpp)
+#endif
@@ -0,0 +1,150 @@
+/** @file gsBlockCG.hpp
+
+    @brief Block conjugate gradient solver for several right-hand sides
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+namespace gismo
+{
+
+template<class T>
+bool gsBlockCG<T>::initIteration( const typename gsBlockCG<T>::VectorType& rhs,
+                                  typename gsBlockCG<T>::VectorType& x )
+{
+    GISMO_ASSERT( rhs.rows() == m_mat->rows(),
+                  "The right-hand side does not match the matrix: "
+                  << rhs.rows() <<"!="<< m_mat->rows() );
+
+    m_num_iter = 0;
+    m_rhsNorms = rhs.colwise().norm();
+    m_rhs_norm = m_rhsNorms.size() ? m_rhsNorms.maxCoeff() : (T)(0);
+
+    if (0 == m_rhs_norm) // special case of zero rhs
+    {
+        x.setZero(rhs.rows(),rhs.cols()); // for sure zero is a solution
+        m_error = 0.;
+        return true; // iteration is finished
+    }
+    // Vanishing columns are measured relative to the largest one
+    for (index_t j = 0; j < m_rhsNorms.cols(); ++j)
+        if (0 == m_rhsNorms(0,j))
+            m_rhsNorms(0,j) = m_rhs_norm;
+
+    if ( 0 == x.size() ) // if no initial solution, start with zeros
+        x.setZero(rhs.rows(), rhs.cols());
+    else
+    {
+        GISMO_ASSERT( x.cols() == rhs.cols(),
+                      "The initial guess does not match the right-hand side: "
+                      << x.cols() <<"!="<< rhs.cols() );
+        GISMO_ASSERT( x.rows() == m_mat->cols(),
+                      "The initial guess does not match the matrix: "
+                      << x.rows() <<"!="<< m_mat->cols() );
+    }
+
+    m_mat->apply(x, m_Q);
+    m_R = rhs - m_Q;                                 // initial residuals
+    computeError();
+    if (m_error < m_tol)
+        return true;
+
+    m_precond->apply(m_R, m_Z);
+    orthonormalize(m_Z);                             // initial search directions
+    if (0 == m_P.cols())
+    {
+        gsWarn << "gsBlockCG: The preconditioned residuals vanish, but the residuals do not.\n";
+        return true;
+    }
+    return false;
+}
+
+template<class T>
+bool gsBlockCG<T>::step( typename gsBlockCG<T>::VectorType& x )
+{
+    m_mat->apply(m_P, m_Q);                                          // one SpMM for all directions
+
+    // The search directions are not conjugate to each other, so the
+    // step lengths are given by the projected system
+    const gsMatrix<T> PtQ = m_P.transpose() * m_Q;
+    gsEigen::LLT<typename gsMatrix<T>::Base> llt(PtQ);
+    if (llt.info() != gsEigen::Success)
+    {
+        // The error stays at the value of the last iterate
+        gsWarn << "gsBlockCG: Breakdown, the operator is not positive definite.\n";
+        return true;
+    }
+
+    gsMatrix<T> alpha = m_P.transpose() * m_R;
+    llt.solveInPlace(alpha);
+    x.noalias()   += m_P * alpha;
+    m_R.noalias() -= m_Q * alpha;
+
+    computeError();
+    if (m_error < m_tol)
+        return true;
+
+    m_precond->apply(m_R, m_Z);
+
+    // Make the new directions A-conjugate to the previous ones
+    gsMatrix<T> beta = m_Q.transpose() * m_Z;
+    llt.solveInPlace(beta);
+    m_Z.noalias() -= m_P * beta;
+    orthonormalize(m_Z);
+
+    if (0 == m_P.cols())                                             // no search direction left
+    {
+        gsWarn << "gsBlockCG: Breakdown, no search direction left.\n";
+        return true;
+    }
+    return false;
+}
+
+template<class T>
+void gsBlockCG<T>::computeError()
+{
+    m_error = ( m_R.colwise().norm().array() / m_rhsNorms.array() ).maxCoeff();
+}
+
+template<class T>
+void gsBlockCG<T>::orthonormalize( gsMatrix<T> & W )
+{
+    // Orthonormalization by the eigendecomposition of the Gram matrix,
+    // where the eigenvectors of small eigenvalues are dropped. This is
+    // applied twice since the first pass loses orthogonality if the
+    // columns are nearly dependent. The columns are normalized first,
+    // so the directions of a column with a small residual are kept.
+    for (index_t j = 0; j < W.cols(); ++j)
+    {
+        const T nrm = W.col(j).norm();
+        if (0 != nrm)
+            W.col(j) /= nrm;
+    }
+
+    const T eps = 10000 * std::numeric_limits<T>::epsilon();
+    for (index_t pass = 0; pass < 2; ++pass)
+    {
+        const gsMatrix<T> G = W.transpose() * W;
+        gsEigen::SelfAdjointEigenSolver<typename gsMatrix<T>::Base> eig(G);
+        const gsMatrix<T> & lambda = eig.eigenvalues();    // ascending order
+        const T lmax = lambda.size() ? lambda(lambda.size()-1,0) : (T)(0);
+
+        index_t first = 0;
+        while ( first < lambda.size() && lambda(first,0) <= eps * lmax )
+            ++first;
+        const index_t b = lambda.size() - first;
+
+        gsMatrix<T> S = eig.eigenvectors().rightCols(b);
+        for (index_t j = 0; j < b; ++j)
+            S.col(j) /= math::sqrt(lambda(first+j,0));
+        m_P.noalias() = W * S;
+        if (0 == pass)
+            W.swap(m_P);
+    }
+}
+
+} // end namespace gismo
@@ -0,0 +1,9 @@
+#include <gsSolver/gsBlockCG.h>
+#include <gsSolver/gsBlockCG.hpp>
+
+namespace gismo
+{
+
+CLASS_TEMPLATE_INST gsBlockCG<real_t>;
+
+} // namespace gismo
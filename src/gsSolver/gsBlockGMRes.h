@@ -0,0 +1,132 @@
+/** @file gsBlockGMRes.h
+
+    @brief Block GMRES solver for several right-hand sides
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#pragma once
+
+#include <gsSolver/gsIterativeSolver.h>
+
+namespace gismo
+{
+
+/// @brief The block generalized minimal residual (GMRES) method.
+///
+/// The restarted GMRES method with right preconditioning for several
+/// right-hand sides (the columns of the right-hand side) at once. The
+/// block Arnoldi process builds an orthonormal basis of the sum of
+/// the Krylov spaces of all columns, so the operator and the
+/// preconditioner are applied to a block of \f$ m \f$ vectors (a
+/// sparse matrix times a dense block, SpMM) in every step. A new
+/// block is orthogonalized against the previous ones by block
+/// classical Gram-Schmidt and among itself by the Householder QR
+/// factorization, both applied twice. The corrections minimize the
+/// residuals of all columns over the block Krylov space.
+///
+/// The number of iterations is the number of blocks; the basis is
+/// restarted after "Restart" blocks. The error is the maximum of the
+/// relative residuals of the columns.
+///
+/// \ingroup Solver
+template<class T = real_t>
+class gsBlockGMRes : public gsIterativeSolver<T>
+{
+public:
+    typedef gsIterativeSolver<T> Base;
+
+    typedef gsMatrix<T>  VectorType;
+
+    typedef typename Base::LinOpPtr LinOpPtr;
+
+    typedef memory::shared_ptr<gsBlockGMRes> Ptr;
+    typedef memory::unique_ptr<gsBlockGMRes> uPtr;
+
+    /// @brief Constructor using a matrix (operator) and optionally a preconditionner
+    ///
+    /// @param mat     The operator to be solved for, see gsIterativeSolver for details
+    /// @param precond The preconditioner, defaulted to the identity
+    template< typename OperatorType >
+    explicit gsBlockGMRes( const OperatorType& mat, const LinOpPtr& precond = LinOpPtr() )
+    : Base(mat, precond), m_restart(20) {}
+
+    /// @brief Make function using a matrix (operator) and optionally a preconditionner
+    ///
+    /// @param mat     The operator to be solved for, see gsIterativeSolver for details
+    /// @param precond The preconditioner, defaulted to the identity
+    template< typename OperatorType >
+    static uPtr make( const OperatorType& mat, const LinOpPtr& precond = LinOpPtr() )
+    { return uPtr( new gsBlockGMRes(mat, precond) ); }
+
+    /// @brief Returns a list of default options
+    static gsOptionList defaultOptions()
+    {
+        gsOptionList opt = Base::defaultOptions();
+        opt.addInt("Restart", "Number of blocks of the Krylov space before restarting", 20 );
+        return opt;
+    }
+
+    /// @brief Set the options based on a gsOptionList
+    gsBlockGMRes& setOptions(const gsOptionList& opt)
+    {
+        Base::setOptions(opt);
+        m_restart = opt.askInt("Restart", m_restart);
+        return *this;
+    }
+
+    bool initIteration( const VectorType& rhs, VectorType& x );
+    bool step( VectorType& x );
+    void finalizeIteration( VectorType& x );
+
+    /// @brief Set the number of blocks of the Krylov space before restarting
+    void setRestart( index_t restart )       { m_restart = restart; }
+
+    /// Prints the object as a string.
+    std::ostream &print(std::ostream &os) const
+    {
+        os << "gsBlockGMRes\n";
+        return os;
+    }
+
+private:
+
+    /// Starts a new cycle with the residuals of \a x
+    bool restart( const VectorType& x );
+
+    /// Computes the thin QR factorization of \a W
+    static void thinQr( const gsMatrix<T> & W, gsMatrix<T> & Q, gsMatrix<T> & R );
+
+    /// Adds the correction of the current cycle to \a x
+    void updateSolution( VectorType& x );
+
+private:
+    using Base::m_mat;
+    using Base::m_precond;
+    using Base::m_max_iters;
+    using Base::m_tol;
+    using Base::m_num_iter;
+    using Base::m_rhs_norm;
+    using Base::m_error;
+
+    index_t m_restart;
+
+    const VectorType * m_rhs;
+    gsMatrix<T> m_V;          ///< Orthonormal basis of the block Krylov space
+    gsMatrix<T> m_H;          ///< Block Hessenberg matrix
+    gsMatrix<T> m_B;          ///< Triangular factor of the residuals at the start of the cycle
+    gsMatrix<T> m_Y;          ///< Coefficients of the corrections
+    gsMatrix<T> m_rhsNorms;   ///< Norms of the columns of the right-hand side
+    VectorType m_tmp, m_tmp2;
+    index_t m_m;              ///< Number of right-hand sides
+    index_t m_k;              ///< Number of blocks of the current cycle
+};
+
+} // namespace gismo
+
+#ifndef GISMO_BUILD_LIB
+#include GISMO_HPP_HEADER(gsBlockGMRes.hpp)
+#endif
@@ -0,0 +1,152 @@
+/** @file gsBlockGMRes.hpp
+
+    @brief Block GMRES solver for several right-hand sides
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+namespace gismo
+{
+
+template<class T>
+bool gsBlockGMRes<T>::initIteration( const typename gsBlockGMRes<T>::VectorType& rhs,
+                                     typename gsBlockGMRes<T>::VectorType& x )
+{
+    GISMO_ASSERT( rhs.rows() == m_mat->rows(),
+                  "The right-hand side does not match the matrix: "
+                  << rhs.rows() <<"!="<< m_mat->rows() );
+    GISMO_ASSERT( m_restart > 0, "Invalid restart." );
+
+    m_num_iter = 0;
+    m_rhsNorms = rhs.colwise().norm();
+    m_rhs_norm = m_rhsNorms.size() ? m_rhsNorms.maxCoeff() : (T)(0);
+
+    if (0 == m_rhs_norm) // special case of zero rhs
+    {
+        x.setZero(rhs.rows(),rhs.cols()); // for sure zero is a solution
+        m_error = 0.;
+        return true; // iteration is finished
+    }
+    // Vanishing columns are measured relative to the largest one
+    for (index_t j = 0; j < m_rhsNorms.cols(); ++j)
+        if (0 == m_rhsNorms(0,j))
+            m_rhsNorms(0,j) = m_rhs_norm;
+
+    if ( 0 == x.size() ) // if no initial solution, start with zeros
+        x.setZero(rhs.rows(), rhs.cols());
+    else
+    {
+        GISMO_ASSERT( x.cols() == rhs.cols(),
+                      "The initial guess does not match the right-hand side: "
+                      << x.cols() <<"!="<< rhs.cols() );
+        GISMO_ASSERT( x.rows() == m_mat->cols(),
+                      "The initial guess does not match the matrix: "
+                      << x.rows() <<"!="<< m_mat->cols() );
+    }
+
+    m_rhs = &rhs; // needed for the restarts
+    m_m = rhs.cols();
+    m_V.setZero(m_mat->rows(), (m_restart+1)*m_m);
+    m_H.setZero((m_restart+1)*m_m, m_restart*m_m);
+    m_k = 0;
+
+    return restart(x);
+}
+
+template<class T>
+bool gsBlockGMRes<T>::restart( const typename gsBlockGMRes<T>::VectorType& x )
+{
+    m_mat->apply(x, m_tmp);
+    m_tmp = *m_rhs - m_tmp;
+    m_H.setZero();
+    m_k = 0;
+
+    m_error = ( m_tmp.colwise().norm().array() / m_rhsNorms.array() ).maxCoeff();
+    if (m_error < m_tol)
+        return true;
+
+    thinQr(m_tmp, m_tmp2, m_B);
+    m_V.leftCols(m_m) = m_tmp2;
+    return false;
+}
+
+template<class T>
+void gsBlockGMRes<T>::thinQr( const gsMatrix<T> & W, gsMatrix<T> & Q, gsMatrix<T> & R )
+{
+    const index_t m = W.cols();
+    gsEigen::HouseholderQR<typename gsMatrix<T>::Base> qr(W);
+    Q = qr.householderQ() * gsMatrix<T>::Identity(W.rows(), m);
+    R = qr.matrixQR().topRows(m).template triangularView<gsEigen::Upper>();
+}
+
+template<class T>
+bool gsBlockGMRes<T>::step( typename gsBlockGMRes<T>::VectorType& x )
+{
+    const index_t m = m_m, k = m_k;
+    typename gsMatrix<T>::Columns V = m_V.leftCols((k+1)*m);
+
+    // W = A M^{-1} V_k, both operators are applied to the whole block
+    m_tmp = m_V.middleCols(k*m, m);
+    m_precond->apply(m_tmp, m_tmp2);
+    m_mat->apply(m_tmp2, m_tmp);
+
+    // Block classical Gram-Schmidt and Householder QR, applied twice:
+    // W = V C1 + Q1 R1 and Q1 = V C2 + Q2 R2
+    gsMatrix<T> C1, C2, Q, R1, R2;
+    C1.noalias() = V.transpose() * m_tmp;
+    m_tmp.noalias() -= V * C1;
+    thinQr(m_tmp, Q, R1);
+    C2.noalias() = V.transpose() * Q;
+    Q.noalias() -= V * C2;
+    thinQr(Q, m_tmp, R2);
+
+    m_V.middleCols((k+1)*m, m) = m_tmp;
+    m_H.block(0, k*m, (k+1)*m, m).noalias() = C1 + C2 * R1;
+    m_H.block((k+1)*m, k*m, m, m).noalias() = R2 * R1;
+    ++m_k;
+
+    // Least squares problem: min || E_1 B - H Y || for all columns at once
+    gsMatrix<T> G = gsMatrix<T>::Zero((m_k+1)*m, m);
+    G.topRows(m) = m_B;
+    const gsMatrix<T> H = m_H.topLeftCorner((m_k+1)*m, m_k*m);
+    m_Y = H.colPivHouseholderQr().solve(G);
+    G.noalias() -= H * m_Y;
+    m_error = ( G.colwise().norm().array() / m_rhsNorms.array() ).maxCoeff();
+
+    if (m_error < m_tol)
+    {
+        updateSolution(x);
+        return true;
+    }
+
+    if (m_k == m_restart)
+    {
+        updateSolution(x);
+        return restart(x);
+    }
+    return false;
+}
+
+template<class T>
+void gsBlockGMRes<T>::updateSolution( typename gsBlockGMRes<T>::VectorType& x )
+{
+    if (0 == m_k)
+        return;
+    m_tmp2.noalias() = m_V.leftCols(m_k*m_m) * m_Y;
+    m_precond->apply(m_tmp2, m_tmp);
+    x += m_tmp;
+    m_k = 0;
+}
+
+template<class T>
+void gsBlockGMRes<T>::finalizeIteration( typename gsBlockGMRes<T>::VectorType& x )
+{
+    // Add the correction of an unfinished cycle
+    updateSolution(x);
+}
+
+} // end namespace gismo
@@ -0,0 +1,219 @@
+/** @file gsChebyshevOp.h
+
+    @brief Chebyshev polynomial smoother.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#pragma once
+
+#include <gsSolver/gsPreconditioner.h>
+#include <gsSolver/gsConjugateGradient.h>
+#include <gsSolver/gsSimplePreconditioners.h>
+
+namespace gismo
+{
+
+/// @brief Chebyshev polynomial smoother
+///
+/// One step applies the Chebyshev iteration of the given degree to
+/// \f$ PA \f$, where \f$ A \f$ is the underlying operator and \f$ P \f$
+/// an (optional) inner preconditioner, usually the inverse of the
+/// diagonal. The polynomial is small on the interval
+/// \f$ [\lambda_{\max}/r, s\lambda_{\max}] \f$, i.e., on the upper part
+/// of the spectrum, which is what a multigrid smoother has to damp.
+/// Here \f$ r \f$ is the option "EigenvalueRatio" and \f$ s \f$ the
+/// option "EigenvalueSafety".
+///
+/// The largest eigenvalue \f$ \lambda_{\max} \f$ of \f$ PA \f$ is
+/// estimated by a few steps of gsConjugateGradient, from the
+/// eigenvalues of its Lanczos matrix, when the operator is first
+/// applied. It can also be provided by setMaxEigenvalue().
+///
+/// A step only needs applications of \f$ A \f$ and \f$ P \f$, so the
+/// smoother works matrix-free and parallelizes as well as these
+/// operators. \f$ A \f$ and \f$ P \f$ are assumed to be symmetric
+/// and positive definite.
+///
+/// \ingroup Solver
+template<class T>
+class gsChebyshevOp GISMO_FINAL : public gsPreconditionerOp<T>
+{
+public:
+
+    /// Shared pointer for gsChebyshevOp
+    typedef memory::shared_ptr<gsChebyshevOp> Ptr;
+
+    /// Unique pointer for gsChebyshevOp
+    typedef memory::unique_ptr<gsChebyshevOp> uPtr;
+
+    /// Base class
+    typedef gsPreconditionerOp<T> Base;
+
+    /// Base class
+    typedef typename gsLinearOperator<T>::Ptr BasePtr;
+
+    /**
+     * @brief Constructor
+     * @param underlying      The underlying operator \f$ A \f$.
+     * @param preconditioner  The inner preconditioner \f$ P \f$, a null
+     *                        pointer is defaulted to the identity.
+     * @param degree          The degree of the Chebyshev polynomial.
+     */
+    gsChebyshevOp(BasePtr underlying, BasePtr preconditioner = BasePtr(), index_t degree = 2)
+    : m_underlying(give(underlying)), m_preconditioner(give(preconditioner)),
+      m_degree(degree), m_eigRatio(30), m_eigSafety((T)(1.1)), m_eigSteps(10), m_lmax(-1)
+    {
+        if (!m_preconditioner)
+            m_preconditioner = gsIdentityOp<T>::make(m_underlying->rows());
+        GISMO_ASSERT( m_underlying->rows() == m_underlying->cols()
+            && m_preconditioner->rows() == m_preconditioner->cols()
+            && m_underlying->rows() == m_preconditioner->rows(),
+            "The dimensions do not agree." );
+    }
+
+    /// Make function returning a smart pointer
+    static uPtr make(BasePtr underlying, BasePtr preconditioner = BasePtr(), index_t degree = 2)
+    { return uPtr( new gsChebyshevOp(give(underlying), give(preconditioner), degree) ); }
+
+    void step(const gsMatrix<T> & rhs, gsMatrix<T> & x) const
+    {
+        GISMO_ASSERT( m_underlying->rows() == x.rows() && x.rows() == rhs.rows() && x.cols() == rhs.cols(),
+            "The dimensions do not agree." );
+
+        m_underlying->apply(x, m_res);
+        m_res = rhs - m_res;
+        iterate(x);
+    }
+
+    // We use our own apply implementation as we can save one multiplication
+    // in the first sweep, where the initial guess is zero.
+    void apply(const gsMatrix<T> & input, gsMatrix<T> & x) const
+    {
+        GISMO_ASSERT( m_underlying->rows() == input.rows(), "The dimensions do not agree." );
+
+        x.setZero(input.rows(), input.cols());
+        m_res = input;
+        iterate(x);
+
+        for (index_t i = 1; i < m_num_of_sweeps; ++i)
+            step(input, x);
+    }
+
+    index_t rows() const { return m_underlying->rows(); }
+    index_t cols() const { return m_underlying->cols(); }
+
+    BasePtr underlyingOp() const { return m_underlying; }
+
+    /// Set the degree of the Chebyshev polynomial
+    void setDegree(index_t degree) { m_degree = degree; }
+
+    /// Set the largest eigenvalue of \f$ PA \f$, skipping its estimation
+    void setMaxEigenvalue(T lmax) { m_lmax = lmax; }
+
+    /// Returns the (estimated) largest eigenvalue of \f$ PA \f$
+    T maxEigenvalue() const
+    {
+        if (m_lmax < 0)
+            estimateMaxEigenvalue();
+        return m_lmax;
+    }
+
+    /// Get the default options as gsOptionList object
+    static gsOptionList defaultOptions()
+    {
+        gsOptionList opt = Base::defaultOptions();
+        opt.addInt ( "PolynomialDegree", "Degree of the Chebyshev polynomial", 2 );
+        opt.addReal( "EigenvalueRatio", "Ratio of the largest eigenvalue and the lower end of the smoothing interval", 30 );
+        opt.addReal( "EigenvalueSafety", "Factor for the estimate of the largest eigenvalue", 1.1 );
+        opt.addInt ( "EigenvalueSteps", "Number of CG steps for estimating the largest eigenvalue", 10 );
+        return opt;
+    }
+
+    /// Set options based on a gsOptionList object
+    virtual void setOptions(const gsOptionList & opt)
+    {
+        Base::setOptions(opt);
+        m_degree    = opt.askInt ( "PolynomialDegree", m_degree   );
+        m_eigRatio  = opt.askReal( "EigenvalueRatio",  m_eigRatio );
+        m_eigSafety = opt.askReal( "EigenvalueSafety", m_eigSafety);
+        m_eigSteps  = opt.askInt ( "EigenvalueSteps",  m_eigSteps );
+    }
+
+private:
+
+    // Chebyshev iteration for the residual m_res = rhs - A x
+    void iterate(gsMatrix<T> & x) const
+    {
+        const T lmax  = maxEigenvalue() * m_eigSafety;
+        const T lmin  = maxEigenvalue() / m_eigRatio;
+        const T theta = (lmax + lmin) / 2;
+        const T delta = (lmax - lmin) / 2;
+        const T sigma = theta / delta;
+        T rho = 1 / sigma;
+
+        m_preconditioner->apply(m_res, m_z);
+        m_dir = m_z / theta;
+
+        for (index_t k = 1; ; ++k)
+        {
+            x += m_dir;
+            if (k >= m_degree)
+                break;
+
+            m_underlying->apply(m_dir, m_tmp);
+            m_res -= m_tmp;
+            m_preconditioner->apply(m_res, m_z);
+
+            const T rhoNew = 1 / (2 * sigma - rho);
+            m_dir *= rhoNew * rho;
+            m_dir += (2 * rhoNew / delta) * m_z;
+            rho = rhoNew;
+        }
+    }
+
+    // Estimates the largest eigenvalue from the Lanczos matrix of CG
+    void estimateMaxEigenvalue() const
+    {
+        gsMatrix<T> rhs, x, eigs;
+        rhs.setRandom(rows(), 1);
+        x.setZero(rows(), 1);
+        gsConjugateGradient<T> cg(m_underlying, m_preconditioner);
+        cg.setCalcEigenvalues(true);
+        cg.setMaxIterations(m_eigSteps);
+        cg.solve(rhs, x);
+        cg.getEigenvalues(eigs);
+        GISMO_ENSURE( eigs.size() > 0, "The eigenvalue estimation failed." );
+        m_lmax = eigs.maxCoeff();
+    }
+
+private:
+    BasePtr m_underlying;
+    BasePtr m_preconditioner;
+    index_t m_degree;
+    T m_eigRatio;
+    T m_eigSafety;
+    index_t m_eigSteps;
+    mutable T m_lmax;
+    mutable gsMatrix<T> m_res, m_z, m_dir, m_tmp;
+    using Base::m_num_of_sweeps;
+};
+
+/// @brief Returns a smart pointer to a Chebyshev smoother for the
+/// matrix \a mat, preconditioned by its diagonal
+/// \relates gsChebyshevOp
+template <class Derived>
+typename gsChebyshevOp<typename Derived::Scalar>::uPtr makeChebyshevOp(const gsEigen::EigenBase<Derived>& mat, index_t degree = 2)
+{ return gsChebyshevOp<typename Derived::Scalar>::make(makeMatrixOp(mat.derived()), makeJacobiOp(mat.derived()), degree); }
+
+/// @brief Returns a smart pointer to a Chebyshev smoother for the
+/// matrix \a mat, preconditioned by its diagonal
+/// \relates gsChebyshevOp
+template <class Derived>
+typename gsChebyshevOp<typename Derived::Scalar>::uPtr makeChebyshevOp(const memory::shared_ptr<Derived>& mat, index_t degree = 2)
+{ return gsChebyshevOp<typename Derived::Scalar>::make(makeMatrixOp(mat), makeJacobiOp(mat), degree); }
+
+} // namespace gismo
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <gsSolver/gsIterativeSolver.h>
+#include <gsParallel/gsMpi.h>
 
 namespace gismo
 {
@@ -24,6 +25,10 @@ namespace gismo
 /// general preconditioners and better iteration control. Also capable of using
 /// a gsLinearOperator as matrix.
 ///
+/// If a communicator is set by setComm, the vectors are the local parts
+/// of distributed vectors (like for gsDistributedMatrixOp), and the
+/// inner products are summed up over the processes.
+///
 /// \ingroup Solver
 template<class T = real_t>
 class gsConjugateGradient : public gsIterativeSolver<T>
@@ -45,7 +50,7 @@ public:
     template< typename OperatorType >
     explicit gsConjugateGradient( const OperatorType& mat,
                                   const LinOpPtr& precond = LinOpPtr() )
-    : Base(mat, precond), m_calcEigenvals(false) {}
+    : Base(mat, precond), m_comm(gsSerialComm()), m_calcEigenvals(false) {}
 
     /// @brief Make function using a matrix (operator) and optionally a preconditionner
     ///
@@ -75,10 +80,20 @@ public:
     bool initIteration( const VectorType& rhs, VectorType& x );
     bool step( VectorType& x );
 
+    /// Returns the norm of \a v, summed up over the processes
+    T globalNorm( const VectorType& v ) const
+    {
+        T result = internal::parallelDot(v,v);
+        return math::sqrt(m_comm.sum(result));
+    }
+
     /// @brief specify if you want to store data for eigenvalue estimation
     /// @param flag true stores the coefficients of the lancos matrix, false not.
     void setCalcEigenvalues( bool flag )     { m_calcEigenvals = flag ;}
 
+    /// @brief Set the communicator for the reductions of the inner products
+    void setComm( const gsMpiComm & comm )   { m_comm = comm; }
+
     /// @brief returns the condition number of the (preconditioned) system matrix
     T getConditionNumber();
 
@@ -101,6 +116,14 @@ private:
     using Base::m_rhs_norm;
     using Base::m_error;
 
+    /// Returns the inner product, summed up over the processes
+    T dot(const VectorType & a, const VectorType & b) const
+    {
+        T result = internal::parallelDot(a,b);
+        return m_comm.sum(result);
+    }
+
+    gsMpiComm m_comm;
 
     VectorType m_res;
     VectorType m_update;
@@ -0,0 +1,122 @@
+/** @file gsDistributedAdditiveOp.h
+
+    @brief Additive operators whose subspaces are distributed over the processes
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gsSolver/gsAdditiveOp.h>
+#include <gsSolver/gsDistributedIndexSet.h>
+
+namespace gismo
+{
+
+/** @brief Distributed variant of \a gsAdditiveOp
+ *
+ *  The operator realizes
+ *
+ *  \f[
+ *       \sum_{i}  T_i A_i T_i^\top
+ *  \f]
+ *
+ *  where the terms are distributed over the processes of the
+ *  communicator of the given \a gsDistributedIndexSet. The operator
+ *  acts on distributed vectors (see \a gsDistributedIndexSet). The
+ *  transfer matrices \f$ T_i \f$ of a process refer to its local
+ *  indices, i.e., they have gsDistributedIndexSet::numLocal() rows.
+ *
+ *  Terms that are added via \ref addOperator belong to this process
+ *  alone; they are applied like for \a gsAdditiveOp and only
+ *  neighboring processes communicate. Terms that are added via
+ *  \ref addSharedOperator, like a coarse (primal) problem, are shared
+ *  by all processes: each process holds the same operator \f$ A \f$ and
+ *  its contribution \f$ T_r \f$ to the transfer matrix
+ *  \f$ T = \sum_r T_r \f$; the product \f$ T^\top x \f$ is summed up
+ *  over the processes by a reduction.
+ *
+ *  @ingroup Solver
+**/
+template<class T>
+class gsDistributedAdditiveOp GISMO_FINAL : public gsLinearOperator<T>
+{
+    typedef memory::shared_ptr<gsLinearOperator<T> > OpPtr;
+    typedef gsSparseMatrix<T,RowMajor>               Transfer;
+    typedef memory::shared_ptr<Transfer>             TransferPtr;
+    typedef typename gsDistributedIndexSet<T>::Ptr   IndexSetPtr;
+
+public:
+
+    /// Shared pointer for gsDistributedAdditiveOp
+    typedef memory::shared_ptr<gsDistributedAdditiveOp> Ptr;
+
+    /// Unique pointer for gsDistributedAdditiveOp
+    typedef memory::unique_ptr<gsDistributedAdditiveOp> uPtr;
+
+    /// @brief Constructor, the terms are added by \ref addOperator and
+    /// \ref addSharedOperator
+    ///
+    /// @param indexSet   The distribution of the indices
+    explicit gsDistributedAdditiveOp(IndexSetPtr indexSet)
+    : m_indexSet(give(indexSet)), m_local(gsAdditiveOp<T>::make()), m_numLocal(0)
+    { }
+
+    /// Make function
+    static uPtr make(IndexSetPtr indexSet)
+    { return uPtr( new gsDistributedAdditiveOp(give(indexSet)) ); }
+
+    /// @brief Adds a term that belongs to this process
+    ///
+    /// @param transfer   the transfer matrix \f$ T_i \f$, with local row indices
+    /// @param op         the operator \f$ A_i \f$
+    void addOperator(TransferPtr transfer, OpPtr op)
+    {
+        GISMO_ASSERT( transfer->rows() == m_indexSet->numLocal(), "The dimensions do not agree." );
+        m_local->addOperator(give(transfer), give(op));
+        ++m_numLocal;
+    }
+
+    /// @brief Adds a term that is shared by all processes (collective in apply)
+    ///
+    /// @param transfer   the contribution of this process to the transfer
+    ///                   matrix, with local row indices
+    /// @param op         the operator, which is the same on all processes
+    void addSharedOperator(TransferPtr transfer, OpPtr op)
+    {
+        GISMO_ASSERT( transfer->rows() == m_indexSet->numLocal()
+                      && transfer->cols() == op->rows(), "The dimensions do not agree." );
+        m_sharedTransfers.push_back(give(transfer));
+        m_sharedOps.push_back(give(op));
+    }
+
+    /// Applies the operator to a distributed vector (collective)
+    void apply(const gsMatrix<T> & input, gsMatrix<T> & x) const;
+
+    /// Number of owned indices
+    index_t rows() const { return m_indexSet->numOwned(); }
+
+    /// Number of owned indices
+    index_t cols() const { return m_indexSet->numOwned(); }
+
+    /// The distribution of the indices
+    const IndexSetPtr & indexSet() const { return m_indexSet; }
+
+private:
+    IndexSetPtr                       m_indexSet;        ///< The distribution
+    typename gsAdditiveOp<T>::Ptr     m_local;           ///< The terms of this process
+    index_t                           m_numLocal;        ///< Number of terms in m_local
+    std::vector<TransferPtr>          m_sharedTransfers; ///< The contributions to the shared transfers
+    std::vector<OpPtr>                m_sharedOps;       ///< The shared operators
+    mutable gsMatrix<T>               m_in, m_out;
+};
+
+} // namespace gismo
+
+#ifndef GISMO_BUILD_LIB
+#include GISMO_HPP_HEADER(gsDistributedAdditiveOp.hpp)
+#endif
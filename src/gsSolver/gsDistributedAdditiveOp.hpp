@@ -0,0 +1,44 @@
+/** @file gsDistributedAdditiveOp.hpp
+
+    @brief Additive operators whose subspaces are distributed over the processes
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+namespace gismo
+{
+
+template<class T>
+void gsDistributedAdditiveOp<T>::apply(const gsMatrix<T> & input, gsMatrix<T> & x) const
+{
+    GISMO_ASSERT( input.rows() == rows(), "The dimensions do not agree." );
+
+    // Values of the local indices, which needs communication with the
+    // neighboring processes only
+    m_indexSet->toLocal(input, m_in);
+
+    if (m_numLocal > 0)
+        m_local->apply(m_in, m_out);
+    else
+        m_out.setZero(m_in.rows(), m_in.cols());
+
+    // The shared terms need the restrictions summed up over all processes
+    gsMatrix<T> res, corr;
+    for (size_t i = 0; i < m_sharedOps.size(); ++i)
+    {
+        res.noalias() = m_sharedTransfers[i]->transpose() * m_in;
+        m_indexSet->comm().sum(res.data(), static_cast<int>(res.size()));
+        m_sharedOps[i]->apply(res, corr);
+        m_out.noalias() += *m_sharedTransfers[i] * corr;
+    }
+
+    m_indexSet->addToOwned(m_out, x);
+}
+
+} // namespace gismo
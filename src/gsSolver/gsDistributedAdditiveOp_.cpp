@@ -0,0 +1,9 @@
+#include <gsSolver/gsDistributedAdditiveOp.h>
+#include <gsSolver/gsDistributedAdditiveOp.hpp>
+
+namespace gismo
+{
+
+CLASS_TEMPLATE_INST gsDistributedAdditiveOp<real_t>;
+
+} // namespace gismo
@@ -0,0 +1,120 @@
+/** @file gsDistributedIndexSet.h
+
+    @brief Distribution of a global index range over the processes of a communicator
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gsCore/gsLinearAlgebra.h>
+#include <gsParallel/gsMpi.h>
+
+namespace gismo
+{
+
+/** @brief
+  * Distribution of the global indices \f$ 0,\ldots,N-1 \f$ (e.g., of
+  * Lagrange multipliers) over the processes of a communicator
+  *
+  * Every process uses a subset of the indices (the local indices), which
+  * overlap with the ones of the other processes. Every index is owned
+  * by the process with the lowest rank that uses it. Indices used by
+  * no process are owned by the process with rank 0.
+  *
+  * Two kinds of vectors are considered:
+  *  - a \em distributed vector holds the entries of the owned indices,
+  *    ordered by their global indices (see ownedIndices()); this is
+  *    the vector that is seen by the iterative solvers, cf.
+  *    gsConjugateGradient::setComm.
+  *  - a \em local vector holds the entries of the local indices,
+  *    ordered by their global indices (see localIndices()).
+  *
+  * The member toLocal() fills a local vector from a distributed one and
+  * addToOwned() sums up local vectors of all processes into a
+  * distributed one. For both, each process communicates only with the
+  * processes that share some of its local indices.
+  *
+  * \ingroup Solver
+  */
+template<class T>
+class gsDistributedIndexSet
+{
+public:
+
+    /// Shared pointer for gsDistributedIndexSet
+    typedef memory::shared_ptr<gsDistributedIndexSet> Ptr;
+
+    /// Unique pointer for gsDistributedIndexSet
+    typedef memory::unique_ptr<gsDistributedIndexSet> uPtr;
+
+    /// @brief Sets up the distribution (collective)
+    ///
+    /// @param localIndices  The global indices used by this process (in
+    ///                      any order, possibly with repetitions)
+    /// @param globalSize    The number \f$ N \f$ of global indices
+    /// @param comm          The communicator
+    gsDistributedIndexSet(std::vector<index_t> localIndices, index_t globalSize, const gsMpiComm & comm);
+
+    /// Make function returning a smart pointer
+    static uPtr make(std::vector<index_t> localIndices, index_t globalSize, const gsMpiComm & comm)
+    { return uPtr( new gsDistributedIndexSet(give(localIndices), globalSize, comm) ); }
+
+    /// Global number of indices
+    index_t globalSize() const                          { return m_globalSize;     }
+
+    /// Number of owned indices, i.e., size of distributed vectors
+    index_t numOwned() const                            { return m_ownedPos.size(); }
+
+    /// Number of local indices, i.e., size of local vectors
+    index_t numLocal() const                            { return m_local.size();   }
+
+    /// Global indices of the local indices, in ascending order
+    const std::vector<index_t> & localIndices() const   { return m_local;          }
+
+    /// Global indices of the owned indices, in ascending order
+    std::vector<index_t> ownedIndices() const;
+
+    /// The communicator
+    const gsMpiComm & comm() const                      { return m_comm;           }
+
+    /// @brief Fills the local vector \a local with the values of the
+    /// distributed vector \a owned (collective)
+    void toLocal(const gsMatrix<T> & owned, gsMatrix<T> & local) const;
+
+    /// @brief Sums up the local vectors \a local of all processes and
+    /// stores the owned entries in \a owned (collective)
+    void addToOwned(const gsMatrix<T> & local, gsMatrix<T> & owned) const;
+
+    /// @brief Returns the matrix consisting of the local rows of \a
+    /// matrix, which has \ref globalSize() rows
+    ///
+    /// The entries of rows that are not local are ignored.
+    gsSparseMatrix<T,RowMajor> restrictRows(const gsSparseMatrix<T,RowMajor> & matrix) const;
+
+private:
+    gsMpiComm m_comm;
+    index_t   m_globalSize;
+
+    std::vector<index_t> m_local;        ///< Global indices of the local indices
+    std::vector<index_t> m_ownedPos;     ///< Positions of the owned indices in m_local
+
+    std::vector<index_t> m_ghostPos;     ///< Positions of the other local indices, ordered by owner
+    std::vector<int>     m_recvRanks;    ///< Owners of the ghosts
+    std::vector<index_t> m_recvOffsets;  ///< Ghosts of m_recvRanks[k] start at m_recvOffsets[k]
+    std::vector<int>     m_sendRanks;    ///< Processes which share owned indices
+    std::vector<index_t> m_sendOffsets;  ///< Indices for m_sendRanks[k] start at m_sendOffsets[k]
+    std::vector<index_t> m_sendRows;     ///< Positions of the shared indices in distributed vectors
+
+    mutable std::vector<T> m_sendBuf, m_recvBuf;
+};
+
+} // namespace gismo
+
+#ifndef GISMO_BUILD_LIB
+#include GISMO_HPP_HEADER(gsDistributedIndexSet.hpp)
+#endif
@@ -0,0 +1,204 @@
+/** @file gsDistributedIndexSet.hpp
+
+    @brief Distribution of a global index range over the processes of a communicator
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gsSolver/gsDistributedMatrixOp.h>
+#include <gsSolver/gsDistributedMatrixOp.hpp> // internal::distributedExchange
+
+namespace gismo
+{
+
+template<class T>
+gsDistributedIndexSet<T>::gsDistributedIndexSet(std::vector<index_t> localIndices,
+                                                index_t globalSize, const gsMpiComm & comm)
+: m_comm(comm), m_globalSize(globalSize)
+{
+    const int rank   = m_comm.rank();
+    const int nProcs = m_comm.size();
+
+    std::sort(localIndices.begin(), localIndices.end());
+    localIndices.erase(std::unique(localIndices.begin(), localIndices.end()), localIndices.end());
+    m_local.swap(localIndices);
+    GISMO_ASSERT( m_local.empty() || (m_local.front() >= 0 && m_local.back() < globalSize),
+                  "gsDistributedIndexSet: Invalid index." );
+
+    // The owner of an index is the process with the lowest rank that uses it
+    std::vector<int> owner(globalSize, nProcs);
+    for (size_t p = 0; p < m_local.size(); ++p)
+        owner[m_local[p]] = rank;
+    m_comm.min(owner.data(), static_cast<int>(globalSize));
+    for (index_t i = 0; i < globalSize; ++i)
+        if (owner[i] == nProcs) // not used at all
+        {
+            owner[i] = 0;
+            if (0 == rank)
+                m_local.push_back(i);
+        }
+    std::sort(m_local.begin(), m_local.end());
+
+    const index_t nLocal = m_local.size();
+    std::vector<index_t> owned;
+    std::vector<std::pair<int,index_t> > ghosts;
+    for (index_t p = 0; p < nLocal; ++p)
+    {
+        if (owner[m_local[p]] == rank)
+        {
+            m_ownedPos.push_back(p);
+            owned.push_back(m_local[p]);
+        }
+        else
+            ghosts.push_back(std::make_pair(owner[m_local[p]], p));
+    }
+    std::sort(ghosts.begin(), ghosts.end());
+
+    // The ghosts are received from their owners
+    const index_t nGhosts = ghosts.size();
+    m_ghostPos.resize(nGhosts);
+    std::vector<index_t> request(nGhosts), requested;
+    std::vector<int> requestOffsets(nProcs+1, 0), recvOffsets;
+    for (index_t g = 0; g < nGhosts; ++g)
+    {
+        m_ghostPos[g] = ghosts[g].second;
+        request[g]    = m_local[ghosts[g].second];
+        ++requestOffsets[ghosts[g].first+1];
+    }
+    for (int p = 0; p < nProcs; ++p)
+        requestOffsets[p+1] += requestOffsets[p];
+    for (int p = 0; p < nProcs; ++p)
+        if (requestOffsets[p+1] > requestOffsets[p])
+        {
+            m_recvRanks.push_back(p);
+            m_recvOffsets.push_back(requestOffsets[p]);
+        }
+    m_recvOffsets.push_back(nGhosts);
+
+    // Tell the owners which of their indices are shared with this process
+    internal::distributedExchange(m_comm, request, requestOffsets, requested, recvOffsets);
+    m_sendRows.resize(requested.size());
+    for (size_t q = 0; q < requested.size(); ++q)
+        m_sendRows[q] = internal::distributedLocalIndex(owned, requested[q]);
+    for (int p = 0; p < nProcs; ++p)
+        if (recvOffsets[p+1] > recvOffsets[p])
+        {
+            m_sendRanks.push_back(p);
+            m_sendOffsets.push_back(recvOffsets[p]);
+        }
+    m_sendOffsets.push_back(m_sendRows.size());
+}
+
+template<class T>
+std::vector<index_t> gsDistributedIndexSet<T>::ownedIndices() const
+{
+    std::vector<index_t> result(m_ownedPos.size());
+    for (size_t i = 0; i < m_ownedPos.size(); ++i)
+        result[i] = m_local[m_ownedPos[i]];
+    return result;
+}
+
+template<class T>
+void gsDistributedIndexSet<T>::toLocal(const gsMatrix<T> & owned, gsMatrix<T> & local) const
+{
+    GISMO_ASSERT( owned.rows() == numOwned(), "The dimensions do not agree." );
+    const index_t m = owned.cols();
+    local.resize(numLocal(), m);
+    for (size_t i = 0; i < m_ownedPos.size(); ++i)
+        local.row(m_ownedPos[i]) = owned.row(i);
+
+#ifdef GISMO_WITH_MPI
+    const size_t nRecv = m_recvRanks.size(), nSend = m_sendRanks.size();
+    std::vector<gsMpiRequest> recvReq(nRecv), sendReq(nSend);
+    m_recvBuf.resize(m_ghostPos.size() * m);
+    for (size_t k = 0; k < nRecv; ++k)
+        m_comm.irecv(m_recvBuf.data() + m_recvOffsets[k] * m,
+                     static_cast<int>((m_recvOffsets[k+1] - m_recvOffsets[k]) * m),
+                     m_recvRanks[k], &recvReq[k]);
+
+    m_sendBuf.resize(m_sendRows.size() * m);
+    for (size_t r = 0; r < m_sendRows.size(); ++r)
+        for (index_t c = 0; c < m; ++c)
+            m_sendBuf[r * m + c] = owned(m_sendRows[r], c);
+    for (size_t k = 0; k < nSend; ++k)
+        m_comm.isend(m_sendBuf.data() + m_sendOffsets[k] * m,
+                     static_cast<int>((m_sendOffsets[k+1] - m_sendOffsets[k]) * m),
+                     m_sendRanks[k], &sendReq[k]);
+
+    for (size_t k = 0; k < nRecv; ++k)
+        recvReq[k].wait();
+    for (size_t g = 0; g < m_ghostPos.size(); ++g)
+        for (index_t c = 0; c < m; ++c)
+            local(m_ghostPos[g], c) = m_recvBuf[g * m + c];
+    for (size_t k = 0; k < nSend; ++k)
+        sendReq[k].wait();
+#else
+    GISMO_ASSERT( m_ghostPos.empty(), "Ghosts without MPI." );
+#endif
+}
+
+template<class T>
+void gsDistributedIndexSet<T>::addToOwned(const gsMatrix<T> & local, gsMatrix<T> & owned) const
+{
+    GISMO_ASSERT( local.rows() == numLocal(), "The dimensions do not agree." );
+    const index_t m = local.cols();
+    owned.resize(numOwned(), m);
+    for (size_t i = 0; i < m_ownedPos.size(); ++i)
+        owned.row(i) = local.row(m_ownedPos[i]);
+
+#ifdef GISMO_WITH_MPI
+    // The communication goes the other way round than in toLocal()
+    const size_t nRecv = m_sendRanks.size(), nSend = m_recvRanks.size();
+    std::vector<gsMpiRequest> recvReq(nRecv), sendReq(nSend);
+    m_recvBuf.resize(m_sendRows.size() * m);
+    for (size_t k = 0; k < nRecv; ++k)
+        m_comm.irecv(m_recvBuf.data() + m_sendOffsets[k] * m,
+                     static_cast<int>((m_sendOffsets[k+1] - m_sendOffsets[k]) * m),
+                     m_sendRanks[k], &recvReq[k]);
+
+    m_sendBuf.resize(m_ghostPos.size() * m);
+    for (size_t g = 0; g < m_ghostPos.size(); ++g)
+        for (index_t c = 0; c < m; ++c)
+            m_sendBuf[g * m + c] = local(m_ghostPos[g], c);
+    for (size_t k = 0; k < nSend; ++k)
+        m_comm.isend(m_sendBuf.data() + m_recvOffsets[k] * m,
+                     static_cast<int>((m_recvOffsets[k+1] - m_recvOffsets[k]) * m),
+                     m_recvRanks[k], &sendReq[k]);
+
+    for (size_t k = 0; k < nRecv; ++k)
+        recvReq[k].wait();
+    for (size_t r = 0; r < m_sendRows.size(); ++r)
+        for (index_t c = 0; c < m; ++c)
+            owned(m_sendRows[r], c) += m_recvBuf[r * m + c];
+    for (size_t k = 0; k < nSend; ++k)
+        sendReq[k].wait();
+#else
+    GISMO_ASSERT( m_ghostPos.empty(), "Ghosts without MPI." );
+#endif
+}
+
+template<class T>
+gsSparseMatrix<T,RowMajor> gsDistributedIndexSet<T>::restrictRows(const gsSparseMatrix<T,RowMajor> & matrix) const
+{
+    GISMO_ASSERT( matrix.rows() == globalSize(), "The dimensions do not agree." );
+    typedef typename gsSparseMatrix<T,RowMajor>::InnerIterator Iter;
+
+    const index_t nLocal = numLocal();
+    gsSparseEntries<T> entries;
+    for (index_t p = 0; p < nLocal; ++p)
+        for (Iter it(matrix, m_local[p]); it; ++it)
+            entries.add(p, it.col(), it.value());
+
+    gsSparseMatrix<T,RowMajor> result(nLocal, matrix.cols());
+    result.setFrom(entries);
+    result.makeCompressed();
+    return result;
+}
+
+} // namespace gismo
@@ -0,0 +1,9 @@
+#include <gsSolver/gsDistributedIndexSet.h>
+#include <gsSolver/gsDistributedIndexSet.hpp>
+
+namespace gismo
+{
+
+CLASS_TEMPLATE_INST gsDistributedIndexSet<real_t>;
+
+} // namespace gismo
@@ -0,0 +1,145 @@
+/** @file gsDistributedMatrixOp.h
+
+    @brief Row-distributed sparse matrix for distributed-memory solvers
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gsSolver/gsParallelMatrixOp.h>
+#include <gsParallel/gsMpi.h>
+
+namespace gismo
+{
+
+/** @brief
+  * A sparse matrix whose rows are distributed over the processes of a
+  * communicator
+  *
+  * Every degree of freedom (row) is owned by one process. A
+  * distributed vector is stored as \a gsMatrix, which holds on every
+  * process the entries of the owned rows, ordered by their global
+  * indices (see ownedDofs()). So, the operator can be used by the
+  * iterative solvers which sum up their inner products over the
+  * processes, like gsConjugateGradient with setComm().
+  *
+  * The matrix is set up from the contributions of the processes: each
+  * process assembles the integrals of its part of the domain into a
+  * sparse matrix of global size, see gsExprAssembler::setElementRange.
+  * A row is owned by the process with the lowest rank that contributes
+  * to it. The contributions to the other rows are sent to the owners
+  * and summed up there; the right-hand side is treated in the same way
+  * by accumulate().
+  *
+  * The owned rows are split into the coupling with the owned columns
+  * and with the columns owned by other processes (ghosts). In apply(),
+  * the values of the ghosts are exchanged with the neighboring
+  * processes only, while the coupling with the owned columns is
+  * computed.
+  *
+  * @note The ownership and the global indices of the owned rows of all
+  * processes are stored on every process, i.e., the memory for the
+  * bookkeeping grows with the global number of degrees of freedom.
+  *
+  * \ingroup Solver
+  */
+template<class T>
+class gsDistributedMatrixOp GISMO_FINAL : public gsLinearOperator<T>
+{
+public:
+
+    /// Row-major sparse matrix, used for the local parts
+    typedef gsSparseMatrix<T,RowMajor> LocalMatrix;
+
+    /// Shared pointer for gsDistributedMatrixOp
+    typedef memory::shared_ptr<gsDistributedMatrixOp> Ptr;
+
+    /// Unique pointer for gsDistributedMatrixOp
+    typedef memory::unique_ptr<gsDistributedMatrixOp> uPtr;
+
+    /// @brief Sets up the distributed matrix (collective)
+    ///
+    /// @param contribution The entries assembled by this process, as
+    ///                     matrix of global size
+    /// @param comm         The communicator
+    gsDistributedMatrixOp(const gsSparseMatrix<T> & contribution, const gsMpiComm & comm);
+
+    /// Make function returning a smart pointer
+    static uPtr make(const gsSparseMatrix<T> & contribution, const gsMpiComm & comm)
+    { return uPtr( new gsDistributedMatrixOp(contribution, comm) ); }
+
+    /// Applies the matrix to the owned part \a input of a distributed vector (collective)
+    void apply(const gsMatrix<T> & input, gsMatrix<T> & x) const;
+
+    /// Number of owned rows
+    index_t rows() const { return m_owned.size(); }
+
+    /// Number of owned rows
+    index_t cols() const { return m_owned.size(); }
+
+    /// Global number of rows
+    index_t globalSize() const { return m_owner.size(); }
+
+    /// Global indices of the owned rows, in ascending order
+    const std::vector<index_t> & ownedDofs() const { return m_owned; }
+
+    /// Rank of the owner of the global row \a i
+    int owner(index_t i) const { return m_owner[i]; }
+
+    /// @brief The coupling of the owned rows with the owned columns
+    ///
+    /// This is the diagonal block of the process, which can be used for
+    /// setting up block Jacobi preconditioners.
+    const LocalMatrix & localMatrix() const { return m_diag; }
+
+    /// The communicator
+    const gsMpiComm & comm() const { return m_comm; }
+
+    /// @brief Sums up the contributions of all processes to a vector
+    /// of global size and returns the owned rows (collective)
+    void accumulate(const gsMatrix<T> & contribution, gsMatrix<T> & local) const;
+
+    /// Returns the owned rows of the vector \a global of global size
+    void distribute(const gsMatrix<T> & global, gsMatrix<T> & local) const;
+
+    /// @brief Collects the owned rows of all processes to the vector \a
+    /// global of global size on every process (collective)
+    void gather(const gsMatrix<T> & local, gsMatrix<T> & global) const;
+
+    /// Number of rows owned by other processes that this process needs for apply()
+    index_t numGhosts() const { return m_ghosts.size(); }
+
+private:
+    gsMpiComm m_comm;
+
+    std::vector<int>     m_owner;       ///< Owner of every global row
+    std::vector<index_t> m_owned;       ///< Global indices of the owned rows
+    std::vector<index_t> m_allOwned;    ///< Owned rows of all processes, rank by rank
+    std::vector<int>     m_allCounts;   ///< Number of rows owned by each process
+    std::vector<int>     m_allOffsets;  ///< Offsets of the processes in m_allOwned
+
+    LocalMatrix m_diag;                 ///< Coupling with the owned columns
+    LocalMatrix m_offd;                 ///< Coupling with the ghosts
+    typename gsParallelMatrixOp<T>::uPtr m_diagOp, m_offdOp; ///< Products with m_diag and m_offd
+
+    std::vector<index_t> m_ghosts;      ///< Global indices of the ghosts, ordered by owner
+    std::vector<int>     m_recvRanks;   ///< Processes which own ghosts
+    std::vector<index_t> m_recvOffsets; ///< Ghosts of m_recvRanks[k] start at m_recvOffsets[k]
+    std::vector<int>     m_sendRanks;   ///< Processes which need owned rows
+    std::vector<index_t> m_sendOffsets; ///< Rows for m_sendRanks[k] start at m_sendOffsets[k]
+    std::vector<index_t> m_sendRows;    ///< Local indices of the rows to be sent
+
+    mutable std::vector<T> m_sendBuf, m_recvBuf;
+    mutable gsMatrix<T> m_ghostValues, m_tmp;
+};
+
+} // namespace gismo
+
+#ifndef GISMO_BUILD_LIB
+#include GISMO_HPP_HEADER(gsDistributedMatrixOp.hpp)
+#endif
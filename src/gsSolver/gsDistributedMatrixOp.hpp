@@ -0,0 +1,330 @@
+/** @file gsDistributedMatrixOp.hpp
+
+    @brief Row-distributed sparse matrix for distributed-memory solvers
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+namespace gismo
+{
+
+namespace internal
+{
+
+/// Sends the entries [sendOffsets[p],sendOffsets[p+1]) of \a send to the
+/// process p; the entries received from the process p are stored in
+/// [recvOffsets[p],recvOffsets[p+1]) of \a recv
+template<class V>
+void distributedExchange(const gsMpiComm & comm,
+                         std::vector<V> & send, std::vector<int> & sendOffsets,
+                         std::vector<V> & recv, std::vector<int> & recvOffsets)
+{
+    const int nProcs = comm.size();
+    std::vector<int> sendCount(nProcs), recvCount(nProcs);
+    for (int p = 0; p < nProcs; ++p)
+        sendCount[p] = sendOffsets[p+1] - sendOffsets[p];
+    comm.alltoall(sendCount.data(), recvCount.data(), 1, 1);
+
+    recvOffsets.assign(nProcs+1, 0);
+    for (int p = 0; p < nProcs; ++p)
+        recvOffsets[p+1] = recvOffsets[p] + recvCount[p];
+    recv.resize(recvOffsets.back());
+    comm.alltoallv(send.data(), sendCount.data(), sendOffsets.data(),
+                   recv.data(), recvCount.data(), recvOffsets.data());
+}
+
+/// Position of the global index \a i in the sorted list \a owned
+inline index_t distributedLocalIndex(const std::vector<index_t> & owned, const index_t i)
+{
+    const std::vector<index_t>::const_iterator it = std::lower_bound(owned.begin(), owned.end(), i);
+    GISMO_ASSERT( it != owned.end() && *it == i, "The row "<< i <<" is not owned by this process." );
+    return it - owned.begin();
+}
+
+} // namespace internal
+
+template<class T>
+gsDistributedMatrixOp<T>::gsDistributedMatrixOp(const gsSparseMatrix<T> & contribution,
+                                                const gsMpiComm & comm)
+: m_comm(comm)
+{
+    GISMO_ASSERT( contribution.rows() == contribution.cols(), "The matrix must be square." );
+    typedef typename gsSparseMatrix<T>::InnerIterator Iter;
+
+    const index_t n = contribution.rows();
+    const int rank   = m_comm.rank();
+    const int nProcs = m_comm.size();
+
+    // The owner of a row is the process with the lowest rank that
+    // contributes to it
+    m_owner.assign(n, nProcs);
+    for (index_t k = 0; k < contribution.outerSize(); ++k)
+        for (Iter it(contribution, k); it; ++it)
+            m_owner[it.row()] = rank;
+    m_comm.min(m_owner.data(), static_cast<int>(n));
+
+    m_allCounts.assign(nProcs, 0);
+    for (index_t i = 0; i < n; ++i)
+    {
+        if (m_owner[i] == nProcs) // no contribution at all
+            m_owner[i] = 0;
+        ++m_allCounts[m_owner[i]];
+    }
+    m_allOffsets.assign(nProcs+1, 0);
+    for (int p = 0; p < nProcs; ++p)
+        m_allOffsets[p+1] = m_allOffsets[p] + m_allCounts[p];
+    m_allOwned.resize(n);
+    {
+        std::vector<int> pos(m_allOffsets.begin(), m_allOffsets.end()-1);
+        for (index_t i = 0; i < n; ++i)
+            m_allOwned[pos[m_owner[i]]++] = i;
+    }
+    m_owned.assign(m_allOwned.begin() + m_allOffsets[rank],
+                   m_allOwned.begin() + m_allOffsets[rank+1]);
+
+    // Send the contributions to the rows of other processes to the owners
+    std::vector<int> sendOffsets(nProcs+1, 0), recvOffsets;
+    for (index_t k = 0; k < contribution.outerSize(); ++k)
+        for (Iter it(contribution, k); it; ++it)
+            if (m_owner[it.row()] != rank)
+                ++sendOffsets[m_owner[it.row()]+1];
+    for (int p = 0; p < nProcs; ++p)
+        sendOffsets[p+1] += sendOffsets[p];
+
+    std::vector<index_t> sendIdx(2*sendOffsets.back()), recvIdx;
+    std::vector<T>       sendVal(sendOffsets.back()),   recvVal;
+    {
+        std::vector<int> pos(sendOffsets.begin(), sendOffsets.end()-1);
+        for (index_t k = 0; k < contribution.outerSize(); ++k)
+            for (Iter it(contribution, k); it; ++it)
+                if (m_owner[it.row()] != rank)
+                {
+                    const int q = pos[m_owner[it.row()]]++;
+                    sendIdx[2*q]   = it.row();
+                    sendIdx[2*q+1] = it.col();
+                    sendVal[q]     = it.value();
+                }
+    }
+    internal::distributedExchange(m_comm, sendVal, sendOffsets, recvVal, recvOffsets);
+    for (int p = 0; p <= nProcs; ++p)
+        sendOffsets[p] *= 2;
+    internal::distributedExchange(m_comm, sendIdx, sendOffsets, recvIdx, recvOffsets);
+
+    // All entries of the owned rows, as (row, column, value)
+    std::vector<index_t> rowIdx, colIdx;
+    std::vector<T>       values;
+    rowIdx.reserve(contribution.nonZeros() + recvVal.size());
+    colIdx.reserve(contribution.nonZeros() + recvVal.size());
+    values.reserve(contribution.nonZeros() + recvVal.size());
+    for (index_t k = 0; k < contribution.outerSize(); ++k)
+        for (Iter it(contribution, k); it; ++it)
+            if (m_owner[it.row()] == rank)
+            {
+                rowIdx.push_back(it.row());
+                colIdx.push_back(it.col());
+                values.push_back(it.value());
+            }
+    for (size_t q = 0; q < recvVal.size(); ++q)
+    {
+        rowIdx.push_back(recvIdx[2*q]);
+        colIdx.push_back(recvIdx[2*q+1]);
+        values.push_back(recvVal[q]);
+    }
+
+    // The ghosts, ordered by their owners and global indices
+    std::vector<std::pair<int,index_t> > ghosts;
+    for (size_t q = 0; q < colIdx.size(); ++q)
+        if (m_owner[colIdx[q]] != rank)
+            ghosts.push_back(std::make_pair(m_owner[colIdx[q]], colIdx[q]));
+    std::sort(ghosts.begin(), ghosts.end());
+    ghosts.erase(std::unique(ghosts.begin(), ghosts.end()), ghosts.end());
+
+    const index_t nGhosts = ghosts.size();
+    m_ghosts.resize(nGhosts);
+    std::vector<int> requestOffsets(nProcs+1, 0);
+    for (index_t g = 0; g < nGhosts; ++g)
+    {
+        m_ghosts[g] = ghosts[g].second;
+        ++requestOffsets[ghosts[g].first+1];
+    }
+    for (int p = 0; p < nProcs; ++p)
+        requestOffsets[p+1] += requestOffsets[p];
+    for (int p = 0; p < nProcs; ++p)
+        if (requestOffsets[p+1] > requestOffsets[p])
+        {
+            m_recvRanks.push_back(p);
+            m_recvOffsets.push_back(requestOffsets[p]);
+        }
+    m_recvOffsets.push_back(nGhosts);
+
+    // Tell the owners which of their rows are needed here
+    std::vector<index_t> requested;
+    internal::distributedExchange(m_comm, m_ghosts, requestOffsets, requested, recvOffsets);
+    m_sendRows.resize(requested.size());
+    for (size_t q = 0; q < requested.size(); ++q)
+        m_sendRows[q] = internal::distributedLocalIndex(m_owned, requested[q]);
+    for (int p = 0; p < nProcs; ++p)
+        if (recvOffsets[p+1] > recvOffsets[p])
+        {
+            m_sendRanks.push_back(p);
+            m_sendOffsets.push_back(recvOffsets[p]);
+        }
+    m_sendOffsets.push_back(m_sendRows.size());
+
+    // Split the owned rows into the couplings with the owned columns
+    // and with the ghosts
+    gsSparseEntries<T> diagEntries, offdEntries;
+    diagEntries.reserve(values.size());
+    for (size_t q = 0; q < values.size(); ++q)
+    {
+        const index_t i = internal::distributedLocalIndex(m_owned, rowIdx[q]);
+        if (m_owner[colIdx[q]] == rank)
+            diagEntries.add(i, internal::distributedLocalIndex(m_owned, colIdx[q]), values[q]);
+        else
+        {
+            const std::pair<int,index_t> key(m_owner[colIdx[q]], colIdx[q]);
+            offdEntries.add(i, std::lower_bound(ghosts.begin(), ghosts.end(), key) - ghosts.begin(),
+                            values[q]);
+        }
+    }
+    const index_t nOwned = m_owned.size();
+    m_diag.resize(nOwned, nOwned);
+    m_diag.setFrom(diagEntries);
+    m_diag.makeCompressed();
+    m_offd.resize(nOwned, nGhosts);
+    m_offd.setFrom(offdEntries);
+    m_offd.makeCompressed();
+    m_diagOp = makeParallelMatrixOp(m_diag);
+    m_offdOp = makeParallelMatrixOp(m_offd);
+}
+
+template<class T>
+void gsDistributedMatrixOp<T>::apply(const gsMatrix<T> & input, gsMatrix<T> & x) const
+{
+    GISMO_ASSERT( input.rows() == rows(), "The dimensions do not agree." );
+    const index_t m = input.cols();
+
+#ifdef GISMO_WITH_MPI
+    // Start the exchange of the ghosts
+    const size_t nRecv = m_recvRanks.size(), nSend = m_sendRanks.size();
+    std::vector<gsMpiRequest> recvReq(nRecv), sendReq(nSend);
+    m_recvBuf.resize(m_ghosts.size() * m);
+    for (size_t k = 0; k < nRecv; ++k)
+        m_comm.irecv(m_recvBuf.data() + m_recvOffsets[k] * m,
+                     static_cast<int>((m_recvOffsets[k+1] - m_recvOffsets[k]) * m),
+                     m_recvRanks[k], &recvReq[k]);
+
+    m_sendBuf.resize(m_sendRows.size() * m);
+    for (size_t r = 0; r < m_sendRows.size(); ++r)
+        for (index_t c = 0; c < m; ++c)
+            m_sendBuf[r * m + c] = input(m_sendRows[r], c);
+    for (size_t k = 0; k < nSend; ++k)
+        m_comm.isend(m_sendBuf.data() + m_sendOffsets[k] * m,
+                     static_cast<int>((m_sendOffsets[k+1] - m_sendOffsets[k]) * m),
+                     m_sendRanks[k], &sendReq[k]);
+#endif
+
+    // The coupling with the owned columns overlaps with the communication
+    m_diagOp->apply(input, x);
+
+#ifdef GISMO_WITH_MPI
+    for (size_t k = 0; k < nRecv; ++k)
+        recvReq[k].wait();
+    if (!m_ghosts.empty())
+    {
+        const index_t nGhosts = m_ghosts.size();
+        m_ghostValues.resize(nGhosts, m);
+        for (index_t g = 0; g < nGhosts; ++g)
+            for (index_t c = 0; c < m; ++c)
+                m_ghostValues(g, c) = m_recvBuf[g * m + c];
+        m_offdOp->apply(m_ghostValues, m_tmp);
+        internal::parallelAxpby((T)(1), m_tmp, (T)(1), x);
+    }
+    for (size_t k = 0; k < nSend; ++k)
+        sendReq[k].wait();
+#else
+    GISMO_ASSERT( m_ghosts.empty(), "Ghosts without MPI." );
+#endif
+}
+
+template<class T>
+void gsDistributedMatrixOp<T>::accumulate(const gsMatrix<T> & contribution, gsMatrix<T> & local) const
+{
+    GISMO_ASSERT( contribution.rows() == globalSize(), "The dimensions do not agree." );
+    const index_t m = contribution.cols();
+    const index_t n = contribution.rows();
+    const int rank   = m_comm.rank();
+    const int nProcs = m_comm.size();
+
+    // The nonzero rows owned by other processes are sent to their owners
+    std::vector<int> sendOffsets(nProcs+1, 0), recvOffsets;
+    for (index_t i = 0; i < n; ++i)
+        if (m_owner[i] != rank && !contribution.row(i).isZero(0))
+            ++sendOffsets[m_owner[i]+1];
+    for (int p = 0; p < nProcs; ++p)
+        sendOffsets[p+1] += sendOffsets[p];
+
+    std::vector<index_t> sendIdx(sendOffsets.back()), recvIdx;
+    std::vector<T>       sendVal(sendOffsets.back() * m), recvVal;
+    {
+        std::vector<int> pos(sendOffsets.begin(), sendOffsets.end()-1);
+        for (index_t i = 0; i < n; ++i)
+            if (m_owner[i] != rank && !contribution.row(i).isZero(0))
+            {
+                const int q = pos[m_owner[i]]++;
+                sendIdx[q] = i;
+                for (index_t c = 0; c < m; ++c)
+                    sendVal[q * m + c] = contribution(i, c);
+            }
+    }
+    internal::distributedExchange(m_comm, sendIdx, sendOffsets, recvIdx, recvOffsets);
+    for (int p = 0; p <= nProcs; ++p)
+        sendOffsets[p] *= m;
+    internal::distributedExchange(m_comm, sendVal, sendOffsets, recvVal, recvOffsets);
+
+    distribute(contribution, local);
+    for (size_t q = 0; q < recvIdx.size(); ++q)
+    {
+        const index_t i = internal::distributedLocalIndex(m_owned, recvIdx[q]);
+        for (index_t c = 0; c < m; ++c)
+            local(i, c) += recvVal[q * m + c];
+    }
+}
+
+template<class T>
+void gsDistributedMatrixOp<T>::distribute(const gsMatrix<T> & global, gsMatrix<T> & local) const
+{
+    GISMO_ASSERT( global.rows() == globalSize(), "The dimensions do not agree." );
+    const index_t nOwned = m_owned.size();
+    local.resize(nOwned, global.cols());
+    for (index_t i = 0; i < nOwned; ++i)
+        local.row(i) = global.row(m_owned[i]);
+}
+
+template<class T>
+void gsDistributedMatrixOp<T>::gather(const gsMatrix<T> & local, gsMatrix<T> & global) const
+{
+    GISMO_ASSERT( local.rows() == rows(), "The dimensions do not agree." );
+    const index_t n = globalSize();
+    const index_t m = local.cols();
+    global.resize(n, m);
+
+    std::vector<T> buf(n), col(local.rows());
+    for (index_t c = 0; c < m; ++c)
+    {
+        for (index_t i = 0; i < local.rows(); ++i)
+            col[i] = local(i, c);
+        m_comm.allgatherv(col.data(), static_cast<int>(col.size()), buf.data(),
+                          const_cast<int*>(m_allCounts.data()), const_cast<int*>(m_allOffsets.data()));
+        for (index_t i = 0; i < n; ++i)
+            global(m_allOwned[i], c) = buf[i];
+    }
+}
+
+} // namespace gismo
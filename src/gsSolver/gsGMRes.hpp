@@ -24,15 +24,16 @@ bool gsGMRes<T>::initIteration( const typename gsGMRes<T>::VectorType& rhs,
         return true;
 
     m_mat->apply(x,tmp);
-    tmp = rhs - tmp;
+    internal::parallelAxpby((T)(1), rhs, (T)(-1), tmp);
     m_precond->apply(tmp, residual);
-    beta = residual.norm(); // This is  ||r||
+    beta = internal::parallelNorm(residual); // This is  ||r||
 
     m_error = beta/m_rhs_norm;
     if(m_error < m_tol)
         return true;
 
-    v.push_back(residual/beta);
+    v.push_back(VectorType());
+    internal::parallelAxpby(1/beta, residual, (T)(0), v.back());
     g.setZero(2,1);
     g(0,0) = beta;
     Omega = gsMatrix<T>::Identity(2, 2);
@@ -53,14 +54,9 @@ void gsGMRes<T>::finalizeIteration( typename gsGMRes<T>::VectorType& x )
     //Solve H*y = g;
     solveUpperTriangular(H, g_tmp);
 
-    //Create the matrix from the column matrix in v.
-    gsMatrix<T> V(m_mat->rows(),m_num_iter);
+    //Update solution, x += V*y, where the columns of V are the vectors in v
     for (index_t k = 0; k< m_num_iter; ++k)
-    {
-        V.col(k) = v[k];
-    }
-    //Update solution
-    x += V*y;
+        internal::parallelAxpby(y(k,0), v[k], (T)(1), x);
 
     // cleanup temporaries
     tmp.clear();
@@ -98,15 +94,16 @@ bool gsGMRes<T>::step( typename gsGMRes<T>::VectorType& )
 
     for (index_t i = 0; i< k+1; ++i)
     {
-        h_tmp(i,0) = (w.transpose()*v[i]).value(); //Typo h_l,k
-        w = w - h_tmp(i,0)*v[i];
+        h_tmp(i,0) = internal::parallelDot(w, v[i]); //Typo h_l,k
+        internal::parallelAxpby(-h_tmp(i,0), v[i], (T)(1), w);
     }
-    h_tmp(k+1,0) = w.norm();
+    h_tmp(k+1,0) = internal::parallelNorm(w);
 
   //  if (math::abs(h_tmp(k+1,0)) < 1e-16) //If exact solution
   //      return true;
 
-    v.push_back(w/h_tmp(k+1,0));
+    v.push_back(VectorType());
+    internal::parallelAxpby(1/h_tmp(k+1,0), w, (T)(0), v.back());
 
     h_tmp = Omega_prev*h_tmp;
     H.block(0,k,k+2,1) = h_tmp;
@@ -15,6 +15,7 @@
 #include <gsCore/gsExport.h>
 #include <gsCore/gsLinearAlgebra.h>
 #include <gsSolver/gsMatrixOp.h>
+#include <gsSolver/gsParallelMatrixOp.h>
 #include <gsIO/gsOptionList.h>
 
 namespace gismo
@@ -66,7 +67,8 @@ public:
     /// @note This does not copy the matrix in \a mat. So, make sure that the
     /// matrix is not deleted before the solver. If you have a shared pointer to
     /// the matrix, you might use \ref makeMatrixOp() to obtain a shared pointer
-    /// to a gsLinearOperator which can be supplied alternatively.
+    /// to a gsLinearOperator which can be supplied alternatively. For the
+    /// multithreaded product, supply \ref makeParallelMatrixOp().
     template<typename Derived>
     gsIterativeSolver( const gsEigen::EigenBase<Derived> & mat,
                        const LinOpPtr& precond)
@@ -179,7 +181,7 @@ public:
 
         m_num_iter = 0;
 
-        m_rhs_norm = rhs.norm();
+        m_rhs_norm = globalNorm(rhs);
 
         if (0 == m_rhs_norm) // special case of zero rhs
         {
@@ -201,6 +203,12 @@ public:
         return false; // iteration is not finished
     }
 
+    /// @brief Returns the norm of the vector \a v
+    ///
+    /// Solvers for vectors distributed over several processes sum up
+    /// over the processes.
+    virtual T globalNorm( const VectorType& v ) const          { return internal::parallelNorm(v); }
+
     virtual bool step( VectorType& x ) = 0;                   ///< Perform one step, requires initIteration
     virtual void finalizeIteration( VectorType& ) {}          ///< Some post-processing might be required
 
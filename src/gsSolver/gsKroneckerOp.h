@@ -23,6 +23,16 @@ namespace gismo
 ///
 /// where \f$ A \otimes B = ( a_{11} B \  a_{12} B \ ... ;  a_{21} B \  a_{22} B \ ... ; ... ) \f$.
 ///
+/// The input is regarded as a tensor, and the operators are applied
+/// one after another to its indices (mode products). Operators given
+/// by a dense or a sparse matrix (gsMatrixOp) are multiplied with
+/// blocks of the tensor in place, without transposing it. The blocks
+/// are chosen to fit into the L2 cache and are processed in parallel.
+/// The data of all other operators is transposed blockwise and then
+/// passed to a single call of their apply function. The temporary
+/// buffers are local to each call, so apply is thread-safe, provided
+/// that the apply functions of the factors are.
+///
 /// \ingroup Solver
 template <class T>
 class gsKroneckerOp GISMO_FINAL : public gsLinearOperator<T>
@@ -11,13 +11,117 @@
     Author(s): C. Hofreither, S. Takacs
 */
 
+#include <gsSolver/gsParallelMatrixOp.h>
+
 namespace gismo
 {
 
 /// @cond
+namespace internal
+{
+
+// Number of rows (or columns) of a block of the tensor which is
+// processed at once, such that a block of the input and of the
+// output of a factor with c columns and r rows fit into the L2 cache
+template <typename T>
+inline index_t kroneckerBlockSize(index_t c, index_t r)
+{
+    const index_t l2 = 256 * 1024 / sizeof(T);
+    return math::max( (index_t)(8), ( l2 / (c + r) ) / 8 * 8 );
+}
+
+// Computes the mode product of the tensor in of size L x c x R
+// (column-major) with the matrix A of size r x c, i.e., the tensor
+// out of size L x r x R. For L > 1, each of the R slices satisfies
+// out_j = in_j * A^T, which is computed in blocks of rows; otherwise,
+// out = A * in is computed in blocks of columns.
+template <typename T, typename MatrixType>
+void kroneckerModeProduct(const MatrixType & A, index_t L, index_t R, const T * in, T * out)
+{
+    typedef typename gsMatrix<T>::Base Dense;
+    typedef gsEigen::Map<const Dense, 0, gsEigen::OuterStride<> > ConstSlice;
+    typedef gsEigen::Map<Dense, 0, gsEigen::OuterStride<> >       Slice;
+
+    const index_t c = A.cols(), r = A.rows();
+    const index_t bs = kroneckerBlockSize<T>(c, r);
+    if (1 == L)
+    {
+        const index_t nb = (R + bs - 1) / bs;
+#       pragma omp parallel for schedule(static) if(R * c > internal::gsParallelMinSize)
+        for (index_t b = 0; b < nb; ++b)
+        {
+            const index_t j0 = b * bs, m = math::min(bs, R - j0);
+            Slice(out + j0 * r, r, m, gsEigen::OuterStride<>(r)).noalias()
+                = A * ConstSlice(in + j0 * c, c, m, gsEigen::OuterStride<>(c));
+        }
+    }
+    else
+    {
+        const index_t nb = (L + bs - 1) / bs;
+#       pragma omp parallel for schedule(static) if(L * R * c > internal::gsParallelMinSize)
+        for (index_t t = 0; t < R * nb; ++t)
+        {
+            const index_t j = t / nb, l0 = (t % nb) * bs, m = math::min(bs, L - l0);
+            Slice(out + j * L * r + l0, m, r, gsEigen::OuterStride<>(L)).noalias()
+                = ConstSlice(in + j * L * c + l0, m, c, gsEigen::OuterStride<>(L)) * A.transpose();
+        }
+    }
+}
+
+// Computes the mode product as above if op is given by a dense or a
+// sparse matrix; returns false otherwise
+template <typename T>
+bool kroneckerModeProduct(const gsLinearOperator<T> & op, index_t L, index_t R, const T * in, T * out)
+{
+    typedef typename gsMatrix<T>::Base Dense;
+    if (const gsMatrixOp< gsMatrix<T> > * mop = dynamic_cast<const gsMatrixOp< gsMatrix<T> > *>(&op))
+        kroneckerModeProduct(mop->matrix(), L, R, in, out);
+    else if (const gsMatrixOp< gsEigen::Transpose<const Dense> > * top
+             = dynamic_cast<const gsMatrixOp< gsEigen::Transpose<const Dense> > *>(&op))
+        kroneckerModeProduct(top->matrix(), L, R, in, out);
+    else if (const gsMatrixOp< gsSparseMatrix<T> > * sop = dynamic_cast<const gsMatrixOp< gsSparseMatrix<T> > *>(&op))
+        kroneckerModeProduct(sop->matrix(), L, R, in, out);
+    else if (const gsMatrixOp< gsSparseMatrix<T,RowMajor> > * rop
+             = dynamic_cast<const gsMatrixOp< gsSparseMatrix<T,RowMajor> > *>(&op))
+        kroneckerModeProduct(rop->matrix(), L, R, in, out);
+    else
+        return false;
+    return true;
+}
+
+// Transposes the R slices of size L x c of in blockwise into the
+// columns of out, which gets c rows and L*R columns; with inverse set,
+// it does the converse
+template <typename T>
+void kroneckerTransposeSlices(index_t L, index_t c, index_t R, const T * in, T * out, bool inverse)
+{
+    typedef typename gsMatrix<T>::Base Dense;
+    typedef gsEigen::Map<const Dense, 0, gsEigen::OuterStride<> > ConstSlice;
+    typedef gsEigen::Map<Dense, 0, gsEigen::OuterStride<> >       Slice;
+
+    const index_t bs = kroneckerBlockSize<T>(c, c);
+    const index_t nb = (L + bs - 1) / bs;
+#   pragma omp parallel for schedule(static) if(L * R * c > internal::gsParallelMinSize)
+    for (index_t t = 0; t < R * nb; ++t)
+    {
+        const index_t j = t / nb, l0 = (t % nb) * bs, m = math::min(bs, L - l0);
+        if (inverse)
+            Slice(out + j * L * c + l0, m, c, gsEigen::OuterStride<>(L))
+                = ConstSlice(in + (j * L + l0) * c, c, m, gsEigen::OuterStride<>(c)).transpose();
+        else
+            Slice(out + (j * L + l0) * c, c, m, gsEigen::OuterStride<>(c))
+                = ConstSlice(in + j * L * c + l0, m, c, gsEigen::OuterStride<>(L)).transpose();
+    }
+}
+
+} // namespace internal
+
 template <typename T>
 void gsKroneckerOp<T>::apply(const std::vector<typename gsLinearOperator<T>::Ptr> & ops, const gsMatrix<T> & input, gsMatrix<T> & x)
 {
+    // Temporary buffers, local to the call, so concurrent calls (also
+    // of the same operator) do not interfere
+    gsMatrix<T> buf[4];
     GISMO_ASSERT( !ops.empty(), "Zero-term Kronecker product" );
     const index_t nrOps = ops.size();
 
@@ -27,58 +131,60 @@ void gsKroneckerOp<T>::apply(const std::vector<typename gsLinearOperator<T>::Ptr
         return;
     }
 
-    //index_t rows = 1; // we don't compute rows as we do not need it
-    index_t sz = 1;
-
+    index_t sz = 1, rows = 1;
     for (index_t i = 0; i < nrOps; ++i)
     {
-        //rows *= ops[i]->rows();
-        sz *= ops[i]->cols();
+        sz   *= ops[i]->cols();
+        rows *= ops[i]->rows();
     }
 
     GISMO_ASSERT (sz == input.rows(), "The input matrix has wrong size.");
     const index_t n = input.cols();
 
-    // Note: algorithm relies on col-major matrices
-    gsMatrix<T, Dynamic, Dynamic, ColMajor> q0, q1;
-    gsMatrix<T> temp;
-
-    // size: sz x n
-    q0 = input;
-
+    // The input is a tensor of size c_0 x ... x c_{nrOps-1} x n, where
+    // the last index runs fastest; the operators are applied from the
+    // last to the first, the result of each is stored in buf[0] or buf[1]
+    // and the one of the first operator in x.
+    const T * in = input.data();
+    index_t L = 1;               // product of the (new) sizes of the faster indices
+    index_t R = sz * n;          // product of the sizes of the slower indices
     for (index_t i = nrOps - 1; i >= 0; --i)
     {
+        const index_t c = ops[i]->cols();
+        const index_t r = ops[i]->rows();
+        R /= c;
 
-        const index_t cols_i = ops[i]->cols();
-        const index_t rows_i = ops[i]->rows();
-        const index_t r_i  = sz / cols_i;
-
-        // Re-order right-hand sides
-        q0.resize(cols_i, n * r_i);
-
-        // Apply operator
-        ops[i]->apply(q0, temp);
-        GISMO_ASSERT (temp.rows() == rows_i && temp.cols() == n * r_i, "The linear operator returned a matrix with unexpected size.");
-
-        // Transpose solution component-wise
-        if (n == 1)
-            q1 = temp.transpose();
+        gsMatrix<T> & out = (0 == i) ? x : buf[i % 2];
+        if (0 == i)
+            out.resize(rows, n);
         else
+            out.resize(L * r * R, 1);
+
+        if ( !internal::kroneckerModeProduct(*ops[i], L, R, in, out.data()) )
         {
-            q1.resize(r_i, n * rows_i);
-            for (index_t k = 0; k != n; ++k)
-                q1.middleCols(k*rows_i, rows_i) = temp.middleCols(k*r_i, r_i).transpose();
+            // General operators are applied to the columns of a matrix
+            gsMatrix<T> & tmp = buf[2];
+            if (1 == L)
+                tmp = gsEigen::Map<const typename gsMatrix<T>::Base>(in, c, R);
+            else
+            {
+                tmp.resize(c, L * R);
+                internal::kroneckerTransposeSlices(L, c, R, in, tmp.data(), false);
+            }
+
+            ops[i]->apply(tmp, buf[3]);
+            GISMO_ASSERT (buf[3].rows() == r && buf[3].cols() == L * R,
+                          "The linear operator returned a matrix with unexpected size.");
+
+            if (1 == L)
+                std::copy(buf[3].data(), buf[3].data() + r * R, out.data());
+            else
+                internal::kroneckerTransposeSlices(L, r, R, buf[3].data(), out.data(), true);
         }
 
-        q1.swap( q0 ); // move solution as next right-hand side
-        sz = ( sz / cols_i) * rows_i; // update now the dimensionality such that in the end sz = rows
-        //sz % cols_i == 0, since sz *= ops[i]->cols();
+        in = out.data();
+        L *= r;
     }
-
-    //GISMO_ASSERT (sz == rows, "Internal error."); // see one above
-
-    q0.resize(sz, n);
-    x.swap( q0 );
 }
 /// @endcond
 
@@ -66,14 +66,14 @@ bool gsMinResQLP<T>::initIteration( const typename gsMinResQLP<T>::VectorType& r
 
     //r2 = rhs; 
     m_mat->apply(x,r2); //erex
-    xnorm = x.norm(); 
-    Axnorm = r2.norm();
-    r2 = rhs-r2;
+    xnorm = internal::parallelNorm(x); 
+    Axnorm = internal::parallelNorm(r2);
+    internal::parallelAxpby((T)(1), rhs, (T)(-1), r2);
     //y = x + beta y.
     //VecAYPX(Vec y, PetscScalar beta, Vec x)
-    r3.setZero(n,m); 
+    internal::parallelSetZero(r3,n,m); 
     m_precond->apply(r2, r3);
-    beta1 = r2.col(0).dot(r3.col(0));
+    beta1 = internal::parallelDot(r2, r3);
     GISMO_ASSERT(beta1 > 0, "Preconditioner is indefinite");
     beta1 = math::sqrt(beta1);
     beta  = 0; 
@@ -91,14 +91,16 @@ bool gsMinResQLP<T>::initIteration( const typename gsMinResQLP<T>::VectorType& r
     relres = 1;
     QLPiter = 0;
     
-    x.setZero(n,m); w.setZero(n,m); wl.setZero(n,m); 
+    internal::parallelSetZero(x,n,m);
+    internal::parallelSetZero(w,n,m);
+    internal::parallelSetZero(wl,n,m); 
     resvec(0,0) = beta1;
 
     //NB User input
     maxxnorm = 1e7;
 
     
-    m_error = r2.norm() / m_rhs_norm;
+    m_error = internal::parallelNorm(r2) / m_rhs_norm;
     if (m_error < m_tol)
         return true;
 
@@ -110,20 +112,20 @@ bool gsMinResQLP<T>::step( typename gsMinResQLP<T>::VectorType& x )
 {
     betal = beta;
     beta= betan;
-    v = (1.0/beta)*r3;
+    internal::parallelAxpby(1/beta, r3, (T)(0), v);
     m_mat->apply(v,r3);
     //Assume that m_num_iter starts at 1 (at this point in the code)
     //TODO check assumption 
     if (m_num_iter > 1)
-        r3 = r3 - (beta/betal)*r1;
+        internal::parallelAxpby(-beta/betal, r1, (T)(1), r3);
     
-    alpha = T (r3.col(0).dot(v.col(0)));
-    r3 = r3 - (alpha/beta)*r2;
+    alpha = internal::parallelDot(r3, v);
+    internal::parallelAxpby(-alpha/beta, r2, (T)(1), r3);
     r1.swap(r2);
     r2.swap(r3);
     
     m_precond->apply(r2,r3);
-    betan = r2.col(0).dot(r3.col(0));
+    betan = internal::parallelDot(r2, r3);
     GISMO_ASSERT(betan > 0, "Preconditioner is indefinite");
     betan = math::sqrt(betan);
     
@@ -201,45 +203,50 @@ bool gsMinResQLP<T>::step( typename gsMinResQLP<T>::VectorType& x )
     QLPiter += 1;
     if (QLPiter == 1)
     {
-        xl2.setZero(m_mat->cols(),1);
+        internal::parallelSetZero(xl2,m_mat->cols(),1);
         if (m_num_iter > 1)
         {
             if (m_num_iter > 3)
             {
-                wl2 = gammal3*wl2 + veplnl2*wl + etal*w;
+                // wl2 = gammal3*wl2 + veplnl2*wl + etal*w
+                internal::parallelAxpbypcz(veplnl2, wl, etal, w, gammal3, wl2);
             }
             if (m_num_iter > 2)
             {
-                wl = gammal_QLP*wl + vepln_QLP*w;
+                internal::parallelAxpby(vepln_QLP, w, gammal_QLP, wl);
             }
-            w = gamma_QLP*w;
-            xl2 = x - wl*ul_QLP - w*u_QLP;
+            internal::parallelAxpby(gamma_QLP, w, (T)(0), w);
+            // xl2 = x - wl*ul_QLP - w*u_QLP
+            internal::parallelAxpbypcz(-ul_QLP, wl, -u_QLP, w, (T)(0), xl2);
+            internal::parallelAxpby((T)(1), x, (T)(1), xl2);
         }
     }
     if (m_num_iter == 1)
     {
         wl2.swap(wl);
-        wl = v*sr1;
-        w  = -v*cr1;
+        internal::parallelAxpby( sr1, v, (T)(0), wl);
+        internal::parallelAxpby(-cr1, v, (T)(0), w);
     }
     else if (m_num_iter ==2)
     {
         wl2.swap(wl);
-        wl  = w*cr1 + v*sr1;
-        w   = w*sr1 - v*cr1;
+        internal::parallelAxpbypcz(cr1, w, sr1, v, (T)(0), wl);
+        internal::parallelAxpby(-cr1, v, sr1, w);
     }
     else
     {
         wl2.swap(wl);   
         wl.swap(w);
-        w  = wl2*sr2 - v*cr2;
-        wl2 = wl2*cr2 + v*sr2;
-        v  = wl *cr1 + w*sr1;    
-        w   = wl *sr1 - w*cr1;
+        internal::parallelAxpbypcz(sr2, wl2, -cr2, v, (T)(0), w);
+        internal::parallelAxpby(sr2, v, cr2, wl2);
+        internal::parallelAxpbypcz(cr1, wl, sr1, w, (T)(0), v);
+        internal::parallelAxpby(sr1, wl, -cr1, w);
         wl.swap(v);
     }
-    xl2 = xl2 + wl2*ul2;
-    x   = xl2 + wl *ul + w*u;
+    internal::parallelAxpby(ul2, wl2, (T)(1), xl2);
+    // x = xl2 + wl *ul + w*u
+    internal::parallelAxpbypcz(ul, wl, u, w, (T)(0), x);
+    internal::parallelAxpby((T)(1), xl2, (T)(1), x);
 
     real_t gammal_tmp = gammal;
     MinResQLPSymOrtho(gammal, epsilonn, cr2, sr2, gammal);
@@ -288,8 +295,8 @@ bool gsMinResQLP<T>::step( typename gsMinResQLP<T>::VectorType& x )
     else
     {
         m_mat->apply(x,negResidual);
-        gsMatrix<T> r1_tmp = m_rhs - negResidual;
-        m_error = r1_tmp.norm()/m_rhs_norm;
+        internal::parallelAxpby((T)(1), m_rhs, (T)(-1), negResidual);
+        m_error = internal::parallelNorm(negResidual)/m_rhs_norm;
     }
     if (m_error < m_tol)
         return true;
@@ -306,11 +313,11 @@ template<class T>
 void gsMinResQLP<T>::finalizeIteration( typename gsMinResQLP<T>::VectorType& x)
 {
     m_mat->apply(x,negResidual);
-    r1 = m_rhs - negResidual;
-    rnorm = r1.norm();
+    internal::parallelAxpbypcz((T)(1), m_rhs, (T)(-1), negResidual, (T)(0), r1);
+    rnorm = internal::parallelNorm(r1);
     m_mat->apply(r1, negResidual);
-    Arnorm = negResidual.norm();
-    xnorm = x.norm();
+    Arnorm = internal::parallelNorm(negResidual);
+    xnorm = internal::parallelNorm(x);
     relres = rnorm/(Anorm*xnorm + beta1);
     m_error = relres;
     relAres = 0; 
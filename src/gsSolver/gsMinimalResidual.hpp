@@ -29,17 +29,17 @@ bool gsMinimalResidual<T>::initIteration( const typename gsMinimalResidual<T>::V
         { AwPrev.setZero(n,m); Aw.setZero(n,m); AwNew.setZero(n,m); }
 
     m_mat->apply(x,negResidual);
-    negResidual -= rhs;
+    internal::parallelAxpby((T)(-1), rhs, (T)(1), negResidual);
 
-    m_error = negResidual.norm() / m_rhs_norm;
+    m_error = internal::parallelNorm(negResidual) / m_rhs_norm;
     if (m_error < m_tol)
         return true;
 
-    v = -negResidual;
+    internal::parallelAxpby((T)(-1), negResidual, (T)(0), v);
     m_precond->apply(v, z);
 
     gammaPrev = 1;
-    T ip = z.col(0).dot(v.col(0));
+    T ip = internal::parallelDot(z, v);
     GISMO_ASSERT(ip >= T(0), "gsMinimalResidual::initIteration(...), preconditioner not positive semi-definite");
     gamma = math::sqrt(ip);
     gammaNew = 1;
@@ -53,13 +53,15 @@ bool gsMinimalResidual<T>::initIteration( const typename gsMinimalResidual<T>::V
 template<class T>
 bool gsMinimalResidual<T>::step( typename gsMinimalResidual<T>::VectorType& x )
 {
-    z /= gamma;
+    internal::parallelAxpby(1/gamma, z, (T)(0), z);
     m_mat->apply(z,Az);
 
-    T delta = z.col(0).dot(Az.col(0));
-    vNew = Az - (delta/gamma)*v - (gamma/gammaPrev)*vPrev;
+    T delta = internal::parallelDot(z, Az);
+    // vNew = Az - (delta/gamma)*v - (gamma/gammaPrev)*vPrev
+    internal::parallelAxpbypcz((T)(1), Az, -delta/gamma, v, (T)(0), vNew);
+    internal::parallelAxpby(-gamma/gammaPrev, vPrev, (T)(1), vNew);
     m_precond->apply(vNew, zNew);
-    T ip = zNew.col(0).dot(vNew.col(0));
+    T ip = internal::parallelDot(zNew, vNew);
     GISMO_ASSERT(ip >= T(0), "gsMinimalResidual::step(...), preconditioner not positive semi-definite");
     gammaNew = math::sqrt(ip);
     const T a0 = c*delta - cPrev*s*gamma;
@@ -68,17 +70,22 @@ bool gsMinimalResidual<T>::step( typename gsMinimalResidual<T>::VectorType& x )
     const T a3 = sPrev*gamma;
     cNew = a0/a1;
     sNew = gammaNew/a1;
-    wNew = (z - a3*wPrev - a2*w)/a1;
+    // wNew = (z - a3*wPrev - a2*w)/a1
+    internal::parallelAxpbypcz(1/a1, z, -a3/a1, wPrev, (T)(0), wNew);
+    internal::parallelAxpby(-a2/a1, w, (T)(1), wNew);
     if (!m_inexact_residual)
-        AwNew = (Az - a3*AwPrev - a2*Aw)/a1;
-    x += cNew*eta*wNew;
+    {
+        internal::parallelAxpbypcz(1/a1, Az, -a3/a1, AwPrev, (T)(0), AwNew);
+        internal::parallelAxpby(-a2/a1, Aw, (T)(1), AwNew);
+    }
+    internal::parallelAxpby(cNew*eta, wNew, (T)(1), x);
     if (!m_inexact_residual)
-        negResidual += cNew*eta*AwNew;
+        internal::parallelAxpby(cNew*eta, AwNew, (T)(1), negResidual);
 
     if (m_inexact_residual)
         m_error *= math::abs(sNew); // see https://eigen.tuxfamily.org/dox-devel/unsupported/MINRES_8h_source.html
     else
-        m_error = negResidual.norm() / m_rhs_norm;
+        m_error = internal::parallelNorm(negResidual) / m_rhs_norm;
 
     eta = -sNew*eta;
 
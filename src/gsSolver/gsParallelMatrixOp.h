@@ -0,0 +1,337 @@
+/** @file gsParallelMatrixOp.h
+
+    @brief Multithreaded sparse matrix-vector product and vector kernels
+    for the iterative solvers
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#pragma once
+
+#include <gsCore/gsLinearAlgebra.h>
+#include <gsSolver/gsMatrixOp.h>
+
+namespace gismo
+{
+
+namespace internal
+{
+
+/// Vectors (and matrices) with fewer rows are processed by one thread only
+const index_t gsParallelMinSize = 10000;
+
+// All kernels distribute the entries with the same static schedule
+// as gsParallelMatrixOp distributes the rows. So, each thread works
+// on the same part of the vectors in all kernels and, if the vectors
+// were allocated by parallelSetZero, on memory pages which have been
+// first touched by itself, i.e., which are local to its NUMA node.
+
+/// Resizes \a v and sets it to zero, in parallel (first touch)
+template<class T>
+void parallelSetZero(gsMatrix<T> & v, index_t rows, index_t cols)
+{
+    v.resize(rows, cols);
+    T * pv = v.data();
+    const index_t n = v.size();
+#   pragma omp parallel for schedule(static) if(n > gsParallelMinSize)
+    for (index_t i = 0; i < n; ++i)
+        pv[i] = 0;
+}
+
+/// Returns the (Frobenius) inner product of \a a and \a b
+template<class T>
+T parallelDot(const gsMatrix<T> & a, const gsMatrix<T> & b)
+{
+    GISMO_ASSERT( a.size() == b.size(), "The dimensions do not agree." );
+    const T * pa = a.data();
+    const T * pb = b.data();
+    const index_t n = a.size();
+    T sum = 0;
+#   pragma omp parallel for schedule(static) reduction(+:sum) if(n > gsParallelMinSize)
+    for (index_t i = 0; i < n; ++i)
+        sum += pa[i] * pb[i];
+    return sum;
+}
+
+/// Computes \f$ b = \alpha a + \beta b \f$; \a b is not read if \f$ \beta = 0 \f$
+template<class T>
+void parallelAxpby(T alpha, const gsMatrix<T> & a, T beta, gsMatrix<T> & b)
+{
+    if (0 == beta && b.size() != a.size())
+        parallelSetZero(b, a.rows(), a.cols());
+    GISMO_ASSERT( a.size() == b.size(), "The dimensions do not agree." );
+    const T * pa = a.data();
+    T * pb = b.data();
+    const index_t n = a.size();
+    if (0 == beta)
+    {
+#       pragma omp parallel for schedule(static) if(n > gsParallelMinSize)
+        for (index_t i = 0; i < n; ++i)
+            pb[i] = alpha * pa[i];
+    }
+    else
+    {
+#       pragma omp parallel for schedule(static) if(n > gsParallelMinSize)
+        for (index_t i = 0; i < n; ++i)
+            pb[i] = alpha * pa[i] + beta * pb[i];
+    }
+}
+
+/// Returns the (Frobenius) norm of \a a
+template<class T>
+T parallelNorm(const gsMatrix<T> & a)
+{ return math::sqrt(parallelDot(a, a)); }
+
+/// Computes \f$ c = \alpha a + \beta b + \gamma c \f$; \a c is not read if \f$ \gamma = 0 \f$
+template<class T>
+void parallelAxpbypcz(T alpha, const gsMatrix<T> & a, T beta, const gsMatrix<T> & b,
+                      T gamma, gsMatrix<T> & c)
+{
+    GISMO_ASSERT( a.size() == b.size(), "The dimensions do not agree." );
+    if (0 == gamma && c.size() != a.size())
+        parallelSetZero(c, a.rows(), a.cols());
+    GISMO_ASSERT( a.size() == c.size(), "The dimensions do not agree." );
+    const T * pa = a.data();
+    const T * pb = b.data();
+    T * pc = c.data();
+    const index_t n = a.size();
+    if (0 == gamma)
+    {
+#       pragma omp parallel for schedule(static) if(n > gsParallelMinSize)
+        for (index_t i = 0; i < n; ++i)
+            pc[i] = alpha * pa[i] + beta * pb[i];
+    }
+    else
+    {
+#       pragma omp parallel for schedule(static) if(n > gsParallelMinSize)
+        for (index_t i = 0; i < n; ++i)
+            pc[i] = alpha * pa[i] + beta * pb[i] + gamma * pc[i];
+    }
+}
+
+/// @brief Fused update of the conjugate gradient method
+///
+/// Computes \f$ x = x + \alpha p \f$ and \f$ r = r - \alpha q \f$ in
+/// one sweep over the vectors and returns the squared norm of the
+/// updated \a r.
+template<class T>
+T parallelCgUpdate(T alpha, const gsMatrix<T> & p, const gsMatrix<T> & q,
+                   gsMatrix<T> & x, gsMatrix<T> & r)
+{
+    GISMO_ASSERT( p.size() == q.size() && p.size() == x.size() && p.size() == r.size(),
+                  "The dimensions do not agree." );
+    const T * pp = p.data();
+    const T * pq = q.data();
+    T * px = x.data();
+    T * pr = r.data();
+    const index_t n = p.size();
+    T sum = 0;
+#   pragma omp parallel for schedule(static) reduction(+:sum) if(n > gsParallelMinSize)
+    for (index_t i = 0; i < n; ++i)
+    {
+        px[i] += alpha * pp[i];
+        pr[i] -= alpha * pq[i];
+        sum += pr[i] * pr[i];
+    }
+    return sum;
+}
+
+/// Returns true if the square matrix \a mat is symmetric up to rounding errors
+template<class T, int _Options>
+bool isSymmetric(const gsEigen::SparseMatrix<T,_Options,index_t> & mat)
+{
+    if (mat.rows() != mat.cols())
+        return false;
+
+    const T tol = 100 * std::numeric_limits<T>::epsilon();
+    const index_t * outer = mat.outerIndexPtr();
+    const index_t * nnz   = mat.innerNonZeroPtr();
+    const index_t * inner = mat.innerIndexPtr();
+    const T       * val   = mat.valuePtr();
+    const index_t n = mat.outerSize();
+    bool sym = true;
+#   pragma omp parallel for schedule(static) reduction(&&:sym) if(n > gsParallelMinSize)
+    for (index_t j = 0; j < n; ++j)
+    {
+        if (!sym) continue;
+        const index_t end = nnz ? outer[j] + nnz[j] : outer[j+1];
+        for (index_t k = outer[j]; k < end; ++k)
+        {
+            // Find the transposed entry by bisection in its outer vector
+            const index_t i = inner[k];
+            const index_t tend = nnz ? outer[i] + nnz[i] : outer[i+1];
+            const index_t * it = std::lower_bound(inner + outer[i], inner + tend, j);
+            const T tval = (it != inner + tend && *it == j) ? val[it - inner] : T(0);
+            if ( math::abs(val[k] - tval) > tol * (math::abs(val[k]) + math::abs(tval)) )
+            {
+                sym = false;
+                break;
+            }
+        }
+    }
+    return sym;
+}
+
+} // namespace internal
+
+/**
+  * @brief Multithreaded sparse matrix-vector product as a linear operator
+  *
+  * The rows of the matrix are stored in compressed sparse row (CSR)
+  * format and are distributed to the threads in contiguous blocks
+  * (static schedule), so each thread writes a contiguous part of the
+  * result. This is the same distribution as used by the vector
+  * kernels in gsParallelMatrixOp.h, which the iterative solvers use.
+  *
+  * The operator keeps a reference (or a shared pointer) to the
+  * matrix, like gsMatrixOp, and reads its storage in every call of
+  * apply(). So, the matrix can be modified or reassigned in the
+  * meantime, but it must not be deleted too early. A column-major
+  * matrix is accepted only if it is symmetric (and stays so), since
+  * its storage is then the CSR storage of its transpose. The matrix is
+  * never copied.
+  *
+  * Several columns of the input (right-hand sides) are multiplied
+  * in blocks, so the matrix is traversed only once per block.
+  *
+  * The iterative solvers use it if it is supplied explicitly, e.g.,
+  * \code
+  * gsLinearOperator<>::Ptr op = makeParallelMatrixOp(A);
+  * gsConjugateGradient<> cg(op);
+  * \endcode
+  *
+  * \ingroup Solver
+  */
+template <class T>
+class gsParallelMatrixOp GISMO_FINAL : public gsLinearOperator<T>
+{
+public:
+    /// Row-major sparse matrix
+    typedef gsEigen::SparseMatrix<T,RowMajor,index_t> CsrMatrix;
+
+    /// Column-major sparse matrix
+    typedef gsEigen::SparseMatrix<T,ColMajor,index_t> CscMatrix;
+
+    /// Shared pointer for gsParallelMatrixOp
+    typedef memory::shared_ptr<gsParallelMatrixOp> Ptr;
+
+    /// Unique pointer for gsParallelMatrixOp
+    typedef memory::unique_ptr<gsParallelMatrixOp> uPtr;
+
+    /// @brief Constructor taking a row-major matrix
+    ///
+    /// @note This does not copy the matrix. Make sure that the matrix
+    /// is not deleted too early (alternatively use constructor by
+    /// shared pointer)
+    gsParallelMatrixOp(const CsrMatrix & mat)
+    : m_csr(memory::make_shared_not_owned(&mat))
+    { }
+
+    /// Constructor taking a shared pointer to a row-major matrix
+    gsParallelMatrixOp(const memory::shared_ptr<const CsrMatrix> & mat)
+    : m_csr(mat)
+    { GISMO_ASSERT( m_csr, "The matrix is not set." ); }
+
+    /// @brief Constructor taking a symmetric column-major matrix
+    ///
+    /// @note This does not copy the matrix. Make sure that the matrix
+    /// is not deleted too early.
+    gsParallelMatrixOp(const CscMatrix & mat)
+    : m_csc(memory::make_shared_not_owned(&mat))
+    {
+        GISMO_ENSURE( internal::isSymmetric(mat), "gsParallelMatrixOp: The column-major "
+                      "matrix is not symmetric, use a row-major matrix instead." );
+    }
+
+    /// Make function returning a smart pointer
+    static uPtr make(const CsrMatrix & mat)
+    { return uPtr( new gsParallelMatrixOp(mat) ); }
+
+    /// Make function returning a smart pointer
+    static uPtr make(const memory::shared_ptr<const CsrMatrix> & mat)
+    { return uPtr( new gsParallelMatrixOp(mat) ); }
+
+    /// Make function returning a smart pointer
+    static uPtr make(const CscMatrix & mat)
+    { return uPtr( new gsParallelMatrixOp(mat) ); }
+
+    void apply(const gsMatrix<T> & input, gsMatrix<T> & x) const
+    {
+        if (m_csr)
+            applyImpl(*m_csr, input, x);
+        else
+            applyImpl(*m_csc, input, x);
+    }
+
+    index_t rows() const { return m_csr ? m_csr->rows() : m_csc->rows(); }
+
+    index_t cols() const { return m_csr ? m_csr->cols() : m_csc->cols(); }
+
+private:
+
+    // Uses the outer vectors of mat as rows
+    template<int _Options>
+    static void applyImpl(const gsEigen::SparseMatrix<T,_Options,index_t> & mat,
+                          const gsMatrix<T> & input, gsMatrix<T> & x)
+    {
+        const index_t nRows = mat.outerSize();
+        const index_t nCols = mat.innerSize();
+        const index_t * outer = mat.outerIndexPtr();
+        const index_t * nnz   = mat.innerNonZeroPtr();
+        const index_t * inner = mat.innerIndexPtr();
+        const T       * val   = mat.valuePtr();
+
+        GISMO_ASSERT( input.rows() == nCols, "The dimensions do not agree." );
+        const index_t m = input.cols();
+        // The entries of x are first touched in the loop below
+        x.resize(nRows, m);
+#       pragma omp parallel for schedule(static) if(nRows > internal::gsParallelMinSize)
+        for (index_t i = 0; i < nRows; ++i)
+        {
+            const index_t end = nnz ? outer[i] + nnz[i] : outer[i+1];
+            // Several right-hand sides are processed in blocks, so a row
+            // of the matrix is read once per block (SpMM)
+            for (index_t c0 = 0; c0 < m; c0 += blockSize)
+            {
+                const index_t nc = math::min(blockSize, m - c0);
+                const T * in = input.data() + c0 * nCols;
+                T sum[blockSize];
+                for (index_t c = 0; c < nc; ++c)
+                    sum[c] = 0;
+                for (index_t k = outer[i]; k < end; ++k)
+                {
+                    const T       v = val[k];
+                    const T * col = in + inner[k];
+                    for (index_t c = 0; c < nc; ++c)
+                        sum[c] += v * col[c * nCols];
+                }
+                for (index_t c = 0; c < nc; ++c)
+                    x(i,c0+c) = sum[c];
+            }
+        }
+    }
+
+private:
+    /// Maximum number of columns of the input processed at once
+    static const index_t blockSize = 8;
+
+    memory::shared_ptr<const CsrMatrix> m_csr; ///< Row-major matrix, or
+    memory::shared_ptr<const CscMatrix> m_csc; ///< symmetric column-major matrix
+};
+
+// Definition of the constant, which is odr-used by math::min
+template <class T> const index_t gsParallelMatrixOp<T>::blockSize;
+
+/// @brief Returns a smart pointer to a gsParallelMatrixOp for the sparse matrix \a mat
+///
+/// @note This does not copy the matrix.
+///
+/// \relates gsParallelMatrixOp
+template <class T, int _Options>
+typename gsParallelMatrixOp<T>::uPtr makeParallelMatrixOp(const gsEigen::SparseMatrix<T,_Options,index_t> & mat)
+{ return gsParallelMatrixOp<T>::make(mat); }
+
+} // namespace gismo
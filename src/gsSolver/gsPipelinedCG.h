@@ -0,0 +1,144 @@
+/** @file gsPipelinedCG.h
+
+    @brief Pipelined conjugate gradient solver
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gsSolver/gsIterativeSolver.h>
+#include <gsParallel/gsMpi.h>
+
+namespace gismo
+{
+
+/// @brief The pipelined conjugate gradient method.
+///
+/// The variant of the preconditioned conjugate gradient method by
+/// Ghysels and Vanroose (Parallel Computing 40, 2014). All inner
+/// products of one iteration are combined into one global reduction,
+/// which is started by gsMpiComm::isum (a non-blocking allreduce)
+/// and overlaps with the application of the preconditioner and of
+/// the operator. This hides the latency of the reduction if the
+/// vectors are distributed over several processes. The price are
+/// four more vector updates per iteration and a slightly worse
+/// accuracy of the recursively computed residual.
+///
+/// The vectors are the local parts of the distributed vectors, and
+/// the operator and the preconditioner have to do the communication
+/// which is needed for their application. By default, the solver
+/// runs sequentially (communicator gsSerialComm).
+///
+/// The stopping criterion is checked with the norm of the residual
+/// that is computed with the reduction of the following iteration;
+/// this step does not update the solution and it is not counted.
+/// If the criterion is met, it is checked again with the true
+/// residual, and the iteration is restarted with the latter if this
+/// is still too large. Moreover, the recursively updated vectors are
+/// recomputed periodically (residual replacement, option
+/// "ReplacementPeriod"), which costs three applications of the
+/// operator and two of the preconditioner, but no reduction.
+///
+/// \ingroup Solver
+template<class T = real_t>
+class gsPipelinedCG : public gsIterativeSolver<T>
+{
+public:
+    typedef gsIterativeSolver<T> Base;
+
+    typedef gsMatrix<T>  VectorType;
+
+    typedef typename Base::LinOpPtr LinOpPtr;
+
+    typedef memory::shared_ptr<gsPipelinedCG> Ptr;
+    typedef memory::unique_ptr<gsPipelinedCG> uPtr;
+
+    /// @brief Constructor using a matrix (operator) and optionally a preconditionner
+    ///
+    /// @param mat     The operator to be solved for, see gsIterativeSolver for details
+    /// @param precond The preconditioner, defaulted to the identity
+    template< typename OperatorType >
+    explicit gsPipelinedCG( const OperatorType& mat,
+                            const LinOpPtr& precond = LinOpPtr() )
+    : Base(mat, precond), m_comm(gsSerialComm()), m_replace(50) {}
+
+    /// @brief Make function using a matrix (operator) and optionally a preconditionner
+    ///
+    /// @param mat     The operator to be solved for, see gsIterativeSolver for details
+    /// @param precond The preconditioner, defaulted to the identity
+    template< typename OperatorType >
+    static uPtr make( const OperatorType& mat, const LinOpPtr& precond = LinOpPtr() )
+    { return uPtr( new gsPipelinedCG(mat, precond) ); }
+
+    /// @brief Returns a list of default options
+    static gsOptionList defaultOptions()
+    {
+        gsOptionList opt = Base::defaultOptions();
+        opt.addInt("ReplacementPeriod", "Number of iterations between residual replacements (0: never)", 50 );
+        return opt;
+    }
+
+    /// @brief Set the options based on a gsOptionList
+    gsPipelinedCG& setOptions(const gsOptionList& opt)
+    {
+        Base::setOptions(opt);
+        m_replace = opt.askInt("ReplacementPeriod", m_replace);
+        return *this;
+    }
+
+    bool initIteration( const VectorType& rhs, VectorType& x );
+    bool step( VectorType& x );
+
+    /// Returns the norm of \a v, summed up over the processes
+    T globalNorm( const VectorType& v ) const
+    {
+        T result = internal::parallelDot(v,v);
+        return math::sqrt(m_comm.sum(result));
+    }
+
+    /// @brief Set the number of iterations between residual replacements (0: never)
+    void setReplacementPeriod( index_t period )  { m_replace = period; }
+
+    /// @brief Set the communicator for the reductions of the inner products
+    void setComm( const gsMpiComm & comm )   { m_comm = comm; }
+
+    /// Prints the object as a string.
+    std::ostream &print(std::ostream &os) const
+    {
+        os << "gsPipelinedCG\n";
+        return os;
+    }
+
+private:
+
+    /// Starts the iteration with the true residual of \a x
+    bool restart( const VectorType& x );
+
+private:
+    using Base::m_mat;
+    using Base::m_precond;
+    using Base::m_max_iters;
+    using Base::m_tol;
+    using Base::m_num_iter;
+    using Base::m_rhs_norm;
+    using Base::m_error;
+
+    gsMpiComm m_comm;
+    index_t m_replace;                    ///< Period of the residual replacement
+
+    const VectorType * m_rhs;
+    VectorType m_r, m_u, m_w, m_m, m_n;   ///< Residual, preconditioned residual and their images
+    VectorType m_z, m_q, m_s, m_p;        ///< Search direction and its images
+    T m_gamma, m_alpha;
+};
+
+} // namespace gismo
+
+#ifndef GISMO_BUILD_LIB
+#include GISMO_HPP_HEADER(gsPipelinedCG.hpp)
+#endif
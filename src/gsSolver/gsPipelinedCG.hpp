@@ -0,0 +1,137 @@
+/** @file gsPipelinedCG.hpp
+
+    @brief Pipelined conjugate gradient solver
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+namespace gismo
+{
+
+template<class T>
+bool gsPipelinedCG<T>::initIteration( const typename gsPipelinedCG<T>::VectorType& rhs,
+                                      typename gsPipelinedCG<T>::VectorType& x )
+{
+    if (Base::initIteration(rhs,x))
+        return true;
+
+    const index_t n = m_mat->cols();
+    internal::parallelSetZero(m_r,n,1);                                 // first touch by the threads
+    internal::parallelSetZero(m_u,n,1);
+    internal::parallelSetZero(m_w,n,1);
+    internal::parallelSetZero(m_m,n,1);
+    internal::parallelSetZero(m_n,n,1);
+    internal::parallelSetZero(m_z,n,1);
+    internal::parallelSetZero(m_q,n,1);
+    internal::parallelSetZero(m_s,n,1);
+    internal::parallelSetZero(m_p,n,1);
+
+    m_rhs = &rhs; // needed for the restarts
+    return restart(x);
+}
+
+template<class T>
+bool gsPipelinedCG<T>::restart( const typename gsPipelinedCG<T>::VectorType& x )
+{
+    m_mat->apply(x,m_n);
+    internal::parallelAxpby((T)(1), *m_rhs, (T)(0), m_r);
+    internal::parallelAxpby((T)(-1), m_n, (T)(1), m_r);             // true residual
+
+    T rr = internal::parallelDot(m_r,m_r);
+    m_error = math::sqrt(m_comm.sum(rr)) / m_rhs_norm;
+    if (m_error < m_tol)
+        return true;
+
+    m_precond->apply(m_r,m_u);
+    m_mat->apply(m_u,m_w);
+    m_gamma = m_alpha = 0;
+
+    return false;
+}
+
+template<class T>
+bool gsPipelinedCG<T>::step( typename gsPipelinedCG<T>::VectorType& x )
+{
+    // Residual replacement: recompute the recursively updated vectors,
+    // without changing the search direction
+    if (m_replace > 0 && m_num_iter > 1 && 0 == (m_num_iter-1) % m_replace)
+    {
+        m_mat->apply(x,m_n);
+        internal::parallelAxpby((T)(1), *m_rhs, (T)(0), m_r);
+        internal::parallelAxpby((T)(-1), m_n, (T)(1), m_r);
+        m_precond->apply(m_r,m_u);
+        m_mat->apply(m_u,m_w);
+        m_mat->apply(m_p,m_s);
+        m_precond->apply(m_s,m_q);
+        m_mat->apply(m_q,m_z);
+    }
+
+    // Start the reduction of the inner products ...
+    T dots[3] = { internal::parallelDot(m_r,m_u),
+                  internal::parallelDot(m_w,m_u),
+                  internal::parallelDot(m_r,m_r) };
+    gsMpiRequest req;
+    m_comm.isum(dots, 3, &req);
+
+    // ... and apply the preconditioner and the matrix meanwhile
+    m_precond->apply(m_w,m_m);
+    m_mat->apply(m_m,m_n);
+
+    req.wait();
+
+    // dots[2] is the residual of the previous step
+    m_error = math::sqrt(dots[2]) / m_rhs_norm;
+    if (m_error < m_tol)
+    {
+        --m_num_iter;
+        // The recursively computed residual drifts from the true one, so
+        // the iteration is restarted with the latter if needed
+        if (restart(x))
+            return true;
+        ++m_num_iter;
+        return false;
+    }
+
+    const T gamma = dots[0];
+    const T delta = dots[1];
+    T beta, alpha;
+    if (0 == m_gamma)
+    {
+        beta  = 0;
+        alpha = gamma / delta;
+    }
+    else
+    {
+        beta  = gamma / m_gamma;
+        alpha = gamma / (delta - beta * gamma / m_alpha);
+    }
+    m_gamma = gamma;
+    m_alpha = alpha;
+
+    // Fused update of the search directions, the solution and the residuals
+    const index_t n = m_r.size();
+    T * px = x.data();
+    T * pr = m_r.data(), * pu = m_u.data(), * pw = m_w.data();
+    const T * pm = m_m.data(), * pn = m_n.data();
+    T * pz = m_z.data(), * pq = m_q.data(), * ps = m_s.data(), * pp = m_p.data();
+#   pragma omp parallel for schedule(static) if(n > internal::gsParallelMinSize)
+    for (index_t i = 0; i < n; ++i)
+    {
+        pz[i] = pn[i] + beta * pz[i];
+        pq[i] = pm[i] + beta * pq[i];
+        ps[i] = pw[i] + beta * ps[i];
+        pp[i] = pu[i] + beta * pp[i];
+        px[i] += alpha * pp[i];
+        pr[i] -= alpha * ps[i];
+        pu[i] -= alpha * pq[i];
+        pw[i] -= alpha * pz[i];
+    }
+
+    return false;
+}
+
+} // end namespace gismo
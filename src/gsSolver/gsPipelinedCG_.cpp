@@ -0,0 +1,9 @@
+#include <gsSolver/gsPipelinedCG.h>
+#include <gsSolver/gsPipelinedCG.hpp>
+
+namespace gismo
+{
+
+CLASS_TEMPLATE_INST gsPipelinedCG<real_t>;
+
+} // namespace gismo
@@ -0,0 +1,165 @@
+/** @file gsSStepGMRes.h
+
+    @brief Communication-avoiding (s-step) restarted GMRES
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#pragma once
+
+#include <gsSolver/gsIterativeSolver.h>
+#include <gsParallel/gsMpi.h>
+
+namespace gismo
+{
+
+/// @brief The s-step generalized minimal residual (GMRES) method with
+/// block classical Gram-Schmidt orthogonalization.
+///
+/// The restarted GMRES method with right preconditioning. One step
+/// generates \f$ s \f$ Krylov vectors at once, using the (scaled)
+/// monomial basis, and orthogonalizes them as a block: against the
+/// previous basis by classical Gram-Schmidt applied twice (BCGS2)
+/// and among themselves by the Cholesky QR factorization applied
+/// twice (CholQR2). So, the inner products of \f$ s \f$ iterations
+/// are computed as four matrix products with four global reductions,
+/// instead of \f$ O(s k) \f$ separate inner products and reductions
+/// of the modified Gram-Schmidt method. The Hessenberg matrix is
+/// recovered from the triangular factors.
+///
+/// For \f$ s = 1 \f$, this is GMRES with the classical Gram-Schmidt
+/// method applied twice (CGS2). The monomial basis gets ill-conditioned
+/// for large \f$ s \f$, so values up to about 5 are advisable. If the
+/// Cholesky factorization of a block breaks down, the step is redone
+/// with a single vector.
+///
+/// The vectors are the local parts of the distributed vectors, and
+/// the operator and the preconditioner have to do the communication
+/// which is needed for their application. By default, the solver
+/// runs sequentially (communicator gsSerialComm).
+///
+/// \ingroup Solver
+template<class T = real_t>
+class gsSStepGMRes : public gsIterativeSolver<T>
+{
+public:
+    typedef gsIterativeSolver<T> Base;
+
+    typedef gsMatrix<T>  VectorType;
+
+    typedef typename Base::LinOpPtr LinOpPtr;
+
+    typedef memory::shared_ptr<gsSStepGMRes> Ptr;
+    typedef memory::unique_ptr<gsSStepGMRes> uPtr;
+
+    /// @brief Constructor using a matrix (operator) and optionally a preconditionner
+    ///
+    /// @param mat     The operator to be solved for, see gsIterativeSolver for details
+    /// @param precond The preconditioner, defaulted to the identity
+    template< typename OperatorType >
+    explicit gsSStepGMRes( const OperatorType& mat, const LinOpPtr& precond = LinOpPtr() )
+    : Base(mat, precond), m_comm(gsSerialComm()), m_steps(4), m_restart(30) {}
+
+    /// @brief Make function using a matrix (operator) and optionally a preconditionner
+    ///
+    /// @param mat     The operator to be solved for, see gsIterativeSolver for details
+    /// @param precond The preconditioner, defaulted to the identity
+    template< typename OperatorType >
+    static uPtr make( const OperatorType& mat, const LinOpPtr& precond = LinOpPtr() )
+    { return uPtr( new gsSStepGMRes(mat, precond) ); }
+
+    /// @brief Returns a list of default options
+    static gsOptionList defaultOptions()
+    {
+        gsOptionList opt = Base::defaultOptions();
+        opt.addInt("Steps",   "Number of Krylov vectors generated per step (s)", 4  );
+        opt.addInt("Restart", "Dimension of the Krylov space before restarting", 30 );
+        return opt;
+    }
+
+    /// @brief Set the options based on a gsOptionList
+    gsSStepGMRes& setOptions(const gsOptionList& opt)
+    {
+        Base::setOptions(opt);
+        m_steps   = opt.askInt("Steps",   m_steps  );
+        m_restart = opt.askInt("Restart", m_restart);
+        return *this;
+    }
+
+    bool initIteration( const VectorType& rhs, VectorType& x );
+    bool step( VectorType& x );
+    void finalizeIteration( VectorType& x );
+
+    /// Returns the norm of \a v, summed up over the processes
+    T globalNorm( const VectorType& v ) const
+    {
+        T result = internal::parallelDot(v,v);
+        return math::sqrt(m_comm.sum(result));
+    }
+
+    /// @brief Set the number of Krylov vectors generated per step (s)
+    void setSteps( index_t steps )           { m_steps = steps; }
+
+    /// @brief Set the dimension of the Krylov space before restarting
+    void setRestart( index_t restart )       { m_restart = restart; }
+
+    /// @brief Set the communicator for the reductions of the inner products
+    void setComm( const gsMpiComm & comm )   { m_comm = comm; }
+
+    /// Prints the object as a string.
+    std::ostream &print(std::ostream &os) const
+    {
+        os << "gsSStepGMRes\n";
+        return os;
+    }
+
+private:
+
+    /// Starts a new cycle with the residual of \a x
+    bool restart( const VectorType& x );
+
+    /// Orthonormalizes the \a b columns after the first k+1 columns of m_Q;
+    /// returns false if the Cholesky factorization breaks down
+    bool orthogonalize( index_t b, gsMatrix<T> & R12, gsMatrix<T> & R22 );
+
+    /// Solves the least squares problem with the Hessenberg matrix
+    /// and returns the norm of its residual
+    T leastSquares();
+
+    /// Adds the correction of the current cycle to \a x
+    void updateSolution( VectorType& x );
+
+    /// Sums the entries of \a mat over all processes
+    void sum( gsMatrix<T> & mat ) const
+    { m_comm.sum(mat.data(), static_cast<int>(mat.size())); }
+
+private:
+    using Base::m_mat;
+    using Base::m_precond;
+    using Base::m_max_iters;
+    using Base::m_tol;
+    using Base::m_num_iter;
+    using Base::m_rhs_norm;
+    using Base::m_error;
+
+    gsMpiComm m_comm;
+    index_t m_steps, m_restart;
+
+    const VectorType * m_rhs;
+    gsMatrix<T> m_Q;        ///< Orthonormal basis of the Krylov space
+    gsMatrix<T> m_H;        ///< Hessenberg matrix
+    gsMatrix<T> m_y;        ///< Coefficients of the correction
+    VectorType m_tmp, m_tmp2;
+    index_t m_k;            ///< Number of columns of the Hessenberg matrix
+    T m_beta;               ///< Norm of the residual at the start of the cycle
+    T m_sigma;              ///< Scaling of the monomial basis, estimates the norm of the operator
+};
+
+} // namespace gismo
+
+#ifndef GISMO_BUILD_LIB
+#include GISMO_HPP_HEADER(gsSStepGMRes.hpp)
+#endif
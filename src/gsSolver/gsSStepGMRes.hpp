@@ -0,0 +1,186 @@
+/** @file gsSStepGMRes.hpp
+
+    @brief Communication-avoiding (s-step) restarted GMRES
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+namespace gismo
+{
+
+template<class T>
+bool gsSStepGMRes<T>::initIteration( const typename gsSStepGMRes<T>::VectorType& rhs,
+                                     typename gsSStepGMRes<T>::VectorType& x )
+{
+    GISMO_ASSERT( m_steps > 0 && m_restart > 0, "Invalid number of steps or restart." );
+    if (Base::initIteration(rhs,x))
+        return true;
+
+    m_rhs = &rhs; // needed for the restarts
+    internal::parallelSetZero(m_Q, m_mat->rows(), m_restart+1);     // first touch by the threads
+    m_H.setZero(m_restart+1, m_restart);
+    m_sigma = 0;
+    m_k = 0;
+
+    return restart(x);
+}
+
+template<class T>
+bool gsSStepGMRes<T>::restart( const typename gsSStepGMRes<T>::VectorType& x )
+{
+    m_mat->apply(x, m_tmp);
+    m_Q.col(0) = *m_rhs - m_tmp;
+    T rr = m_Q.col(0).squaredNorm();
+    m_beta = math::sqrt(m_comm.sum(rr));
+    m_H.setZero();
+    m_k = 0;
+
+    m_error = m_beta / m_rhs_norm;
+    if (m_error < m_tol)
+        return true;
+
+    m_Q.col(0) /= m_beta;
+    return false;
+}
+
+template<class T>
+bool gsSStepGMRes<T>::orthogonalize( index_t b, gsMatrix<T> & R12, gsMatrix<T> & R22 )
+{
+    typename gsMatrix<T>::Columns Q = m_Q.leftCols(m_k+1);
+    typename gsMatrix<T>::Columns W = m_Q.middleCols(m_k+1, b);
+
+    // Block classical Gram-Schmidt, applied twice
+    gsMatrix<T> C;
+    R12.setZero(m_k+1, b);
+    for (index_t pass = 0; pass < 2; ++pass)
+    {
+        C.noalias() = Q.transpose() * W;
+        sum(C);
+        W.noalias() -= Q * C;
+        R12 += C;
+    }
+
+    // Cholesky QR, applied twice
+    gsMatrix<T> G, R;
+    R22.setIdentity(b, b);
+    for (index_t pass = 0; pass < 2; ++pass)
+    {
+        G.noalias() = W.transpose() * W;
+        sum(G);
+        if (1 == b) // a vanishing vector means that the Krylov space is invariant
+        {
+            const T nrm = math::sqrt(G(0,0));
+            R22 *= nrm;
+            if (0 == nrm)
+                return true;
+            W /= nrm;
+            continue;
+        }
+
+        gsEigen::LLT<typename gsMatrix<T>::Base> llt(G);
+        if (llt.info() != gsEigen::Success)
+            return false;
+        R = llt.matrixU();
+        if ( R.diagonal().minCoeff() <= math::sqrt(std::numeric_limits<T>::epsilon()) * R.diagonal().maxCoeff() )
+            return false;
+        R.template triangularView<gsEigen::Upper>().template solveInPlace<gsEigen::OnTheRight>(W);
+        R22 = R * R22;
+    }
+    return true;
+}
+
+template<class T>
+bool gsSStepGMRes<T>::step( typename gsSStepGMRes<T>::VectorType& x )
+{
+    const index_t k = m_k;
+    // The scaling of the basis is estimated by the first column of the Hessenberg matrix
+    index_t b = (0 == m_sigma) ? 1 : math::min(m_steps, m_restart - k);
+    b = math::min(b, m_max_iters - m_num_iter + 1);
+    const T sigma = (0 == m_sigma) ? (T)(1) : m_sigma;
+
+    gsMatrix<T> R12, R22;
+    for (;;)
+    {
+        // Scaled monomial basis: W_j = (A M^{-1})^{j+1} q_k / sigma^{j+1}
+        m_tmp2 = m_Q.col(k);
+        for (index_t j = 0; j < b; ++j)
+        {
+            m_precond->apply(m_tmp2, m_tmp);
+            m_mat->apply(m_tmp, m_tmp2);
+            m_tmp2 /= sigma;
+            m_Q.col(k+1+j) = m_tmp2;
+        }
+        if (orthogonalize(b, R12, R22))
+            break;
+        b = 1;
+    }
+
+    // The coefficients of P = [q_k, W_0, ..., W_{b-1}] in the basis Q satisfy
+    // A M^{-1} P(:,0:b-1) = sigma P(:,1:b). Since Q(:,0:k-1) P(0:k-1,0:b-1)
+    // + Q(:,k:k+b-1) P(k:k+b-1,0:b-1) = P(:,0:b-1), where the latter block
+    // is upper triangular, and A M^{-1} Q(:,0:k-1) = Q(:,0:k) H(0:k,0:k-1),
+    // we obtain the new columns of the Hessenberg matrix.
+    gsMatrix<T> P = gsMatrix<T>::Zero(k+b+1, b+1);
+    P(k,0) = 1;
+    P.block(0,1,k+1,b) = R12;
+    P.block(k+1,1,b,b) = R22;
+
+    gsMatrix<T> Hnew = sigma * P.rightCols(b);
+    Hnew.topRows(k+1).noalias() -= m_H.topLeftCorner(k+1,k) * P.topLeftCorner(k,b);
+    P.block(k,0,b,b).template triangularView<gsEigen::Upper>().template solveInPlace<gsEigen::OnTheRight>(Hnew);
+    m_H.block(0,k,k+b+1,b) = Hnew;
+
+    for (index_t j = 0; j < b; ++j)
+        m_sigma = math::max(m_sigma, Hnew.col(j).norm());
+
+    m_k += b;
+    m_num_iter += b-1;
+
+    m_error = leastSquares() / m_rhs_norm;
+    if (m_error < m_tol)
+    {
+        updateSolution(x);
+        return true;
+    }
+
+    if (m_k == m_restart)
+    {
+        updateSolution(x);
+        return restart(x);
+    }
+    return false;
+}
+
+template<class T>
+T gsSStepGMRes<T>::leastSquares()
+{
+    gsMatrix<T> g = gsMatrix<T>::Zero(m_k+1,1);
+    g(0,0) = m_beta;
+    const gsMatrix<T> H = m_H.topLeftCorner(m_k+1,m_k);
+    m_y = H.householderQr().solve(g);
+    return (g - H * m_y).norm();
+}
+
+template<class T>
+void gsSStepGMRes<T>::updateSolution( typename gsSStepGMRes<T>::VectorType& x )
+{
+    if (0 == m_k)
+        return;
+    m_tmp2.noalias() = m_Q.leftCols(m_k) * m_y;
+    m_precond->apply(m_tmp2, m_tmp);
+    x += m_tmp;
+    m_k = 0;
+}
+
+template<class T>
+void gsSStepGMRes<T>::finalizeIteration( typename gsSStepGMRes<T>::VectorType& x )
+{
+    // Add the correction of an unfinished cycle
+    updateSolution(x);
+}
+
+} // end namespace gismo
@@ -14,6 +14,7 @@
 
 #include <gsCore/gsLinearAlgebra.h>
 #include <gsSolver/gsPreconditioner.h>
+#include <gsSolver/gsParallelMatrixOp.h> // for internal::gsParallelMinSize
 
 namespace gismo
 {
@@ -24,6 +25,14 @@ template<typename T>
 void gaussSeidelSweep(const gsSparseMatrix<T> & A, gsMatrix<T>& x, const gsMatrix<T>& f);
 template<typename T>
 void reverseGaussSeidelSweep(const gsSparseMatrix<T> & A, gsMatrix<T>& x, const gsMatrix<T>& f);
+template<typename T>
+void multicolorRows(const gsSparseMatrix<T> & A, std::vector<index_t> & colorPtr, std::vector<index_t> & rows);
+template<typename T>
+void coloredGaussSeidelSweep(const gsSparseMatrix<T> & A, gsMatrix<T>& x, const gsMatrix<T>& f,
+                             const std::vector<index_t> & colorPtr, const std::vector<index_t> & rows, T tau);
+template<typename T>
+void reverseColoredGaussSeidelSweep(const gsSparseMatrix<T> & A, gsMatrix<T>& x, const gsMatrix<T>& f,
+                                    const std::vector<index_t> & colorPtr, const std::vector<index_t> & rows, T tau);
 } // namespace internal
 
 /// @brief Richardson preconditioner
@@ -180,9 +189,8 @@ public:
         GISMO_ASSERT( m_expr.rows() == rhs.rows() && m_expr.cols() == m_expr.rows(),
                       "Dimensions do not match.");
 
-        GISMO_ASSERT( rhs.cols() == 1, "This operator is only implemented for a single right-hand side." );
-
-        x.array() += m_tau * ( rhs - m_expr * x ).array() / m_expr.diagonal().array();
+        const gsMatrix<T> dinv = m_tau * m_expr.diagonal().cwiseInverse();
+        x += dinv.asDiagonal() * ( rhs - m_expr * x );
     }
 
     // We use our own apply implementation as we can save one multiplication. This is important if the number
@@ -192,13 +200,14 @@ public:
         GISMO_ASSERT( m_expr.rows() == input.rows() && m_expr.cols() == m_expr.rows(),
                       "Dimensions do not match.");
 
-        GISMO_ASSERT( input.cols() == 1, "This operator is only implemented for a single right-hand side." );
+        // The scaled inverse of the diagonal is applied to all columns
+        const gsMatrix<T> dinv = m_tau * m_expr.diagonal().cwiseInverse();
 
         // For the first sweep, we do not need to multiply with the matrix
-        x.array() = m_tau * input.array() / m_expr.diagonal().array();
+        x.noalias() = dinv.asDiagonal() * input;
 
         for (index_t k = 1; k < m_num_of_sweeps; ++k)
-            x.array() += m_tau * ( input - m_expr * x ).array() / m_expr.diagonal().array();
+            x += dinv.asDiagonal() * ( input - m_expr * x );
     }
 
     index_t rows() const {return m_expr.rows();}
@@ -388,6 +397,164 @@ template <class Derived>
 typename gsGaussSeidelOp<Derived,gsGaussSeidel::symmetric>::uPtr makeSymmetricGaussSeidelOp(const memory::shared_ptr<Derived>& mat)
 { return gsGaussSeidelOp<Derived,gsGaussSeidel::symmetric>::make(mat); }
 
+/// @brief Multicolored Gauss-Seidel preconditioner
+///
+/// The rows of the matrix are colored once, in the constructor, such
+/// that no two rows of the same color are coupled by the matrix. A
+/// sweep visits the colors one after the other and updates all rows
+/// of one color in parallel. This differs from gsGaussSeidelOp only
+/// in the order of the rows, so the smoothing properties are
+/// comparable, but the number of colors (about (2p+1)^d for
+/// isogeometric discretizations) bounds the parallel work per step.
+///
+/// With a damping parameter different from 1, the operator is a
+/// (multicolored) SOR or, for `gsGaussSeidel::symmetric`, SSOR method.
+/// The sparsity pattern of the matrix is assumed to be symmetric.
+///
+/// \ingroup Solver
+template <typename MatrixType, gsGaussSeidel::ordering ordering = gsGaussSeidel::forward>
+class gsColoredGaussSeidelOp GISMO_FINAL : public gsPreconditionerOp<typename MatrixType::Scalar>
+{
+    typedef memory::shared_ptr<MatrixType>          MatrixPtr;
+    typedef typename MatrixType::Nested             NestedMatrix;
+
+public:
+    /// Scalar type
+    typedef typename MatrixType::Scalar T;
+
+    /// Shared pointer for gsColoredGaussSeidelOp
+    typedef memory::shared_ptr< gsColoredGaussSeidelOp > Ptr;
+
+    /// Unique pointer for gsColoredGaussSeidelOp
+    typedef memory::unique_ptr< gsColoredGaussSeidelOp > uPtr;
+
+    /// Base class
+    typedef gsPreconditionerOp<T> Base;
+
+    /// Constructor with given matrix
+    explicit gsColoredGaussSeidelOp(const MatrixType& mat, T tau = 1)
+    : m_mat(), m_expr(mat.derived()), m_tau(tau)
+    { internal::multicolorRows<T>(m_expr, m_colorPtr, m_rows); }
+
+    /// Constructor with shared pointer to matrix
+    explicit gsColoredGaussSeidelOp(const MatrixPtr& mat, T tau = 1)
+    : m_mat(mat), m_expr(m_mat->derived()), m_tau(tau)
+    { internal::multicolorRows<T>(m_expr, m_colorPtr, m_rows); }
+
+    static uPtr make(const MatrixType& mat, T tau = 1)
+    { return memory::make_unique( new gsColoredGaussSeidelOp(mat, tau) ); }
+
+    static uPtr make(const MatrixPtr& mat, T tau = 1)
+    { return memory::make_unique( new gsColoredGaussSeidelOp(mat, tau) ); }
+
+    void step(const gsMatrix<T> & rhs, gsMatrix<T> & x) const
+    {
+        if ( ordering == gsGaussSeidel::forward )
+            internal::coloredGaussSeidelSweep<T>(m_expr,x,rhs,m_colorPtr,m_rows,m_tau);
+        if ( ordering == gsGaussSeidel::reverse )
+            internal::reverseColoredGaussSeidelSweep<T>(m_expr,x,rhs,m_colorPtr,m_rows,m_tau);
+        if ( ordering == gsGaussSeidel::symmetric )
+        {
+            internal::coloredGaussSeidelSweep<T>(m_expr,x,rhs,m_colorPtr,m_rows,m_tau);
+            internal::reverseColoredGaussSeidelSweep<T>(m_expr,x,rhs,m_colorPtr,m_rows,m_tau);
+        }
+    }
+
+    void stepT(const gsMatrix<T> & rhs, gsMatrix<T> & x) const
+    {
+        if ( ordering == gsGaussSeidel::forward )
+            internal::reverseColoredGaussSeidelSweep<T>(m_expr,x,rhs,m_colorPtr,m_rows,m_tau);
+        if ( ordering == gsGaussSeidel::reverse )
+            internal::coloredGaussSeidelSweep<T>(m_expr,x,rhs,m_colorPtr,m_rows,m_tau);
+        if ( ordering == gsGaussSeidel::symmetric )
+        {
+            internal::coloredGaussSeidelSweep<T>(m_expr,x,rhs,m_colorPtr,m_rows,m_tau);
+            internal::reverseColoredGaussSeidelSweep<T>(m_expr,x,rhs,m_colorPtr,m_rows,m_tau);
+        }
+    }
+
+    index_t rows() const {return m_expr.rows();}
+    index_t cols() const {return m_expr.cols();}
+
+    /// Returns the number of colors
+    index_t numColors() const { return m_colorPtr.size() - 1; }
+
+    /// Set damping parameter
+    void setDamping(const T tau) { m_tau = tau;  }
+
+    /// Get damping parameter
+    T getDamping() const         { return m_tau; }
+
+    /// Get the default options as gsOptionList object
+    static gsOptionList defaultOptions()
+    {
+        gsOptionList opt = Base::defaultOptions();
+        opt.addReal( "Damping", "Damping (relaxation) parameter of the Gauss-Seidel iteration", 1 );
+        return opt;
+    }
+
+    /// Set options based on a gsOptionList object
+    virtual void setOptions(const gsOptionList & opt)
+    {
+        Base::setOptions(opt);
+        m_tau = opt.askReal( "Damping", m_tau );
+    }
+
+    /// Returns the matrix
+    NestedMatrix matrix() const { return m_expr; }
+
+    /// Returns a shared pinter to the matrix
+    MatrixPtr    matrixPtr() const {
+        GISMO_ENSURE( m_mat, "A shared pointer is only available if it was provided to gsColoredGaussSeidelOp." );
+        return m_mat;
+    }
+
+    typename gsLinearOperator<T>::Ptr underlyingOp() const { return makeMatrixOp(m_mat); }
+
+private:
+    const MatrixPtr m_mat;  ///< Shared pointer to matrix (if needed)
+    NestedMatrix    m_expr; ///< Nested Eigen expression
+    std::vector<index_t> m_colorPtr; ///< Rows of color c are m_rows[m_colorPtr[c]..m_colorPtr[c+1]-1]
+    std::vector<index_t> m_rows;     ///< Rows ordered by color
+    T m_tau;
+};
+
+/// @brief Returns a smart pointer to a multicolored Gauss-Seidel operator referring on \a mat
+/// \relates gsColoredGaussSeidelOp
+template <class Derived>
+typename gsColoredGaussSeidelOp<Derived>::uPtr makeColoredGaussSeidelOp(const gsEigen::EigenBase<Derived>& mat, typename Derived::Scalar tau = 1)
+{ return gsColoredGaussSeidelOp<Derived>::make(mat.derived(), tau); }
+
+/// @brief Returns a smart pointer to a multicolored Gauss-Seidel operator referring on \a mat
+/// \relates gsColoredGaussSeidelOp
+template <class Derived>
+typename gsColoredGaussSeidelOp<Derived>::uPtr makeColoredGaussSeidelOp(const memory::shared_ptr<Derived>& mat, typename Derived::Scalar tau = 1)
+{ return gsColoredGaussSeidelOp<Derived>::make(mat, tau); }
+
+/// @brief Returns a smart pointer to a reverse multicolored Gauss-Seidel operator referring on \a mat
+/// \relates gsColoredGaussSeidelOp
+template <class Derived>
+typename gsColoredGaussSeidelOp<Derived,gsGaussSeidel::reverse>::uPtr makeColoredReverseGaussSeidelOp(const gsEigen::EigenBase<Derived>& mat, typename Derived::Scalar tau = 1)
+{ return gsColoredGaussSeidelOp<Derived,gsGaussSeidel::reverse>::make(mat.derived(), tau); }
+
+/// @brief Returns a smart pointer to a reverse multicolored Gauss-Seidel operator referring on \a mat
+/// \relates gsColoredGaussSeidelOp
+template <class Derived>
+typename gsColoredGaussSeidelOp<Derived,gsGaussSeidel::reverse>::uPtr makeColoredReverseGaussSeidelOp(const memory::shared_ptr<Derived>& mat, typename Derived::Scalar tau = 1)
+{ return gsColoredGaussSeidelOp<Derived,gsGaussSeidel::reverse>::make(mat, tau); }
+
+/// @brief Returns a smart pointer to a symmetric multicolored Gauss-Seidel operator referring on \a mat
+/// \relates gsColoredGaussSeidelOp
+template <class Derived>
+typename gsColoredGaussSeidelOp<Derived,gsGaussSeidel::symmetric>::uPtr makeColoredSymmetricGaussSeidelOp(const gsEigen::EigenBase<Derived>& mat, typename Derived::Scalar tau = 1)
+{ return gsColoredGaussSeidelOp<Derived,gsGaussSeidel::symmetric>::make(mat.derived(), tau); }
+
+/// @brief Returns a smart pointer to a symmetric multicolored Gauss-Seidel operator referring on \a mat
+/// \relates gsColoredGaussSeidelOp
+template <class Derived>
+typename gsColoredGaussSeidelOp<Derived,gsGaussSeidel::symmetric>::uPtr makeColoredSymmetricGaussSeidelOp(const memory::shared_ptr<Derived>& mat, typename Derived::Scalar tau = 1)
+{ return gsColoredGaussSeidelOp<Derived,gsGaussSeidel::symmetric>::make(mat, tau); }
+
 /// @brief  Incomplete LU with thresholding preconditioner
 ///
 /// \ingroup Solvers
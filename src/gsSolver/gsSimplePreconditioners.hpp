@@ -23,9 +23,9 @@ void gaussSeidelSweep(const gsSparseMatrix<T> & A, gsMatrix<T>& x, const gsMatri
     GISMO_ASSERT( A.rows() == x.rows() && x.rows() == f.rows() && A.cols() == A.rows() && x.cols() == f.cols(),
         "Dimensions do not match.");
 
-    GISMO_ASSERT( f.cols() == 1, "This operator is only implemented for a single right-hand side." );
-
     // A is supposed to be symmetric, so it doesn't matter if it's stored in row- or column-major order
+    // The columns (right-hand sides) are independent
+    for (index_t c = 0; c < x.cols(); ++c)
     for (index_t i = 0; i < A.outerSize(); ++i)
     {
         T diag = 0;
@@ -33,12 +33,12 @@ void gaussSeidelSweep(const gsSparseMatrix<T> & A, gsMatrix<T>& x, const gsMatri
 
         for (typename gsSparseMatrix<T>::InnerIterator it(A,i); it; ++it)
         {
-            sum += it.value() * x( it.index() );        // compute A.x
+            sum += it.value() * x( it.index(), c );     // compute A.x
             if (it.index() == i)
                 diag = it.value();
         }
 
-        x(i) += (f(i) - sum) / diag;
+        x(i,c) += (f(i,c) - sum) / diag;
     }
 }
 
@@ -48,9 +48,9 @@ void reverseGaussSeidelSweep(const gsSparseMatrix<T> & A, gsMatrix<T>& x, const
     GISMO_ASSERT( A.rows() == x.rows() && x.rows() == f.rows() && A.cols() == A.rows() && x.cols() == f.cols(),
         "Dimensions do not match.");
 
-    GISMO_ASSERT( f.cols() == 1, "This operator is only implemented for a single right-hand side." );
-
     // A is supposed to be symmetric, so it doesn't matter if it's stored in row- or column-major order
+    // The columns (right-hand sides) are independent
+    for (index_t c = 0; c < x.cols(); ++c)
     for (index_t i = A.outerSize() - 1; i >= 0; --i)
     {
         T diag = 0;
@@ -58,12 +58,126 @@ void reverseGaussSeidelSweep(const gsSparseMatrix<T> & A, gsMatrix<T>& x, const
 
         for (typename gsSparseMatrix<T>::InnerIterator it(A,i); it; ++it)
         {
-            sum += it.value() * x( it.index() );        // compute A.x
+            sum += it.value() * x( it.index(), c );     // compute A.x
             if (it.index() == i)
                 diag = it.value();
         }
 
-        x(i) += (f(i) - sum) / diag;
+        x(i,c) += (f(i,c) - sum) / diag;
+    }
+}
+
+template<typename T>
+void multicolorRows(const gsSparseMatrix<T> & A, std::vector<index_t> & colorPtr, std::vector<index_t> & rows)
+{
+    GISMO_ASSERT( A.cols() == A.rows(), "The matrix is not square." );
+
+    // Greedy coloring: every row gets the smallest color not used by
+    // the rows it is coupled with. mark[c]==i means that color c is
+    // taken by a neighbor of row i.
+    const index_t n = A.outerSize();
+    std::vector<index_t> color(n, -1), mark;
+    index_t numColors = 0;
+    for (index_t i = 0; i < n; ++i)
+    {
+        for (typename gsSparseMatrix<T>::InnerIterator it(A,i); it; ++it)
+        {
+            const index_t c = color[it.index()];
+            if (c != -1)
+                mark[c] = i;
+        }
+
+        index_t c = 0;
+        while (c < numColors && mark[c] == i)
+            ++c;
+        if (c == numColors)
+        {
+            ++numColors;
+            mark.push_back(-1);
+        }
+        color[i] = c;
+    }
+
+    // Sort the rows by color, keeping their order within each color
+    colorPtr.assign(numColors + 1, 0);
+    for (index_t i = 0; i < n; ++i)
+        ++colorPtr[color[i] + 1];
+    std::partial_sum(colorPtr.begin(), colorPtr.end(), colorPtr.begin());
+
+    rows.resize(n);
+    std::vector<index_t> pos(colorPtr.begin(), colorPtr.end() - 1);
+    for (index_t i = 0; i < n; ++i)
+        rows[ pos[color[i]]++ ] = i;
+}
+
+template<typename T>
+void coloredGaussSeidelSweep(const gsSparseMatrix<T> & A, gsMatrix<T>& x, const gsMatrix<T>& f,
+                             const std::vector<index_t> & colorPtr, const std::vector<index_t> & rows, T tau)
+{
+    GISMO_ASSERT( A.rows() == x.rows() && x.rows() == f.rows() && A.cols() == A.rows() && x.cols() == f.cols(),
+        "Dimensions do not match.");
+
+    GISMO_ASSERT( static_cast<index_t>(rows.size()) == A.outerSize(), "The coloring does not fit the matrix." );
+
+    const index_t numColors = colorPtr.size() - 1;
+
+    // Rows of the same color are not coupled, so they can be updated
+    // in any order; small matrices (eg. coarse levels) are not worth
+    // the fork and join
+#   pragma omp parallel if(A.outerSize() > gsParallelMinSize)
+    for (index_t col = 0; col < x.cols(); ++col)
+    for (index_t c = 0; c < numColors; ++c)
+    {
+#       pragma omp for schedule(static)
+        for (index_t k = colorPtr[c]; k < colorPtr[c+1]; ++k)
+        {
+            const index_t i = rows[k];
+            T diag = 0;
+            T sum  = 0;
+
+            for (typename gsSparseMatrix<T>::InnerIterator it(A,i); it; ++it)
+            {
+                sum += it.value() * x( it.index(), col );   // compute A.x
+                if (it.index() == i)
+                    diag = it.value();
+            }
+
+            x(i,col) += tau * (f(i,col) - sum) / diag;
+        }
+    }
+}
+
+template<typename T>
+void reverseColoredGaussSeidelSweep(const gsSparseMatrix<T> & A, gsMatrix<T>& x, const gsMatrix<T>& f,
+                                    const std::vector<index_t> & colorPtr, const std::vector<index_t> & rows, T tau)
+{
+    GISMO_ASSERT( A.rows() == x.rows() && x.rows() == f.rows() && A.cols() == A.rows() && x.cols() == f.cols(),
+        "Dimensions do not match.");
+
+    GISMO_ASSERT( static_cast<index_t>(rows.size()) == A.outerSize(), "The coloring does not fit the matrix." );
+
+    const index_t numColors = colorPtr.size() - 1;
+
+#   pragma omp parallel if(A.outerSize() > gsParallelMinSize)
+    for (index_t col = 0; col < x.cols(); ++col)
+    for (index_t c = numColors - 1; c >= 0; --c)
+    {
+#       pragma omp for schedule(static)
+        for (index_t k = colorPtr[c+1] - 1; k >= colorPtr[c]; --k)
+        {
+            const index_t i = rows[k];
+            T diag = 0;
+            T sum  = 0;
+
+            for (typename gsSparseMatrix<T>::InnerIterator it(A,i); it; ++it)
+            {
+                sum += it.value() * x( it.index(), col );   // compute A.x
+                if (it.index() == i)
+                    diag = it.value();
+            }
+
+            x(i,col) += tau * (f(i,col) - sum) / diag;
+        }
     }
 }
 
@@ -9,6 +9,11 @@ namespace internal
 
 TEMPLATE_INST void gaussSeidelSweep(const gsSparseMatrix<real_t> & A, gsMatrix<real_t>& x, const gsMatrix<real_t>& f);
 TEMPLATE_INST void reverseGaussSeidelSweep(const gsSparseMatrix<real_t> & A, gsMatrix<real_t>& x, const gsMatrix<real_t>& f);
+TEMPLATE_INST void multicolorRows(const gsSparseMatrix<real_t> & A, std::vector<index_t> & colorPtr, std::vector<index_t> & rows);
+TEMPLATE_INST void coloredGaussSeidelSweep(const gsSparseMatrix<real_t> & A, gsMatrix<real_t>& x, const gsMatrix<real_t>& f,
+                                           const std::vector<index_t> & colorPtr, const std::vector<index_t> & rows, real_t tau);
+TEMPLATE_INST void reverseColoredGaussSeidelSweep(const gsSparseMatrix<real_t> & A, gsMatrix<real_t>& x, const gsMatrix<real_t>& f,
+                                                  const std::vector<index_t> & colorPtr, const std::vector<index_t> & rows, real_t tau);
 
 } // namespace internal
 
@@ -0,0 +1,277 @@
+/** @file gsBenchmark.h
+
+    @brief Timing of benchmark cases with optional hardware counters
+    and output in JSON format.
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <gsUtils/gsStopwatch.h>
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <ostream>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+
+#if defined(__linux__)
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+namespace gismo
+{
+
+/** @brief Hardware performance counters of the running process.
+
+    Uses the perf_event interface of Linux to count cycles,
+    instructions, cache misses and branch misses. The counters
+    include the calling thread and all threads created after open(),
+    therefore open() should be called before the first OpenMP
+    region. On other systems, or if the kernel does not permit
+    access (see /proc/sys/kernel/perf_event_paranoid), open()
+    returns false and no counters are reported.
+
+    \ingroup Utils
+*/
+class gsPerfCounters
+{
+public:
+    typedef std::vector<std::pair<std::string,long long> > Values;
+
+    gsPerfCounters() { }
+
+    ~gsPerfCounters() { close(); }
+
+    /// Opens the counters, returns false if none is available
+    bool open()
+    {
+        close();
+#if defined(__linux__)
+        static const struct { const char * name; unsigned long long config; } events[] =
+        {
+            {"cycles"      , PERF_COUNT_HW_CPU_CYCLES      },
+            {"instructions", PERF_COUNT_HW_INSTRUCTIONS    },
+            {"cache_refs"  , PERF_COUNT_HW_CACHE_REFERENCES},
+            {"cache_misses", PERF_COUNT_HW_CACHE_MISSES    },
+            {"branch_misses",PERF_COUNT_HW_BRANCH_MISSES   }
+        };
+        for (size_t i = 0; i != sizeof(events)/sizeof(events[0]); ++i)
+        {
+            struct perf_event_attr pe;
+            std::memset(&pe, 0, sizeof(pe));
+            pe.type           = PERF_TYPE_HARDWARE;
+            pe.size           = sizeof(pe);
+            pe.config         = events[i].config;
+            pe.disabled       = 1;
+            pe.inherit        = 1;
+            pe.exclude_kernel = 1;
+            pe.exclude_hv     = 1;
+            const int fd = static_cast<int>(syscall(__NR_perf_event_open, &pe, 0, -1, -1, 0));
+            if (fd < 0) continue;
+            m_fd.push_back(fd);
+            m_values.push_back(std::make_pair(std::string(events[i].name), 0LL));
+        }
+#endif
+        return !m_fd.empty();
+    }
+
+    /// Closes the counters
+    void close()
+    {
+#if defined(__linux__)
+        for (size_t i = 0; i != m_fd.size(); ++i)
+            ::close(m_fd[i]);
+#endif
+        m_fd.clear();
+        m_values.clear();
+    }
+
+    /// True if at least one counter is available
+    bool available() const { return !m_fd.empty(); }
+
+    /// Resets and starts the counters
+    void start()
+    {
+#if defined(__linux__)
+        for (size_t i = 0; i != m_fd.size(); ++i)
+        {
+            ioctl(m_fd[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_fd[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /// Stops the counters and reads their values
+    void stop()
+    {
+#if defined(__linux__)
+        for (size_t i = 0; i != m_fd.size(); ++i)
+        {
+            ioctl(m_fd[i], PERF_EVENT_IOC_DISABLE, 0);
+            long long v = 0;
+            if ( sizeof(v) != ::read(m_fd[i], &v, sizeof(v)) )
+                v = -1;
+            m_values[i].second = v;
+        }
+#endif
+    }
+
+    /// The values read by the last call to stop()
+    const Values & values() const { return m_values; }
+
+private:
+    std::vector<int> m_fd;
+    Values m_values;
+
+private:
+    // Non-copyable
+    gsPerfCounters(const gsPerfCounters &);
+    gsPerfCounters & operator=(const gsPerfCounters &);
+};
+
+/** @brief Collects the timings of benchmark cases and writes them
+    in JSON format.
+
+    Each case is identified by a name and a list of parameters (such
+    as degree, refinement level and number of threads). Its time is
+    the best wall-clock time over a number of repetitions, from which
+    the throughput in elements and degrees of freedom per second is
+    derived.
+
+    \code
+    gsBenchmark bm(true); // with hardware counters, if available
+    bm.run("assembly", 5, [&]() { A.assemble(); })
+      .set("degree", p).set("threads", nt)
+      .setSize(numElements, numDofs);
+    bm.toJSON(std::cout);
+    \endcode
+
+    \ingroup Utils
+*/
+class gsBenchmark
+{
+public:
+
+    /// The result of one benchmark case
+    struct result
+    {
+        result() : time(0), elements(0), dofs(0) { }
+
+        /// Sets the parameter \a key to \a value
+        result & set(const std::string & key, double value)
+        {
+            params.push_back(std::make_pair(key, value));
+            return *this;
+        }
+
+        /// Sets the problem size, used for the throughput
+        result & setSize(double numElements, double numDofs)
+        {
+            elements = numElements;
+            dofs     = numDofs;
+            return *this;
+        }
+
+        std::string name;
+        std::vector<std::pair<std::string,double> > params;
+        double time; ///< best wall-clock time in seconds
+        double elements, dofs;
+        gsPerfCounters::Values counters;
+    };
+
+public:
+
+    /// Constructor. If \a counters is true, hardware counters are
+    /// recorded whenever the system provides them.
+    explicit gsBenchmark(bool counters = false)
+    {
+        if (counters)
+            m_counters.open();
+    }
+
+    /// @brief Runs \a op \a numRepeat times, records the best time as
+    /// the result \a name and returns it for adding parameters. The
+    /// counters, if enabled, are the ones of the last repetition.
+    template <class Op>
+    result & run(const std::string & name, int numRepeat, Op op)
+    {
+        result res;
+        res.name = name;
+        gsStopwatch timer;
+        for (int i = 0; i < numRepeat; ++i)
+        {
+            m_counters.start();
+            timer.restart();
+            op();
+            const double t = timer.stop();
+            m_counters.stop();
+            if (0==i || t < res.time)
+                res.time = t;
+        }
+        res.counters = m_counters.values();
+        m_results.push_back(res);
+        return m_results.back();
+    }
+
+    /// True if hardware counters are recorded
+    bool hasCounters() const { return m_counters.available(); }
+
+    /// The results collected so far
+    const std::vector<result> & results() const { return m_results; }
+
+    /// Writes all results to \a os as a JSON object, including the
+    /// key-value pairs \a info (e.g. version and host)
+    std::ostream & toJSON(std::ostream & os,
+                          const std::vector<std::pair<std::string,std::string> > & info =
+                          std::vector<std::pair<std::string,std::string> >() ) const
+    {
+        std::ostringstream ss;
+        ss << std::setprecision(8) << "{\n";
+        for (size_t i = 0; i != info.size(); ++i)
+            ss << "  \"" << info[i].first << "\": \"" << info[i].second << "\",\n";
+        ss << "  \"counters\": " << (hasCounters() ? "true" : "false") << ",\n"
+           << "  \"results\": [";
+        for (size_t r = 0; r != m_results.size(); ++r)
+        {
+            const result & res = m_results[r];
+            ss << (r ? ",\n" : "\n") << "    {\"name\": \"" << res.name << "\"";
+            for (size_t i = 0; i != res.params.size(); ++i)
+                ss << ", \"" << res.params[i].first << "\": " << res.params[i].second;
+            ss << ", \"time\": " << res.time;
+            if (res.elements > 0)
+                ss << ", \"elements\": " << res.elements
+                   << ", \"elements_per_s\": " << res.elements / res.time;
+            if (res.dofs > 0)
+                ss << ", \"dofs\": " << res.dofs
+                   << ", \"dofs_per_s\": " << res.dofs / res.time;
+            if (!res.counters.empty())
+            {
+                ss << ", \"counters\": {";
+                for (size_t i = 0; i != res.counters.size(); ++i)
+                    ss << (i ? ", \"" : "\"") << res.counters[i].first
+                       << "\": " << res.counters[i].second;
+                ss << "}";
+            }
+            ss << "}";
+        }
+        ss << "\n  ]\n}\n";
+        return os << ss.str();
+    }
+
+private:
+    gsPerfCounters m_counters;
+    std::vector<result> m_results;
+};
+
+} // namespace gismo
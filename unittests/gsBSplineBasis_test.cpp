@@ -0,0 +1,104 @@
+/** @file gsBSplineBasis_test.cpp
+
+    @brief Tests the batched and grid evaluation of B-spline bases
+
+    This file is part of the G+Smo library.
+
+    This Source Code Form is subject to the terms of the Mozilla Public
+    License, v. 2.0. If a copy of the MPL was not distributed with this
+    file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "gismo_unittest.h"
+
+SUITE(gsBSplineBasis_test)
+{
+    TEST(evalAllDersBatch)
+    {
+        // Unsorted points, including knots, the end points and
+        // repeated points; the knot vector has an interior double knot
+        gsKnotVector<> kv(0, 1, 4, 4, 1);
+        kv.insert(0.6);
+        gsBSplineBasis<> basis(kv);
+
+        gsMatrix<> u(1, 13);
+        u << 0.3, 0.31, 0.32, 0, 1, 0.6, 0.6, 0.2, 0.95, 0.4, 0.05, 0.3, 0.7;
+
+        gsMatrix<> val, der, der2;
+        gsMatrix<index_t> act;
+        basis.eval_into(u, val);
+        basis.deriv_into(u, der);
+        basis.deriv2_into(u, der2);
+        basis.active_into(u, act);
+
+        std::vector<gsMatrix<> > ev;
+        basis.evalAllDersBatch_into(u, 2, ev);
+        CHECK( 3 == ev.size() );
+        CHECK( (ev[0] - val ).norm() <= 1e-12 );
+        CHECK( (ev[1] - der ).norm() <= 1e-12 * der.norm() );
+        CHECK( (ev[2] - der2).norm() <= 1e-12 * der2.norm() );
+
+        // Also the same as the point-wise evaluation
+        std::vector<gsMatrix<> > ref;
+        basis.evalAllDers_into(u, 2, ref);
+        for (size_t k = 0; k != ref.size(); ++k)
+            CHECK( (ev[k] - ref[k]).norm() <= 1e-12 * (1 + ref[k].norm()) );
+        CHECK( act.rows() == ev[0].rows() );
+    }
+
+    TEST(evalAllDersGrid)
+    {
+        gsKnotVector<> kv0(0, 1, 3, 3), kv1(0, 2, 2, 4), kv2(-1, 1, 1, 2);
+
+        // Coordinates spanning several elements in every direction
+        std::vector<gsMatrix<> > grid(3);
+        grid[0] = gsVector<>::LinSpaced(5, 0, 1).transpose();
+        grid[1] = gsVector<>::LinSpaced(4, 0.1, 1.9).transpose();
+        grid[2] = gsVector<>::LinSpaced(3, -1, 1).transpose();
+
+        gsTensorBSplineBasis<2> b2(kv0, kv1);
+        gsTensorBSplineBasis<3> b3(kv0, kv1, kv2);
+
+        gsMatrix<> pts, val, der;
+        std::vector<gsMatrix<> > ev;
+
+        std::vector<gsMatrix<> > grid2(grid.begin(), grid.begin() + 2);
+        gsPointGrid(grid2, pts);
+        b2.eval_into(pts, val);
+        b2.deriv_into(pts, der);
+        b2.evalAllDersGrid_into(grid2, 1, ev);
+        CHECK( 2 == ev.size() );
+        CHECK( (ev[0] - val).norm() <= 1e-12 );
+        CHECK( (ev[1] - der).norm() <= 1e-12 * der.norm() );
+
+        gsPointGrid(grid, pts);
+        b3.eval_into(pts, val);
+        b3.deriv_into(pts, der);
+        b3.evalAllDersGrid_into(grid, 1, ev);
+        CHECK( 2 == ev.size() );
+        CHECK( (ev[0] - val).norm() <= 1e-12 );
+        CHECK( (ev[1] - der).norm() <= 1e-12 * der.norm() );
+
+        // Values only
+        b3.evalAllDersGrid_into(grid, 0, ev);
+        CHECK( 1 == ev.size() );
+        CHECK( (ev[0] - val).norm() <= 1e-12 );
+    }
+
+    TEST(tensorElementIndex)
+    {
+        // The element index of a tensor basis combines the intervals
+        // of the coordinates of the point, first direction fastest
+        gsKnotVector<> kv0(0, 1, 3, 3), kv1(0, 2, 1, 3);
+        gsTensorBSplineBasis<2> tb(kv0, kv1);
+        CHECK( 8 == tb.numElements() );
+
+        gsVector<> pt(2);
+        pt << 0.1, 1.9; // interval 0 in x, 1 in y
+        CHECK( 4 == tb.elementIndex(pt) );
+        pt << 0.9, 0.1; // interval 3 in x, 0 in y
+        CHECK( 3 == tb.elementIndex(pt) );
+        pt << 0.6, 1.2;
+        CHECK( 6 == tb.elementIndex(pt) );
+    }
+}
@@ -97,4 +97,241 @@ SUITE(gsExprAssembler_test)
         //
         CHECK(math::abs(ev.integral(el.area(G))-2*EIGEN_PI/32) < 1e-10);
     }
+
+    TEST(ElementRange)
+    {
+        // Assembling on consecutive element ranges and summing up
+        // gives the assembly on all elements
+        gsMultiPatch<> mp = gsNurbsCreator<>::BSplineSquareGrid(2,2,1);
+        gsMultiBasis<> mb(mp);
+        mb.uniformRefine();
+        gsFunctionExpr<> ff("x*y", 2), gg("1", 2);
+        gsBoundaryConditions<> bc;
+        bc.addCondition(0, boundary::west, condition_type::dirichlet, &gg);
+        bc.addCondition(1, boundary::east, condition_type::neumann, &gg);
+        bc.setGeoMap(mp);
+
+        gsExprAssembler<> A(1,1);
+        A.setIntegrationElements(mb);
+        gsExprAssembler<>::geometryMap G = A.getMap(mp);
+        gsExprAssembler<>::space u = A.getSpace(mb);
+        auto f = A.getCoeff(ff, G);
+        auto g = A.getBdrFunction(G);
+        u.setup(bc, dirichlet::interpolation, 0);
+
+        A.initSystem();
+        A.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G), u * f * meas(G) );
+        A.assembleBdr(bc.get("Neumann"), u * g * nv(G).norm() );
+        const gsSparseMatrix<> mat = A.matrix();
+        const gsMatrix<> rhs = A.rhs();
+
+        index_t numElements = 0;
+        for (size_t i = 0; i < mb.nBases(); ++i)
+            numElements += mb.basis(i).numElements();
+        gsSparseMatrix<> matSum(mat.rows(), mat.cols());
+        gsMatrix<> rhsSum = gsMatrix<>::Zero(rhs.rows(), 1);
+        // The boundary terms of a patch are assembled by the range
+        // holding its first element, also into a precomputed pattern
+        A.options().setSwitch("fixedPattern", true);
+        for (index_t k = 0; k < 3; ++k)
+        {
+            A.setElementRange(numElements*k/3, numElements*(k+1)/3);
+            A.initSystem();
+            A.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G), u * f * meas(G) );
+            A.assembleBdr(bc.get("Neumann"), u * g * nv(G).norm() );
+            matSum += A.matrix();
+            rhsSum += A.rhs();
+        }
+        CHECK( (gsMatrix<>(matSum - mat)).norm() < 1e-12 );
+        CHECK( (rhsSum - rhs).norm() < 1e-12 );
+
+        // On one process, the distributed matrix is the matrix itself
+        gsDistributedMatrixOp<> D(mat, gsSerialComm());
+        CHECK( D.rows() == mat.rows() && 0 == D.numGhosts() );
+        gsMatrix<> x = gsMatrix<>::Random(mat.rows(), 2), y, z;
+        D.apply(x, y);
+        CHECK( (y - mat * x).norm() < 1e-12 );
+        D.accumulate(rhs, z);
+        CHECK( (z - rhs).norm() == 0 );
+    }
+
+    TEST(ElementCache)
+    {
+        // The cached basis evaluations are reused, while a geometry
+        // modified in place is evaluated anew
+        gsMultiPatch<> mp = gsNurbsCreator<>::BSplineSquareGrid(2,2,1);
+        gsMultiBasis<> mb(mp);
+        mb.uniformRefine();
+        gsFunctionExpr<> ff("x*y", 2);
+
+        gsExprAssembler<> A(1,1);
+        A.setIntegrationElements(mb);
+        gsExprAssembler<>::geometryMap G = A.getMap(mp);
+        gsExprAssembler<>::space u = A.getSpace(mb);
+        auto f = A.getCoeff(ff, G);
+        u.setup(0);
+
+        A.options().setInt("cacheBudget", 16);
+        A.initSystem();
+        A.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G), u * f * meas(G) );
+        const gsSparseMatrix<> mat = A.matrix();
+
+        A.initSystem();
+        A.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G), u * f * meas(G) );
+        CHECK( (gsMatrix<>(A.matrix() - mat)).norm() < 1e-12 );
+
+        for (size_t k = 0; k < mp.nPatches(); ++k)
+            mp.patch(k).coefs().col(0) *= 2;
+        A.initSystem();
+        A.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G), u * f * meas(G) );
+        const gsSparseMatrix<> matCached = A.matrix();
+        const gsMatrix<> rhsCached = A.rhs();
+
+        A.options().setInt("cacheBudget", 0);
+        A.initSystem();
+        A.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G), u * f * meas(G) );
+        CHECK( (gsMatrix<>(matCached - mat)).norm() > 1e-2 );
+        CHECK( (gsMatrix<>(matCached - A.matrix())).norm() < 1e-12 );
+        CHECK( (rhsCached - A.rhs()).norm() < 1e-12 );
+    }
+
+    TEST(JacobianFiniteDifferences)
+    {
+        // The Jacobian by finite differences (computed by all threads
+        // at once) agrees with the exact one
+        gsMultiPatch<> mp = gsNurbsCreator<>::BSplineSquareGrid(1,2,1);
+        gsMultiBasis<> mb(mp);
+        mb.uniformRefine(2);
+        gsFunctionExpr<> ff("x*y", 2);
+
+        gsExprAssembler<> A(1,1);
+        A.setIntegrationElements(mb);
+        A.options().setInt("DirichletStrategy", 0);
+        gsExprAssembler<>::geometryMap G = A.getMap(mp);
+        gsExprAssembler<>::space u = A.getSpace(mb);
+        auto f = A.getCoeff(ff, G);
+        gsBoundaryConditions<> bc;
+        u.setup(bc, dirichlet::interpolation, 0);
+        A.initSystem();
+
+        gsMatrix<> solVector = gsMatrix<>::Random(A.numDofs(), 1);
+        gsExprAssembler<>::solution u_sol = A.getSolution(u, solVector);
+        const gsMatrix<> sv0 = solVector;
+
+        auto residual = (1+(u_sol*u_sol).val()) * igrad(u,G) *
+            igrad(u_sol, G).tr() * meas(G) - u * f * meas(G);
+        A.assemble( (1+(u_sol*u_sol).val())*igrad(u,G)*igrad(u,G).tr() * meas(G)
+                    + (2*u_sol.val())*igrad(u, G) * igrad(u_sol, G).tr() * u.tr() * meas(G),
+                    residual );
+        const gsMatrix<> exact = A.matrix().toDense();
+
+        A.assembleJacobian(residual, u_sol);
+        CHECK( (A.matrix().toDense() - exact).norm() <= 1e-6 * exact.norm() );
+        CHECK( solVector == sv0 );
+
+        // Frozen pattern, with and without the per-element maps
+        for (index_t budget = 0; budget < 2; ++budget)
+        {
+            A.options().setSwitch("freezePattern", true);
+            A.options().setInt("slotsBudget", budget);
+            A.initSystem();
+            A.assembleJacobian(residual, u_sol);
+            A.assembleJacobian(residual, u_sol);
+            CHECK( (A.matrix().toDense() - exact).norm() <= 1e-6 * exact.norm() );
+        }
+    }
+
+    TEST(MatrixFreeApply)
+    {
+        // Applying a bilinear form element by element gives the
+        // product with its assembled matrix
+        gsMultiPatch<> mp = gsNurbsCreator<>::BSplineSquareGrid(2,2,1);
+        gsMultiBasis<> mb(mp);
+        mb.setDegree(3);
+        mb.uniformRefine();
+        gsFunctionExpr<> gg("1", 2);
+        gsBoundaryConditions<> bc;
+        bc.addCondition(0, boundary::west, condition_type::dirichlet, &gg);
+        bc.addCondition(2, boundary::south, condition_type::dirichlet, &gg);
+        bc.setGeoMap(mp);
+
+        gsExprAssembler<> A(1,1);
+        A.setIntegrationElements(mb);
+        gsExprAssembler<>::geometryMap G = A.getMap(mp);
+        gsExprAssembler<>::space u = A.getSpace(mb);
+        u.setup(bc, dirichlet::interpolation, 0);
+
+        auto mass  = u * u.tr() * meas(G);
+        auto stiff = igrad(u, G) * igrad(u, G).tr() * meas(G);
+        gsMatrix<> x, y;
+
+        A.initSystem();
+        A.assemble(mass);
+        const gsSparseMatrix<> M = A.matrix();
+        x.setRandom(A.numDofs(), 3);
+        A.apply(mass, x, y);
+        CHECK( (y - M * x).norm() <= 1e-12 * (M * x).norm() );
+
+        A.initSystem();
+        A.assemble(stiff);
+        const gsSparseMatrix<> K = A.matrix();
+        A.apply(stiff, x, y);
+        CHECK( (y - K * x).norm() <= 1e-12 * (K * x).norm() );
+
+        gsLinearOperator<>::uPtr op = A.matrixFreeOp(stiff);
+        CHECK( op->rows() == K.rows() && op->cols() == K.cols() );
+        op->apply(x.col(0), y);
+        CHECK( (y - K * x.col(0)).norm() <= 1e-12 * (K * x.col(0)).norm() );
+    }
+
+    TEST(FixedPatternInterface)
+    {
+        // Assembling into the precomputed pattern gives the default
+        // assembly, also for terms coupling the sides of interfaces
+        gsMultiPatch<> mp = gsNurbsCreator<>::BSplineSquareGrid(2,2,1);
+        gsMultiBasis<> mb(mp);
+        mb.uniformRefine();
+        gsFunctionExpr<> ff("x*y", 2), gg("1", 2);
+        gsBoundaryConditions<> bc;
+        bc.addCondition(0, boundary::west, condition_type::dirichlet, &gg);
+        bc.setGeoMap(mp);
+
+        gsExprAssembler<> A(1,1);
+        A.setIntegrationElements(mb);
+        gsExprAssembler<>::geometryMap G = A.getMap(mp);
+        gsExprAssembler<>::space u = A.getSpace(mb);
+        auto f = A.getCoeff(ff, G);
+        u.setup(bc, dirichlet::interpolation, -1); // discontinuous on the interfaces
+        CHECK( 4 == mp.interfaces().size() );
+
+        for (index_t withIfc = 0; withIfc < 2; ++withIfc)
+        {
+            A.options().setSwitch("fixedPattern", false);
+            A.initSystem();
+            A.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G), u * f * meas(G) );
+            if (withIfc)
+                A.assembleIfc(mp.interfaces(),
+                              u.left() * u.left().tr() * nv(G).norm(),
+                              u.right() * u.right().tr() * nv(G).norm(),
+                              -1.0 * u.left() * u.right().tr() * nv(G).norm(),
+                              -1.0 * u.right() * u.left().tr() * nv(G).norm() );
+            const gsSparseMatrix<> mat = A.matrix();
+            const gsMatrix<> rhs = A.rhs();
+
+            A.options().setSwitch("fixedPattern", true);
+            A.initSystem();
+            CHECK( A.hasFixedPattern() );
+            const index_t nnz = A.matrix().nonZeros();
+            A.assemble( igrad(u, G) * igrad(u, G).tr() * meas(G), u * f * meas(G) );
+            if (withIfc)
+                A.assembleIfc(mp.interfaces(),
+                              u.left() * u.left().tr() * nv(G).norm(),
+                              u.right() * u.right().tr() * nv(G).norm(),
+                              -1.0 * u.left() * u.right().tr() * nv(G).norm(),
+                              -1.0 * u.right() * u.left().tr() * nv(G).norm() );
+            CHECK( nnz == A.matrix().nonZeros() ); // no entries inserted
+            CHECK( (gsMatrix<>(A.matrix() - mat)).norm() < 1e-12 );
+            CHECK( (A.rhs() - rhs).norm() < 1e-12 );
+        }
+    }
 }
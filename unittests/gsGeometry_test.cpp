@@ -42,4 +42,51 @@ SUITE(gsGeometry_test)                 // The suite should have the same name as
         CHECK(  (pxy-xyz).norm() < 1e-6 );
     }
 
+
+    TEST(evalParallel)
+    {
+        // Several chunks of unsorted points on a spline patch, a THB
+        // patch without element indices and a function expression
+        gsMultiPatch<> mp = gsNurbsCreator<>::BSplineSquareGrid(2,2,0.5);
+        mp.degreeElevate();
+        mp.uniformRefine(3);
+        gsTHBSplineBasis<2> thb(mp.basis(1));
+        gsMatrix<> box(2, 2);
+        box << 0, 0.5, 0, 0.5;
+        thb.refine(box);
+        mp.addPatch( thb.interpolateAtAnchors(mp.patch(1).eval(thb.anchors())) );
+        gsFunctionExpr<> ff("sin(x)*y", "x+y^2", 2);
+
+        gsMatrix<> pts = gsMatrix<>::Random(2, 20000);
+        pts = (pts.array() + 1) / 2;
+        gsMatrix<> val, ref;
+        for (int n = 0; n < 2; ++n)
+        {
+            for (size_t k = 0; k < mp.nPatches(); ++k)
+            {
+                mp.patch(k).evalParallel_into(pts, val, n);
+                if (0==n) mp.patch(k).eval_into(pts, ref);
+                else      mp.patch(k).deriv_into(pts, ref);
+                CHECK( (val - ref).norm() <= 1e-12 * ref.norm() );
+            }
+            ff.evalParallel_into(pts, val, n);
+            if (0==n) ff.eval_into(pts, ref);
+            else      ff.deriv_into(pts, ref);
+            CHECK( (val - ref).norm() <= 1e-12 * ref.norm() );
+        }
+        mp.patch(0).jacobianParallel_into(pts, val);
+        mp.patch(0).jacobian_into(pts, ref);
+        CHECK( (val - ref).norm() <= 1e-12 * ref.norm() );
+
+        // Points scattered over the patches
+        gsVector<index_t> pids(pts.cols());
+        for (index_t j = 0; j != pids.size(); ++j)
+            pids[j] = (7 * j) % mp.nPatches();
+        mp.evalParallel_into(pids, pts, val);
+        for (index_t j = 0; j != pids.size(); ++j)
+        {
+            mp.patch(pids[j]).eval_into(pts.col(j), ref);
+            CHECK( (val.col(j) - ref).norm() <= 1e-12 );
+        }
+    }
 }
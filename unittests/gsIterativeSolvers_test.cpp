@@ -352,4 +352,131 @@ SUITE(gsIterativeSolvers_test)
         CHECK( (mat*x-rhs).norm()/rhs.norm() <= tol );
     }
 
+
+    TEST(PipelinedCG_test)
+    {
+        index_t          N = 100;
+        real_t           tol = std::pow(10.0, - REAL_DIG * 0.75);
+
+        gsSparseMatrix<> mat;
+        gsMatrix<>       rhs;
+        gsMatrix<>       x;
+
+        poissonDiscretization(mat, rhs, N);
+
+        // Residual replacement in every step and never
+        for (index_t period = 0; period < 2; ++period)
+        {
+            gsOptionList opt = gsPipelinedCG<>::defaultOptions();
+            opt.setInt ("MaxIterations", N  );
+            opt.setReal("Tolerance"    , tol);
+            opt.setInt ("ReplacementPeriod", period);
+
+            gsPipelinedCG<> solver(mat);
+            solver.setOptions(opt);
+
+            x.setZero(N,1);
+            solver.solve(rhs, x);
+
+            CHECK( (mat*x-rhs).norm()/rhs.norm() <= 10 * tol );
+        }
+    }
+
+    TEST(SStepGMRes_test)
+    {
+        index_t          N = 100;
+        real_t           tol = std::pow(10.0, - REAL_DIG * 0.75);
+
+        gsSparseMatrix<> mat;
+        gsMatrix<>       rhs;
+        gsMatrix<>       x;
+
+        poissonDiscretization(mat, rhs, N);
+
+        gsOptionList opt = gsSStepGMRes<>::defaultOptions();
+        opt.setInt ("MaxIterations", N  );
+        opt.setReal("Tolerance"    , tol);
+        opt.setInt ("Restart"      , N  );
+
+        gsSStepGMRes<> solver(mat);
+        solver.setOptions(opt);
+
+        x.setZero(N,1);
+        solver.solve(rhs, x);
+
+        CHECK( (mat*x-rhs).norm()/rhs.norm() <= 10 * tol );
+    }
+
+    TEST(BlockCG_test)
+    {
+        index_t          N = 100;
+        real_t           tol = std::pow(10.0, - REAL_DIG * 0.75);
+
+        gsSparseMatrix<> mat;
+        gsMatrix<>       rhs1, rhs, x;
+
+        poissonDiscretization(mat, rhs1, N);
+
+        // Several right-hand sides, where the last column depends on
+        // the others, so the block has rank-deficient columns
+        rhs.setRandom(N, 4);
+        rhs.col(0) = rhs1;
+        rhs.col(3) = rhs.col(1) - 2 * rhs.col(2);
+
+        gsBlockCG<> solver(mat, makeJacobiOp(mat));
+        solver.setMaxIterations(N);
+        solver.setTolerance(tol);
+        solver.solve(rhs, x);
+
+        CHECK( solver.error() <= tol );
+        for (index_t j = 0; j < rhs.cols(); ++j)
+            CHECK( (mat*x.col(j)-rhs.col(j)).norm()/rhs.col(j).norm() <= 10 * tol );
+
+        // The method breaks down for a negative definite matrix, which
+        // is reported by an error above the tolerance
+        gsSparseMatrix<> neg = -mat;
+        gsBlockCG<> negSolver(neg);
+        negSolver.setMaxIterations(N);
+        negSolver.setTolerance(tol);
+        x.setZero(N, 4);
+        negSolver.solve(rhs, x);
+        CHECK( negSolver.error() > tol );
+        CHECK( negSolver.iterations() < N );
+    }
+
+    TEST(BlockGMRes_test)
+    {
+        index_t          N = 100;
+        real_t           tol = std::pow(10.0, - REAL_DIG * 0.75);
+
+        gsSparseMatrix<> mat;
+        gsMatrix<>       rhs1, rhs, x;
+
+        poissonDiscretization(mat, rhs1, N);
+
+        // Add a convection term, so the matrix is non-symmetric
+        for (index_t k = 0; k < N-1; ++k)
+        {
+            mat.coeffRef(k,k+1) += 0.5;
+            mat.coeffRef(k+1,k) -= 0.5;
+        }
+
+        // Several right-hand sides with rank-deficient columns
+        rhs.setRandom(N, 3);
+        rhs.col(0) = rhs1;
+        rhs.col(2) = 3 * rhs.col(1);
+
+        gsOptionList opt = gsBlockGMRes<>::defaultOptions();
+        opt.setInt ("MaxIterations", N  );
+        opt.setReal("Tolerance"    , tol);
+        opt.setInt ("Restart"      , 30 );
+
+        gsBlockGMRes<> solver(mat, makeGaussSeidelOp(mat));
+        solver.setOptions(opt);
+        solver.solve(rhs, x);
+
+        CHECK( solver.error() <= tol );
+        for (index_t j = 0; j < rhs.cols(); ++j)
+            CHECK( (mat*x.col(j)-rhs.col(j)).norm()/rhs.col(j).norm() <= 10 * tol );
+    }
 }
@@ -61,6 +61,46 @@ SUITE(gsKronecker_test)
         CHECK_EQUAL ( y, KP * x );
     }
 
+    TEST(gsKroneckerOpMixedFactors)
+    {
+        // Non-square factors of all kinds: dense, transposed dense,
+        // sparse (row- and column-major) and a general operator
+        gsMatrix<> D  = gsMatrix<>::Random(3,4);
+        gsMatrix<> Dt = gsMatrix<>::Random(2,5);
+        gsSparseMatrix<>          S  = gsMatrix<>::Random(4,3).sparseView();
+        gsSparseMatrix<real_t,RowMajor> SR = gsMatrix<>::Random(2,2).sparseView();
+        gsMatrix<> G  = gsMatrix<>::Random(3,2);
+
+        std::vector<gsLinearOperator<>::Ptr> ops;
+        ops.push_back( makeMatrixOp(D) );
+        ops.push_back( makeMatrixOp(Dt.transpose()) );
+        ops.push_back( makeMatrixOp(S) );
+        ops.push_back( makeMatrixOp(SR) );
+        ops.push_back( gsScaledOp<>::make(makeMatrixOp(G), 2) );
+        gsKroneckerOp<> kron(ops);
+
+        const gsMatrix<> K = D.kron( gsMatrix<>(Dt.transpose()) ).kron( S.toDense() )
+                              .kron( SR.toDense() ).kron( 2 * G );
+        CHECK_EQUAL( K.rows(), kron.rows() );
+        CHECK_EQUAL( K.cols(), kron.cols() );
+
+        // Several right-hand sides
+        gsMatrix<> y, x = gsMatrix<>::Random(K.cols(), 3);
+        kron.apply(x, y);
+        CHECK( ( y - K * x ).norm() <= 1.e-10 * K.norm() );
+
+        // Concurrent applications of the same operator
+        const index_t n = 8;
+        std::vector<gsMatrix<> > xs(n), ys(n);
+        for (index_t i = 0; i < n; ++i)
+            xs[i] = gsMatrix<>::Random(K.cols(), 2);
+#       pragma omp parallel for
+        for (index_t i = 0; i < n; ++i)
+            kron.apply(xs[i], ys[i]);
+        for (index_t i = 0; i < n; ++i)
+            CHECK( ( ys[i] - K * xs[i] ).norm() <= 1.e-10 * K.norm() );
+    }
+
     TEST(DenseKronecker)
     {        
         gsMatrix<> C = A.kron(B);
@@ -168,5 +168,45 @@ SUITE(gsPoissonSolver_test)
         runPoissonSolverTest(dirichlet::nitsche, iFace::dg, 1);
     }
     
+
+    TEST(SumFactorization_test)
+    {
+        // The sum-factorized kernels give the same system as the
+        // point-wise quadrature on a curved 3D patch
+        gsMultiPatch<> mp;
+        mp.addPatch( gsNurbsCreator<>::lift3D(*gsNurbsCreator<>::BSplineFatQuarterAnnulus()) );
+        mp.computeTopology();
+        gsFunctionExpr<> f("sin(x)*cos(y)+z", 3), g("x*y", 3);
+        gsBoundaryConditions<> bc;
+        bc.addCondition(0, boundary::west,  condition_type::dirichlet, &g);
+        bc.addCondition(0, boundary::front, condition_type::neumann,   &g);
+
+        for (index_t p = 2; p <= 3; ++p)
+        {
+            gsMultiBasis<> mb(mp);
+            mb.setDegree(p);
+            mb.uniformRefine();
+
+            gsPoissonAssembler<real_t> poisson(mp, mb, bc, f,
+                                               dirichlet::elimination, iFace::glue);
+            poisson.assemble();
+            gsPoissonAssembler<real_t> poissonSF(mp, mb, bc, f,
+                                                 dirichlet::elimination, iFace::glue);
+            poissonSF.options().setSwitch("SumFactorization", true);
+            poissonSF.assemble();
+            const gsSparseMatrix<> & K = poisson.matrix();
+            const gsMatrix<> & rhs = poisson.rhs();
+            CHECK( (K - poissonSF.matrix()).norm() <= 1e-10 * K.norm() );
+            CHECK( (rhs - poissonSF.rhs()).norm() <= 1e-10 * rhs.norm() );
+
+            gsGenericAssembler<> A(mp, mb);
+            A.options().setSwitch("SumFactorization", false);
+            const gsSparseMatrix<> M  = A.assembleMass();
+            const gsSparseMatrix<> K0 = A.assembleStiffness();
+            A.options().setSwitch("SumFactorization", true);
+            CHECK( (M  - A.assembleMass()).norm()      <= 1e-10 * M.norm()  );
+            CHECK( (K0 - A.assembleStiffness()).norm() <= 1e-10 * K0.norm() );
+        }
+    }
 }
 
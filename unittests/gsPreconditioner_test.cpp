@@ -87,6 +87,51 @@ void runPreconditionerTest( index_t testcase )
         solver.solve(rhs,sol);
         CHECK ( solver.error() <= solver.tolerance() );
     }
+    else if (testcase==4)
+    {
+        gsOptionList amgOpt = gsSmoothedAggregation<>::defaultOptions();
+        amgOpt.setInt("CoarseSize", 20);
+        gsSmoothedAggregation<> amg(mat, amgOpt);
+        CHECK ( amg.numLevels() > 2 );
+        gsConjugateGradient<> solver(mat, amg.makeMultiGridOp());
+        solver.setTolerance( 1.e-8 );
+        solver.setMaxIterations( 25 );
+        solver.solve(rhs,sol);
+        CHECK ( solver.error() <= solver.tolerance() );
+    }
+    else if (testcase==5)
+    {
+        gsConjugateGradient<> solver(mat, makeColoredSymmetricGaussSeidelOp(mat));
+        solver.setTolerance( 1.e-8 );
+        solver.setMaxIterations( 50 );
+        solver.solve(rhs,sol);
+        CHECK ( solver.error() <= solver.tolerance() );
+    }
+    else if (testcase==6)
+    {
+        gsConjugateGradient<> solver(mat, makeChebyshevOp(mat, 3));
+        solver.setTolerance( 1.e-8 );
+        solver.setMaxIterations( 50 );
+        solver.solve(rhs,sol);
+        CHECK ( solver.error() <= solver.tolerance() );
+    }
+}
+
+// Bilinear finite element Laplacian on an n x n grid (9-point stencil)
+gsSparseMatrix<> ninePointLaplacian( index_t n )
+{
+    gsSparseEntries<> entries;
+    for (index_t i = 0; i < n; ++i)
+        for (index_t j = 0; j < n; ++j)
+            for (index_t di = -1; di <= 1; ++di)
+                for (index_t dj = -1; dj <= 1; ++dj)
+                    if (i+di >= 0 && i+di < n && j+dj >= 0 && j+dj < n)
+                        entries.add( i*n+j, (i+di)*n+(j+dj),
+                                     (0==di && 0==dj) ? (real_t)(8)/3 : (real_t)(-1)/3 );
+    gsSparseMatrix<> A(n*n, n*n);
+    A.setFrom(entries);
+    A.makeCompressed();
+    return A;
 }
 
 
@@ -109,6 +154,112 @@ SUITE(gsPreconditioner_test)
     {
         runPreconditionerTest(3);
     }
+    TEST(gsSmoothedAggregationPreconditioner_test)
+    {
+        runPreconditionerTest(4);
+    }
+    TEST(gsColoredSymmetricGaussSeidelPreconditioner_test)
+    {
+        runPreconditionerTest(5);
+    }
+
+    TEST(gsChebyshevPreconditioner_test)
+    {
+        runPreconditionerTest(6);
+    }
+
+    TEST(gsColoredGaussSeidel_test)
+    {
+        const gsSparseMatrix<> A = ninePointLaplacian(12);
+        gsMatrix<> f, x, y;
+        f.setRandom(A.rows(), 2);
+        const gsMatrix<> sol = gsMatrix<>(A).partialPivLu().solve(f);
+
+        gsColoredGaussSeidelOp< gsSparseMatrix<> > colored(A);
+        CHECK ( colored.numColors() > 1 && colored.numColors() <= 9 );
+
+        // The sweeps reduce the residual
+        x.setRandom(A.rows(), 2);
+        const real_t res0 = (f - A*x).norm();
+        for (index_t i = 0; i < 10; ++i)
+            colored.step(f, x);
+        CHECK ( (f - A*x).norm() < res0/2 );
+
+        // Both the colored and the serial sweeps converge to the
+        // solution, their common fixed point
+        gsGaussSeidelOp< gsSparseMatrix<> > serial(A);
+        y.setRandom(A.rows(), 2);
+        for (index_t i = 0; i < 400; ++i)
+        {
+            colored.step(f, x);
+            serial.step(f, y);
+        }
+        CHECK ( (x - sol).norm() <= 1e-8 * sol.norm() );
+        CHECK ( (y - sol).norm() <= 1e-8 * sol.norm() );
+
+        // The solution stays fixed, also in the parallel sweeps of a
+        // large matrix
+        const gsSparseMatrix<> B = ninePointLaplacian(101);
+        x.setRandom(B.rows(), 2);
+        f = B * x;
+        y = x;
+        gsColoredGaussSeidelOp< gsSparseMatrix<>, gsGaussSeidel::symmetric > coloredB(B);
+        coloredB.step(f, y);
+        CHECK ( (y - x).norm() <= 1e-10 * x.norm() );
+    }
+
+    TEST(gsChebyshev_test)
+    {
+        const gsSparseMatrix<> A = ninePointLaplacian(12);
+        const index_t n = A.rows();
+
+        // The spectrum of the Jacobi preconditioned matrix D^{-1}A
+        const gsVector<> d = A.diagonal();
+        const gsMatrix<> M = d.cwiseInverse().asDiagonal() * gsMatrix<>(A);
+        const gsMatrix<> S = d.cwiseSqrt().cwiseInverse().asDiagonal() * gsMatrix<>(A)
+                             * d.cwiseSqrt().cwiseInverse().asDiagonal();
+        const real_t lmax = S.selfadjointView<Lower>().eigenvalues().maxCoeff();
+
+        // The Lanczos estimate is a lower bound, which becomes an upper
+        // bound by the safety factor
+        gsChebyshevOp<real_t>::uPtr cheb = makeChebyshevOp(A, 3);
+        const real_t safety = gsChebyshevOp<real_t>::defaultOptions().getReal("EigenvalueSafety");
+        const real_t est = cheb->maxEigenvalue();
+        CHECK ( est <= lmax * (1 + 1e-10) );
+        CHECK ( est * safety >= lmax );
+
+        // One step multiplies the error by the scaled Chebyshev polynomial
+        // T_3((theta - D^{-1}A)/delta) / T_3(theta/delta)
+        cheb->setMaxEigenvalue(lmax);
+        const gsOptionList opt = gsChebyshevOp<real_t>::defaultOptions();
+        const real_t hi = lmax * safety;
+        const real_t lo = lmax / opt.getReal("EigenvalueRatio");
+        const real_t theta = (hi + lo) / 2, delta = (hi - lo) / 2;
+        const gsMatrix<> I = gsMatrix<>::Identity(n, n);
+        const gsMatrix<> Z = (theta * I - M) / delta;
+        gsMatrix<> T0 = I, T1 = Z, T2;
+        for (index_t k = 1; k < 3; ++k)
+        {
+            T2 = 2 * Z * T1 - T0;
+            T0.swap(T1);
+            T1.swap(T2);
+        }
+        const real_t s = theta / delta;
+        const real_t scale = 4 * s * s * s - 3 * s; // T_3(theta/delta)
+
+        gsMatrix<> x, f;
+        x.setRandom(n, 2);
+        const gsMatrix<> sol = x;
+        f = A * x;
+        const gsMatrix<> e0 = gsMatrix<>::Random(n, 2);
+        x = sol + e0;
+        cheb->step(f, x);
+        CHECK ( (x - sol - T1 * e0 / scale).norm() <= 1e-10 * e0.norm() );
+
+        // The same for apply(), which starts from zero
+        cheb->apply(f, x);
+        CHECK ( (x - sol + T1 * sol / scale).norm() <= 1e-10 * sol.norm() );
+    }
 
     TEST(gsPatchPreconditioner_stiff_test)
     {
@@ -266,5 +417,67 @@ SUITE(gsPreconditioner_test)
         }
     }
 
+    TEST(gsAdditiveOpManySubspaces_test)
+    {
+        // Overlapping subspaces; the operator of the first one is used twice
+        const index_t n = 12;
+        gsMatrix<> m = 2*gsMatrix<>::Identity(3,3);
+        gsLinearOperator<>::Ptr shared = makeMatrixOp( m.moveToPtr() );
+        gsAdditiveOp<> a;
+        gsMatrix<> expected(n,2);
+        expected.setZero();
+        gsMatrix<> in(n,2);
+        in.setRandom();
+        for (index_t k=0; k+3<=n; k+=2)
+        {
+            gsSparseMatrix<real_t,RowMajor> t(n,3);
+            for (index_t i=0; i<3; ++i)
+                t(k+i,i) = 1;
+            const real_t factor = k<4 ? 2 : k+1;
+            if (k<4)
+                a.addOperator(t, shared);
+            else
+            {
+                m = factor*gsMatrix<>::Identity(3,3);
+                a.addOperator(t, makeMatrixOp( m.moveToPtr() ));
+            }
+            expected.middleRows(k,3) += factor * in.middleRows(k,3);
+        }
+        gsMatrix<> res;
+        a.apply( in, res );
+        CHECK ( (res-expected).norm() < 1/(real_t)(10000) );
+    }
+
+    TEST(gsDistributedAdditiveOp_test)
+    {
+        // On one process, all indices are owned, also the unused ones
+        std::vector<index_t> idx;
+        idx.push_back(3); idx.push_back(1); idx.push_back(3);
+        gsDistributedIndexSet<>::Ptr is = gsDistributedIndexSet<>::make(idx, 5, gsSerialComm());
+        CHECK ( 5 == is->numOwned() && 5 == is->numLocal() );
+
+        gsMatrix<> in(5,2);
+        in.setRandom();
+        gsMatrix<> local, owned;
+        is->toLocal(in, local);
+        is->addToOwned(local, owned);
+        CHECK ( (owned-in).norm() == 0 );
+
+        gsSparseMatrix<real_t,RowMajor> t1(5,2), t2(5,1);
+        t1(0,0) = 1; t1(3,1) = 1;
+        t2(2,0) = 1; t2(3,0) = 1;
+        gsMatrix<> o1(2,2), o2(1,1);
+        o1 << 2,1,   1,2;
+        o2 << 3;
+        gsMatrix<> expected = t1 * o1 * (t1.transpose() * in) + t2 * o2 * (t2.transpose() * in);
+
+        gsDistributedAdditiveOp<> a(is);
+        a.addOperator(memory::make_shared(new gsSparseMatrix<real_t,RowMajor>(t1)), makeMatrixOp(o1));
+        a.addSharedOperator(memory::make_shared(new gsSparseMatrix<real_t,RowMajor>(t2)), makeMatrixOp(o2));
+        gsMatrix<> res;
+        a.apply( in, res );
+        CHECK ( (res-expected).norm() < 1/(real_t)(10000) );
+    }
+
 
 }
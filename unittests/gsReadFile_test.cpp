@@ -86,6 +86,78 @@ TEST(Obj_ref_not_in_file)
     CHECK((basis.size() == 0));
 }
 
+// Tests for the number parsing of the XML readers
+TEST(ParseDouble)
+{
+    // The values must agree with strtod bit for bit, and the whole
+    // token must be consumed
+    const char * numbers[] = {
+        "0", "-0", "+1.5", "-2.25", "007", "-00.00125", ".5", "5.",
+        "9007199254740993", "1234567890123456789", "12345678901234567890123",
+        "0.1234567890123456789012345", "1e22", "1e23", "1e-22", "1e-23",
+        "-4.5E22", "4.5e+21", "123456e-17", "1e308", "2e-310", "1e" };
+    for (size_t i = 0; i != sizeof(numbers)/sizeof(numbers[0]); ++i)
+    {
+        const char * str = numbers[i];
+        double val = -1;
+        CHECK( gsParseDouble(str, val) );
+        CHECK_EQUAL( strtod(numbers[i], NULL), val );
+        CHECK( '\0' == *str );
+    }
+
+    const char * str = "  inf -INF nan";
+    double val;
+    CHECK( gsParseDouble(str, val) && std::isinf(val) && val > 0 );
+    CHECK( gsParseDouble(str, val) && std::isinf(val) && val < 0 );
+    CHECK( gsParseDouble(str, val) && std::isnan(val) );
+    CHECK( !gsParseDouble(str, val) );
+
+    str = "abc";
+    CHECK( !gsParseDouble(str, val) );
+
+    // Fractions and sequences of numbers
+    str = " 1/4\n-3/2\t0.5 ";
+    CHECK( gsGetReal(str, val) && 0.25 == val );
+    CHECK( gsGetReal(str, val) && -1.5 == val );
+    CHECK( gsGetReal(str, val) && 0.5 == val );
+    CHECK( !gsGetReal(str, val) );
+}
+
+TEST(GetInt)
+{
+    const char * str = " 42 +7 -13";
+    int i = 0;
+    CHECK( gsGetInt(str, i) && 42 == i );
+    CHECK( gsGetInt(str, i) && 7 == i );
+    CHECK( gsGetInt(str, i) && -13 == i );
+    CHECK( !gsGetInt(str, i) );
+
+    // A negative value is rejected by unsigned types
+    unsigned u = 5;
+    str = "-1";
+    CHECK( !gsGetInt(str, u) && 5 == u && '-' == *str );
+
+    // The limits are read, anything beyond is rejected
+    const std::string imax = util::to_string(std::numeric_limits<int>::max());
+    const std::string imin = util::to_string(std::numeric_limits<int>::min());
+    str = imax.c_str();
+    CHECK( gsGetInt(str, i) && std::numeric_limits<int>::max() == i );
+    str = imin.c_str();
+    CHECK( gsGetInt(str, i) && std::numeric_limits<int>::min() == i );
+    const std::string over  = imax + "0";
+    const std::string under = imin + "0";
+    str = over.c_str();
+    CHECK( !gsGetInt(str, i) );
+    str = under.c_str();
+    CHECK( !gsGetInt(str, i) );
+    const std::string umax = util::to_string(std::numeric_limits<unsigned>::max());
+    str = umax.c_str();
+    CHECK( gsGetInt(str, u) && std::numeric_limits<unsigned>::max() == u );
+    const std::string uover = umax + "1";
+    str = uover.c_str();
+    CHECK( !gsGetInt(str, u) );
+}
+
 // Tests for the constructors that take use of casts
 /*TEST(Obj_uPtr)
 {
@@ -30,6 +30,8 @@
 
 #include "gismo_unittest.h"
 
+#include <thread>
+
 using namespace gismo;
 
 
@@ -131,6 +133,66 @@ std::vector<index_t> random_refinement(int lvl, int max_nb,
 }
 
 
+// Returns the number of points whose active functions differ from
+// the reference, computed by active_into() of \a basis
+template<class Basis>
+index_t activeMismatches(const Basis & basis, const gsMatrix<> & pts,
+                         const std::vector<gsMatrix<index_t> > & ref)
+{
+    index_t result = 0;
+    gsMatrix<index_t> act;
+    for (index_t j = 0; j < pts.cols(); ++j)
+    {
+        basis.active_into(pts.col(j), act);
+        if (act != ref[j])
+            ++result;
+    }
+    return result;
+}
+
+// Checks the cached active functions of a hierarchical basis against
+// the ones of fresh copies, which have nothing cached, for sequential,
+// OpenMP and std::thread callers
+template<class Basis>
+void checkActiveCache(Basis & basis, const gsMatrix<> & pts)
+{
+    std::vector<gsMatrix<index_t> > ref(pts.cols());
+    for (index_t j = 0; j < pts.cols(); ++j)
+        Basis(basis).active_into(pts.col(j), ref[j]);
+
+    // All points at once, the second call reads the cache only
+    gsMatrix<index_t> act;
+    for (index_t k = 0; k < 2; ++k)
+    {
+        basis.active_into(pts, act);
+        bool same = true;
+        for (index_t j = 0; j < pts.cols(); ++j)
+            same = same && act.col(j).topRows(ref[j].rows()) == ref[j]
+                && act.col(j).bottomRows(act.rows() - ref[j].rows()).isZero();
+        CHECK( same );
+    }
+    CHECK( 0 == activeMismatches(basis, pts, ref) );
+
+    // The threads fill the tables of a copy concurrently
+    const Basis ompCopy(basis);
+    index_t errors = 0;
+#   pragma omp parallel reduction(+:errors)
+    errors += activeMismatches(ompCopy, pts, ref);
+    CHECK( 0 == errors );
+
+    // Threads outside of the OpenMP team, concurrently with it
+    const Basis thrCopy(basis);
+    index_t err[2] = {0, 0};
+    std::thread t0([&]() { err[0] = activeMismatches(thrCopy, pts, ref); });
+    std::thread t1([&]() { err[1] = activeMismatches(thrCopy, pts, ref); });
+    errors = 0;
+#   pragma omp parallel reduction(+:errors)
+    errors += activeMismatches(thrCopy, pts, ref);
+    t0.join();
+    t1.join();
+    CHECK( 0 == errors + err[0] + err[1] );
+}
+
 SUITE(gsThbs_geometry_test)
 {
 
@@ -208,4 +270,75 @@ SUITE(gsThbs_geometry_test)
 
     }
 
+
+    TEST(activeCache)
+    {
+        gsKnotVector<> kv(0, 1, 7, 3);
+        gsTensorBSplineBasis<2> tb(kv, kv);
+        gsTHBSplineBasis<2> thb(tb);
+        gsHBSplineBasis<2>  hb(tb);
+
+        gsMatrix<> pts(2, 400);
+        pts.setRandom();
+        pts = (pts.array() + 1) / 2;
+        pts.rightCols(100) = pts.leftCols(100); // repeated points
+        pts.col(0).setZero();                   // corners and knots
+        pts.col(1).setOnes();
+        pts.col(2) << 0.5, 0.25;
+
+        gsMatrix<> box(2, 2);
+        box << 0, 0.5, 0, 0.5;
+        thb.refine(box);
+        hb.refine(box);
+        checkActiveCache(thb, pts);
+        checkActiveCache(hb, pts);
+
+        // Refinement invalidates the cached elements
+        box << 0.1, 0.3, 0.2, 0.45;
+        thb.refine(box);
+        hb.refine(box);
+        checkActiveCache(thb, pts);
+        checkActiveCache(hb, pts);
+    }
+
+    TEST(thbEvalAllDers)
+    {
+        gsKnotVector<> kv(0, 1, 7, 3);
+        gsTensorBSplineBasis<2> tb(kv, kv);
+        gsTHBSplineBasis<2> thb(tb);
+
+        gsMatrix<> box(2, 2);
+        box << 0, 0.5, 0, 0.5;
+        thb.refine(box);
+        box << 0.1, 0.3, 0.2, 0.45;
+        thb.refine(box);
+        CHECK( thb.maxLevel() == 2 );
+
+        gsMatrix<> pts(2, 50);
+        pts.setRandom();
+        pts = (pts.array() + 1) / 2;
+        pts.col(0).setZero();
+        pts.col(1) << 0.5, 0.25;
+
+        // All points at once, the functions are compared point by point
+        std::vector<gsMatrix<> > all;
+        thb.evalAllDers_into(pts, 2, all);
+        gsMatrix<index_t> act;
+        thb.active_into(pts, act);
+        CHECK_EQUAL( 3u, all.size() );
+
+        gsMatrix<> val, der, der2;
+        for (index_t j = 0; j != pts.cols(); ++j)
+            for (index_t k = 0; k != act.rows(); ++k)
+            {
+                const index_t i = act(k, j);
+                if ( 0 == i && k > 0 ) continue; // padding
+                thb.evalSingle_into  (i, pts.col(j), val);
+                thb.derivSingle_into (i, pts.col(j), der);
+                thb.deriv2Single_into(i, pts.col(j), der2);
+                CHECK_CLOSE( val(0, 0), all[0](k, j), 1e-12 );
+                CHECK( (der  - all[1].block(2*k, j, 2, 1)).norm() < 1e-10 );
+                CHECK( (der2 - all[2].block(3*k, j, 3, 1)).norm() < 1e-8 );
+            }
+    }
 }